@@ -97,11 +97,11 @@ class Event{
         //remove taus from the lepton collection
         void removeTaus(){ _leptonCollectionPtr->removeTaus(); }
 
-        //consider making these functions more efficient at some point with caching of the collections that are now generated every time
-        LightLepton& lightLepton( const LightLeptonCollection::size_type leptonIndex ) const{ return lightLeptonCollection()[ leptonIndex ]; }
-        Muon& muon( const MuonCollection::size_type muonIndex ) const{ return muonCollection()[ muonIndex ]; }
-        Electron& electron( const ElectronCollection::size_type electronIndex ) const{ return electronCollection()[ electronIndex ]; }
-        Tau& tau( const TauCollection::size_type tauIndex ) const{ return tauCollection()[ tauIndex ]; }
+        //the lepton collection caches the indices of each flavor until it is modified, so no collections are built here
+        LightLepton& lightLepton( const LightLeptonCollection::size_type leptonIndex ) const{ return _leptonCollectionPtr->lightLepton( leptonIndex ); }
+        Muon& muon( const MuonCollection::size_type muonIndex ) const{ return _leptonCollectionPtr->muon( muonIndex ); }
+        Electron& electron( const ElectronCollection::size_type electronIndex ) const{ return _leptonCollectionPtr->electron( electronIndex ); }
+        Tau& tau( const TauCollection::size_type tauIndex ) const{ return _leptonCollectionPtr->tau( tauIndex ); }
 
         //lepton collections based on selection
         LeptonCollection looseLeptonCollection() const{ return _leptonCollectionPtr->looseLeptonCollection(); }
@@ -138,6 +138,8 @@ class Event{
         bool passMetFilters() const{ return _triggerInfoPtr->passMetFilters(); }
         bool passTrigger( const std::string& triggerName ) const{ return _triggerInfoPtr->passTrigger( triggerName ); }
         bool passMetFilter( const std::string& filterName ) const{ return _triggerInfoPtr->passMetFilter( filterName ); }
+        bool passTrigger( const std::size_t triggerIndex ) const{ return _triggerInfoPtr->passTrigger( triggerIndex ); }
+        bool passMetFilter( const std::size_t filterIndex ) const{ return _triggerInfoPtr->passMetFilter( filterIndex ); }
 
         //number of leptons 
         LeptonCollection::size_type numberOfLeptons() const{ return _leptonCollectionPtr->size(); }
@@ -155,7 +157,8 @@ class Event{
         LeptonCollection::size_type numberOfUniqueOSLeptonPairs() const{ return _leptonCollectionPtr->numberOfUniqueOSPairs(); }
 
 
-        //presence of a Z boson
+        //presence of a Z boson, the functions below throw a domain_error when there is no Z boson candidate
+        bool hasZBosonCandidate() const{ return _leptonCollectionPtr->hasZBosonCandidate(); }
         double bestZBosonCandidateMass();
         std::pair< LeptonCollection::size_type, LeptonCollection::size_type > bestZBosonCandidateIndices();
         std::pair< std::pair< LeptonCollection::size_type, LeptonCollection::size_type >, double > bestZBosonCandidateIndicesAndMass();
@@ -219,11 +222,7 @@ class Event{
         double _weight = 1;
         const Sample* _samplePtr = nullptr;
 
-        //presence of Z boson
-        bool ZIsInitialized = false;
-        std::pair< LeptonCollection::size_type, LeptonCollection::size_type > _bestZBosonCandidateIndices;
-        LeptonCollection::size_type _WLeptonIndex = 0;
-        double _bestZBosonCandidateMass;
+        //presence of Z boson, the pair combinatorics are cached by the lepton collection
         void initializeZBosonCandidate();
         
         //always make sure lepton collection is sorted before selecting Z candidates 
@@ -1,6 +1,9 @@
 #ifndef GeneratorInfo_H
 #define GeneratorInfo_H
 
+//include c++ library classes
+#include <vector>
+
 //include other parts of framework
 #include "../../TreeReader/interface/TreeReader.h"
 #include "../../objects/interface/GenMet.h"
@@ -24,6 +27,14 @@ class GeneratorInfo{
 
         double relativeWeightPdfVar( const unsigned pdfIndex ) const;
 
+        //contiguous relative weights of each type of variation, to fill all of them at once ( see MultiWeightHistogram )
+        unsigned numberOfScaleVariations() const;
+        unsigned numberOfPdfVariations() const;
+        unsigned numberOfPsVariations() const;
+        const double* relativeWeightsScaleVar() const{ return _generatorWeights.data(); }
+        const double* relativeWeightsPdfVar() const{ return ( numberOfPdfVariations() == 0 ? nullptr : _generatorWeights.data() + 9 ); }
+        const double* relativeWeightsPsVar() const{ return _generatorWeights.data() + _numberOfLheWeights; }
+
         unsigned numberOfPsWeights() const{ return _numberOfPsWeights; }
         double relativeWeightPsVar( const unsigned psIndex ) const;
         double relativeWeight_ISR_InverseSqrt2() const{ return relativeWeightPsVar( 2 ); }
@@ -53,10 +64,12 @@ class GeneratorInfo{
     private:
         static constexpr unsigned maxNumberOfLheWeights = 148;
         unsigned _numberOfLheWeights;
-        double _lheWeights[maxNumberOfLheWeights];
         static constexpr unsigned maxNumberOfPsWeights = 14;
         unsigned _numberOfPsWeights;
-        double _psWeights[maxNumberOfPsWeights];
+
+        //only the weights present in the event are stored, the LHE weights followed by the parton shower weights
+        //events read without generator weights ( see TreeReader::setReadGeneratorWeights ) store nothing here
+        std::vector< double > _generatorWeights;
         double _prefireWeight;
         double _prefireWeightDown;
         double _prefireWeightUp;
@@ -38,6 +38,12 @@ class JetCollection : public PhysicsObjectCollection< Jet > {
         void selectGoodAnyVariationJets();
         JetCollection goodAnyVariationJetCollection() const;
 
+        //iterate over the jets passing criteria without building a new collection
+        SelectedObjectView< Jet > goodJetView() const{ return selectedView( &Jet::isGood ); }
+        SelectedObjectView< Jet > looseBTagView() const{ return selectedView( &Jet::isBTaggedLoose ); }
+        SelectedObjectView< Jet > mediumBTagView() const{ return selectedView( &Jet::isBTaggedMedium ); }
+        SelectedObjectView< Jet > tightBTagView() const{ return selectedView( &Jet::isBTaggedTight ); }
+
         //count jets passing criteria
         size_type numberOfLooseBTaggedJets() const;
         size_type numberOfMediumBTaggedJets() const;
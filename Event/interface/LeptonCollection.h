@@ -2,6 +2,10 @@
 #define LeptonCollection_H
 
 //include c++ library classes
+#include <vector>
+#include <utility>
+#include <string>
+#include <cstddef>
 
 //include other parts of code 
 #include "../../objects/interface/Lepton.h"
@@ -24,6 +28,12 @@ class LeptonCollection : public PhysicsObjectCollection< Lepton > {
         TauCollection tauCollection() const;
         LightLeptonCollection lightLeptonCollection() const;
 
+        //access the leptons of one flavor by their index among the leptons of that flavor, without building a new collection
+        Muon& muon( const size_type muonIndex ) const;
+        Electron& electron( const size_type electronIndex ) const;
+        Tau& tau( const size_type tauIndex ) const;
+        LightLepton& lightLepton( const size_type lightLeptonIndex ) const;
+
         //select leptons
         void selectLooseLeptons();
         void selectFOLeptons();
@@ -34,6 +44,11 @@ class LeptonCollection : public PhysicsObjectCollection< Lepton > {
         LeptonCollection FOLeptonCollection() const;
         LeptonCollection tightLeptonCollection() const;
 
+        //iterate over the leptons passing certain selection without building a new collection
+        SelectedObjectView< Lepton > looseLeptonView() const{ return selectedView( &Lepton::isLoose ); }
+        SelectedObjectView< Lepton > FOLeptonView() const{ return selectedView( &Lepton::isFO ); }
+        SelectedObjectView< Lepton > tightLeptonView() const{ return selectedView( &Lepton::isTight ); }
+
         //build collection of the X leading leptons 
         LeptonCollection leadingLeptonCollection( const size_type );
 
@@ -69,6 +84,8 @@ class LeptonCollection : public PhysicsObjectCollection< Lepton > {
         size_type numberOfUniqueOSPairs() const;
 
         //reconstruct best Z boson candidate
+        //a candidate exists when there is a light OSSF pair, the functions below throw a domain_error otherwise
+        bool hasZBosonCandidate() const;
         double bestZBosonCandidateMass() const;
         std::pair< size_type, size_type > bestZBosonCandidateIndices() const;
         std::pair< std::pair< size_type, size_type >, double > bestZBosonCandidateIndicesAndMass() const;
@@ -84,16 +101,48 @@ class LeptonCollection : public PhysicsObjectCollection< Lepton > {
         void clean( bool (Lepton::*isFlavorToClean)() const, bool (Lepton::*isFlavorToCleanFrom)() const, bool (Lepton::*passSelection)() const, const double );
 
         //build collection of objects passing given selection
-        LeptonCollection selectedCollection( void (LeptonCollection::*applySelection)() ) const;
+        LeptonCollection selectedCollection( bool (Lepton::*passSelection)() const ) const;
 
         LeptonCollection( const std::vector< std::shared_ptr< Lepton > >& leptonVector ) : PhysicsObjectCollection< Lepton >( leptonVector ) {}
 
-        //determine the flavor + charge combination of the leptons
-        enum FlavorCharge : unsigned int;
-        FlavorCharge  flavorChargeCombination() const;
-
-        //number of unique lepton pairs satisfying given condition
-        template< typename function_type > size_type numberOfUniquePairs( const function_type&  ) const;
+        //indices of the leptons of each flavor, computed once and reused until leptons are added, removed or reordered
+        struct FlavorIndices {
+            std::vector< size_type > muonIndices;
+            std::vector< size_type > electronIndices;
+            std::vector< size_type > tauIndices;
+            std::vector< size_type > lightLeptonIndices;
+        };
+        const FlavorIndices& flavorIndices() const;
+        Lepton& leptonOfFlavor( const std::vector< size_type >& flavorIndices, const size_type index, const std::string& flavorName ) const;
+
+        mutable FlavorIndices _flavorIndices;
+        mutable std::size_t _flavorIndicesModificationCount = 0;
+        mutable bool _flavorIndicesComputed = false;
+
+        //charge and flavor combinations of all lepton pairs, computed once and reused until the leptons, their order or their momenta change
+        struct PairCombinatorics {
+            bool hasOSPair = false;
+            bool hasOSSFPair = false;
+            bool hasLightOSSFPair = false;
+            size_type numberOfUniqueOSPairs = 0;
+            size_type numberOfUniqueOSSFPairs = 0;
+            std::pair< size_type, size_type > bestZBosonCandidateIndices = { 99, 99 };
+            double bestZBosonCandidateMass = 0;
+        };
+        const PairCombinatorics& pairCombinatorics() const;
+        void computePairCombinatorics() const;
+
+        //number of unique lepton pairs having all given pair flags, using the pair flags of the current combinatorics
+        size_type numberOfUniquePairs( const unsigned char requiredFlags ) const;
+
+        mutable PairCombinatorics _pairCombinatorics;
+
+        //flags of every lepton pair, ordered as ( 0, 1 ), ( 0, 2 ), ..., ( 1, 2 ), ...
+        mutable std::vector< unsigned char > _pairFlags;
+
+        //leptons and their transverse momenta for which the combinatorics were computed
+        mutable std::vector< std::pair< const Lepton*, double > > _pairCombinatoricsState;
+        mutable bool _pairCombinatoricsComputed = false;
 };
 
 
@@ -5,6 +5,65 @@
 #include <vector>
 #include <memory>
 #include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <iterator>
+#include <cstddef>
+
+
+//non-owning view of the objects in a collection that pass a selection
+//iterating or counting the selected objects does not copy them, but the collection must outlive the view and not be modified while the view is used
+template< typename ObjectType > class SelectedObjectView {
+
+    public:
+        using collection_type = std::vector< std::shared_ptr< ObjectType > >;
+        using size_type = typename collection_type::size_type;
+        using selection_type = bool (ObjectType::*)() const;
+
+        class const_iterator {
+
+            public:
+                using iterator_category = std::forward_iterator_tag;
+                using value_type = std::shared_ptr< ObjectType >;
+                using difference_type = std::ptrdiff_t;
+                using pointer = const value_type*;
+                using reference = const value_type&;
+
+                const_iterator( typename collection_type::const_iterator it, typename collection_type::const_iterator end, selection_type passSelection ) :
+                    _it( it ), _end( end ), _passSelection( passSelection )
+                { skipRejected(); }
+
+                reference operator*() const{ return *_it; }
+                pointer operator->() const{ return &( *_it ); }
+                const_iterator& operator++(){ ++_it; skipRejected(); return *this; }
+                const_iterator operator++( int ){ const_iterator copy( *this ); ++( *this ); return copy; }
+                bool operator==( const const_iterator& rhs ) const{ return _it == rhs._it; }
+                bool operator!=( const const_iterator& rhs ) const{ return _it != rhs._it; }
+
+            private:
+                typename collection_type::const_iterator _it;
+                typename collection_type::const_iterator _end;
+                selection_type _passSelection;
+
+                void skipRejected(){
+                    while( _it != _end && !( (**_it).*_passSelection )() ) ++_it;
+                }
+        };
+
+        SelectedObjectView( const collection_type& collection, selection_type passSelection ) :
+            _collectionPtr( &collection ), _passSelection( passSelection ) {}
+
+        const_iterator begin() const{ return const_iterator( _collectionPtr->cbegin(), _collectionPtr->cend(), _passSelection ); }
+        const_iterator end() const{ return const_iterator( _collectionPtr->cend(), _collectionPtr->cend(), _passSelection ); }
+
+        //the number of selected objects is counted on every call
+        size_type size() const{ return static_cast< size_type >( std::distance( begin(), end() ) ); }
+        bool empty() const{ return begin() == end(); }
+
+    private:
+        const collection_type* _collectionPtr;
+        selection_type _passSelection;
+};
 
 
 
@@ -23,15 +82,19 @@ template< typename ObjectType > class PhysicsObjectCollection {
         void push_back( const ObjectType& );
         void push_back( ObjectType&& );
 
-        iterator begin(){ return collection.begin(); }
+        //non-const iterators can reorder or replace the objects, so they count as a modification of the collection
+        iterator begin(){ markModified(); return collection.begin(); }
         const_iterator begin() const{ return collection.cbegin(); }
         const_iterator cbegin() const{ return collection.cbegin(); }
-        iterator end(){ return collection.end(); }
+        iterator end(){ markModified(); return collection.end(); }
         const_iterator end() const{ return collection.cend(); }
         const_iterator cend() const{ return collection.cend(); }
 
         size_type size() const{ return collection.size(); }
 
+        //incremented whenever objects are added, removed or reordered, so information derived from the collection can be cached until it changes
+        std::size_t modificationCount() const{ return _modificationCount; }
+
         ObjectType& operator[]( const size_type index ){ return *collection[index]; }
         const ObjectType& operator[]( const size_type index ) const{ return *collection[index]; }
         
@@ -48,12 +111,21 @@ template< typename ObjectType > class PhysicsObjectCollection {
         //return a vector of all possible object pairs
         std::vector< std::pair< std::shared_ptr< ObjectType >, std::shared_ptr< ObjectType > > > pairCollection() const;
 
+        //iterate over the objects passing a selection without building a new collection
+        SelectedObjectView< ObjectType > selectedView( bool (ObjectType::*passSelection)() const ) const{ return SelectedObjectView< ObjectType >( collection, passSelection ); }
+
     protected:
         PhysicsObjectCollection( const collection_type& col ) : collection( col ) {}
 
         //select objects passing a threshold and remove the others 
         void selectObjects( bool (ObjectType::*passSelection)() const );
 
+        //keep the objects for which the mask is non-zero, removing the others in one pass
+        void selectObjects( const std::vector< unsigned char >& keepMask );
+
+        //pointers to the objects passing a selection, to build a sub-collection sharing its objects with this collection
+        collection_type selectedObjects( bool (ObjectType::*passSelection)() const ) const;
+
         template< typename IteratorType > IteratorType erase( IteratorType );
 
         //count the number of objects satisfying given criterion
@@ -61,16 +133,21 @@ template< typename ObjectType > class PhysicsObjectCollection {
 
     private:
         collection_type collection;
+        std::size_t _modificationCount = 0;
+
+        void markModified(){ ++_modificationCount; }
 };
 
 
 
 template< typename ObjectType > void PhysicsObjectCollection< ObjectType >::push_back( const ObjectType& physicsObject ){
+    markModified();
     collection.push_back( std::shared_ptr< ObjectType >( physicsObject.clone() ) );
 }
 
 
 template< typename ObjectType > void PhysicsObjectCollection< ObjectType >::push_back( ObjectType&& physicsObject ){
+    markModified();
     collection.push_back( std::shared_ptr< ObjectType >( std::move( physicsObject ).clone() ) );
 }
 
@@ -81,29 +158,51 @@ template< typename ObjectType > template< typename func > void PhysicsObjectColl
 
 
 template< typename ObjectType > template< typename IteratorType > IteratorType PhysicsObjectCollection< ObjectType >::erase( IteratorType it ){
+    markModified();
     return collection.erase( it );
 } 
 
 
+//the selections keep the order of the objects and move every object at most once
 template< typename ObjectType > void PhysicsObjectCollection< ObjectType >::selectObjects( bool (ObjectType::*passSelection)() const ){
-    for( const_iterator it = cbegin(); it != cend(); ){
-        if( !( (**it).*passSelection)() ){
-            it = erase( it );
-        } else {
-            ++it;
+    markModified();
+    collection.erase( std::remove_if( collection.begin(), collection.end(), [passSelection]( const std::shared_ptr< ObjectType >& objectPtr ){ return !( (*objectPtr).*passSelection )(); } ), collection.end() );
+}
+
+
+template< typename ObjectType > void PhysicsObjectCollection< ObjectType >::selectObjects( bool (&passSelection)( const ObjectType& ) ){
+    markModified();
+    collection.erase( std::remove_if( collection.begin(), collection.end(), [&passSelection]( const std::shared_ptr< ObjectType >& objectPtr ){ return !passSelection( *objectPtr ); } ), collection.end() );
+}
+
+
+template< typename ObjectType > void PhysicsObjectCollection< ObjectType >::selectObjects( const std::vector< unsigned char >& keepMask ){
+    if( keepMask.size() != size() ){
+        throw std::invalid_argument( "Mask of size " + std::to_string( keepMask.size() ) + " can not be applied to a collection of size " + std::to_string( size() ) + "." );
+    }
+    markModified();
+    size_type numberOfKept = 0;
+    for( size_type i = 0; i < keepMask.size(); ++i ){
+        if( keepMask[ i ] ){
+            if( i != numberOfKept ){
+                collection[ numberOfKept ] = std::move( collection[ i ] );
+            }
+            ++numberOfKept;
         }
     }
+    collection.erase( collection.begin() + numberOfKept, collection.end() );
 }
 
 
-template< typename ObjectType > void PhysicsObjectCollection< ObjectType >::selectObjects( bool (&passSelection)( const ObjectType& ) ){
-    for( const_iterator it = cbegin(); it != cend(); ){
-        if( !passSelection( **it ) ){
-            it = erase( it );
-        } else {
-            ++it;
+template< typename ObjectType > typename PhysicsObjectCollection< ObjectType >::collection_type PhysicsObjectCollection< ObjectType >::selectedObjects( bool (ObjectType::*passSelection)() const ) const{
+    collection_type selected;
+    selected.reserve( size() );
+    for( const auto& objectPtr : collection ){
+        if( ( (*objectPtr).*passSelection )() ){
+            selected.push_back( objectPtr );
         }
     }
+    return selected;
 }
 
 
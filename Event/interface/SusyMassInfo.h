@@ -12,9 +12,14 @@ class SusyMassInfo{
         double massNLSP() const{ return _massNLSP; }
         double massLSP() const{ return _massLSP; }
 
+        //index of the mass point in the SusyScan attached to the TreeReader, resolved once when the event is built
+        bool hasMassPointIndex() const;
+        size_t massPointIndex() const;
+
     private:
         double _massNLSP;
         double _massLSP;
+        size_t _massPointIndex;
 };
 
 
@@ -2,18 +2,20 @@
 #define TriggerInfo_H
 
 //include c++ library classes 
-#include <map>
 #include <string>
+#include <memory>
+#include <cstddef>
 
 //include other parts of framework
 #include "../../TreeReader/interface/TreeReader.h"
+#include "../../TreeReader/interface/DecisionTable.h"
 
 
 class TriggerInfo{
 
     public:
 
-        //WARNING : turning on 'readIndividualTriggers' and/or 'readIndividualMETFilters' is relatively slow ( takes slightly more time than building the entire event! )
+        //the individual decisions are packed into bitsets, the names are resolved by a table shared by all events of the sample
         TriggerInfo( const TreeReader&, const bool readIndividualTriggers = false, const bool readIndividualMetFilters = false );
 
         bool passTriggers_e() const{ return _passTriggers_e; }
@@ -33,6 +35,13 @@ class TriggerInfo{
         bool passTrigger( const std::string& ) const;
         bool passMetFilter( const std::string& ) const;
 
+        //resolve a name once, after which a decision is a single bit test
+        //the indices are the same for all events of a sample, and an exception is thrown for events not reading the individual triggers or MET filters
+        std::size_t triggerIndex( const std::string& ) const;
+        std::size_t metFilterIndex( const std::string& ) const;
+        bool passTrigger( const std::size_t triggerIndex ) const;
+        bool passMetFilter( const std::size_t filterIndex ) const;
+
         void printAvailableIndividualTriggers() const;
         void printAvailableMetFilters() const;
 
@@ -51,8 +60,10 @@ class TriggerInfo{
         bool _passTriggers_FR;
         bool _passTriggers_FR_iso;
         bool _passMetFilters;
-        std::map< std::string, bool > individualTriggerMap; 
-        std::map< std::string, bool > individualMetFilterMap; 
+        DecisionTable::bitset_type _individualTriggers;
+        DecisionTable::bitset_type _individualMetFilters;
+        std::shared_ptr< const DecisionTable > _triggerTablePtr;
+        std::shared_ptr< const DecisionTable > _metFilterTablePtr;
 };
 
 #endif 
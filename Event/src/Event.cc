@@ -168,65 +168,50 @@ SusyMassInfo& Event::susyMassInfo() const{
 
 
 void Event::initializeZBosonCandidate(){
-    if( !ZIsInitialized ){
-
-        //check that there are at least two leptons is performed automatically in LeptonCollection
-        
-        //leading lepton not used in this pairing is considered to be from the W decay (in trilepton events )
-        //BUT in order to have consistent indices, sort leptons by pT already here.
-        sortLeptonsByPt();
-
-        //reconstruct the best Z boson
-        std::pair< std::pair< LeptonCollection::size_type, LeptonCollection::size_type >, double > ZBosonCandidateIndicesAndMass = _leptonCollectionPtr->bestZBosonCandidateIndicesAndMass();
-        _bestZBosonCandidateIndices = ZBosonCandidateIndicesAndMass.first;
-        _bestZBosonCandidateMass = ZBosonCandidateIndicesAndMass.second;
-
-        //note that the third lepton can also be a tau in this case!
-        if( numberOfLeptons() >= 3 ){
-            for( LeptonCollection::size_type leptonIndex = 0; leptonIndex < numberOfLeptons(); ++leptonIndex ){
-                if( !( leptonIndex == _bestZBosonCandidateIndices.first || leptonIndex == _bestZBosonCandidateIndices.second ) ){
-                    _WLeptonIndex = leptonIndex;
-                    break;
-                }
-            }
-        }
 
-        ZIsInitialized = true;
-    }
+    //leading lepton not used in this pairing is considered to be from the W decay (in trilepton events )
+    //BUT in order to have consistent indices, sort leptons by pT already here.
+    //the lepton collection only recomputes the Z boson candidate when the sorting changed the order of the leptons
+    sortLeptonsByPt();
 }
 
 
 std::pair< std::pair< LeptonCollection::size_type, LeptonCollection::size_type >, double > Event::bestZBosonCandidateIndicesAndMass(){
     initializeZBosonCandidate();    
-    return { _bestZBosonCandidateIndices, _bestZBosonCandidateMass };
+    return _leptonCollectionPtr->bestZBosonCandidateIndicesAndMass();
 }
 
 
 std::pair< LeptonCollection::size_type, LeptonCollection::size_type > Event::bestZBosonCandidateIndices(){
-    initializeZBosonCandidate();
-    return _bestZBosonCandidateIndices;
+    return bestZBosonCandidateIndicesAndMass().first;
 }
 
 
 double Event::bestZBosonCandidateMass(){
-    initializeZBosonCandidate();
-    return _bestZBosonCandidateMass;
+    return bestZBosonCandidateIndicesAndMass().second;
 }
 
 
 bool Event::hasZTollCandidate( const double oneSidedMassWindow ){
-    initializeZBosonCandidate();
-    return ( fabs( bestZBosonCandidateMass() - particle::mZ ) < oneSidedMassWindow );
+    return ( hasZBosonCandidate() && fabs( bestZBosonCandidateMass() - particle::mZ ) < oneSidedMassWindow );
 }
 
 
 LeptonCollection::size_type Event::WLeptonIndex(){
-    initializeZBosonCandidate();
-    return _WLeptonIndex;
+    std::pair< LeptonCollection::size_type, LeptonCollection::size_type > ZBosonCandidateIndices = bestZBosonCandidateIndices();
+
+    //note that the third lepton can also be a tau in this case!
+    if( numberOfLeptons() >= 3 ){
+        for( LeptonCollection::size_type leptonIndex = 0; leptonIndex < numberOfLeptons(); ++leptonIndex ){
+            if( !( leptonIndex == ZBosonCandidateIndices.first || leptonIndex == ZBosonCandidateIndices.second ) ){
+                return leptonIndex;
+            }
+        }
+    }
+    return 0;
 }
 
 
 double Event::mtW(){
-    initializeZBosonCandidate();
     return mt( WLepton(), met() );
 }
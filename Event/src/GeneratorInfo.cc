@@ -20,15 +20,13 @@ GeneratorInfo::GeneratorInfo( const TreeReader& treeReader ) :
     if( _numberOfLheWeights > maxNumberOfLheWeights ){
         throw std::out_of_range( "_numberOfLheWeights is larger than 148, which is the maximum array size of _lheWeights." );
     }
-    for( unsigned i = 0; i < _numberOfLheWeights; ++i  ){
-        _lheWeights[i] = treeReader._lheWeight[i];
-    }
-
     if( _numberOfPsWeights > maxNumberOfPsWeights ){
         throw std::out_of_range( "_numberOfPsWeights is larger than 14, which is the maximum array size of _psWeights." );
     }
-    for( unsigned i = 0; i < _numberOfPsWeights; ++i ){
-        _psWeights[i] = treeReader._psWeight[i];
+    if( _numberOfLheWeights + _numberOfPsWeights > 0 ){
+        _generatorWeights.reserve( _numberOfLheWeights + _numberOfPsWeights );
+        _generatorWeights.insert( _generatorWeights.end(), treeReader._lheWeight, treeReader._lheWeight + _numberOfLheWeights );
+        _generatorWeights.insert( _generatorWeights.end(), treeReader._psWeight, treeReader._psWeight + _numberOfPsWeights );
     }
 
     //prefire weights are not defined for 2018 events, set them to unity
@@ -49,16 +47,31 @@ double retrieveWeight( const double* array, const unsigned index, const unsigned
 }
 
 
+unsigned GeneratorInfo::numberOfScaleVariations() const{
+    return std::min( _numberOfLheWeights, unsigned(9) );
+}
+
+
+unsigned GeneratorInfo::numberOfPdfVariations() const{
+    return std::min( std::max( _numberOfLheWeights, unsigned(9) ) - 9, unsigned(100) );
+}
+
+
+unsigned GeneratorInfo::numberOfPsVariations() const{
+    return std::min( _numberOfPsWeights, unsigned(14) );
+}
+
+
 double GeneratorInfo::relativeWeightPdfVar( const unsigned pdfIndex ) const{
-    return retrieveWeight( _lheWeights, pdfIndex, 9, std::min( std::max( _numberOfLheWeights, unsigned(9) ) - 9, unsigned(100) ), "pdf" );
+    return retrieveWeight( _generatorWeights.data(), pdfIndex, 9, numberOfPdfVariations(), "pdf" );
 }
 
 
 double GeneratorInfo::relativeWeightScaleVar( const unsigned scaleIndex ) const{
-    return retrieveWeight( _lheWeights, scaleIndex, 0, std::min( _numberOfLheWeights, unsigned(9) ), "scale" );
+    return retrieveWeight( _generatorWeights.data(), scaleIndex, 0, numberOfScaleVariations(), "scale" );
 }
 
 
 double GeneratorInfo::relativeWeightPsVar( const unsigned psIndex ) const{
-    return retrieveWeight( _psWeights, psIndex, 0, std::min( _numberOfPsWeights, unsigned(14) ), "parton shower" ); 
+    return retrieveWeight( _generatorWeights.data() + _numberOfLheWeights, psIndex, 0, numberOfPsVariations(), "parton shower" ); 
 }
@@ -3,6 +3,7 @@
 
 //include other parts of framework
 #include "../interface/LeptonCollection.h"
+#include "../../objects/interface/overlapRemoval.h"
 
 
 JetCollection::JetCollection( const TreeReader& treeReader ){
@@ -23,42 +24,32 @@ void JetCollection::selectGoodAnyVariationJets(){
 
 
 void JetCollection::cleanJetsFromLeptons( const LeptonCollection& leptonCollection, bool (Lepton::*passSelection)() const, const double coneSize ){
-    for( const_iterator jetIt = cbegin(); jetIt != cend(); ){
-        Jet& jet = **jetIt;
 
-        //increment iterator if jet is not deleted 
-        bool isDeleted = false;
-        for( LeptonCollection::const_iterator lIt = leptonCollection.cbegin(); lIt != leptonCollection.cend(); ++lIt ){
-            Lepton& lepton = **lIt;
-
-            //lepton must pass specified selection
-            if( !(lepton.*passSelection)() ) continue;
-
-            //remove jet if it overlaps with a selected lepton
-            if( deltaR( jet, lepton ) < coneSize ){
-
-                jetIt = erase( jetIt );
-                isDeleted = true;
-                break;
-            }
-        }
-        if( !isDeleted ){
-            ++jetIt;
+    //leptons must pass specified selection
+    overlapRemoval::EtaPhiArrays leptonDirections;
+    leptonDirections.reserve( leptonCollection.size() );
+    for( const auto& leptonPtr : leptonCollection ){
+        if( ( *leptonPtr.*passSelection )() ){
+            leptonDirections.push_back( *leptonPtr );
         }
     }
+    if( leptonDirections.size() == 0 ) return;
+
+    overlapRemoval::EtaPhiArrays jetDirections;
+    jetDirections.reserve( size() );
+    for( const auto& jetPtr : *this ){
+        jetDirections.push_back( *jetPtr );
+    }
+
+    //remove jets overlapping with a selected lepton
+    selectObjects( overlapRemoval::keepMask( jetDirections, leptonDirections, coneSize ) );
 }
 
 
 JetCollection JetCollection::buildSubCollection( bool (Jet::*passSelection)() const ) const{
-    std::vector< std::shared_ptr< Jet > > jetVector;
-    for( const auto& jetPtr : *this ){
-        if( ( *jetPtr.*passSelection )() ){
 
-            //jets are shared between collections!
-            jetVector.push_back( jetPtr );
-        }
-    }
-    return JetCollection( jetVector );
+    //jets are shared between collections!
+    return JetCollection( selectedObjects( passSelection ) );
 }
 
 
@@ -89,6 +80,7 @@ JetCollection JetCollection::tightBTagCollection() const{
 
 JetCollection JetCollection::buildVariedCollection( Jet (Jet::*variedJet)() const ) const{
     std::vector< std::shared_ptr< Jet > > jetVector;
+    jetVector.reserve( size() );
     for( const auto& jetPtr : *this ){
 
         //jets are NOT shared between collections!
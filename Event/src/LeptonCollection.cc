@@ -1,13 +1,16 @@
 #include "../interface/LeptonCollection.h"
 
 //include c++ library classes 
-#include <set>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
 
 //include other parts of code 
 #include "../../objects/interface/Muon.h"
 #include "../../objects/interface/Electron.h"
 #include "../../objects/interface/Tau.h"
 #include "../../constants/particleMasses.h"
+#include "../../objects/interface/overlapRemoval.h"
 
 
 LeptonCollection::LeptonCollection( const TreeReader& treeReader ){
@@ -29,45 +32,103 @@ LeptonCollection::LeptonCollection( const TreeReader& treeReader ){
 }
 
 
+const LeptonCollection::FlavorIndices& LeptonCollection::flavorIndices() const{
+    if( _flavorIndicesComputed && ( _flavorIndicesModificationCount == modificationCount() ) ){
+        return _flavorIndices;
+    }
+
+    //the vectors are cleared instead of rebuilt, so their memory is reused when the collection changes
+    _flavorIndices.muonIndices.clear();
+    _flavorIndices.electronIndices.clear();
+    _flavorIndices.tauIndices.clear();
+    _flavorIndices.lightLeptonIndices.clear();
+    for( size_type i = 0; i < size(); ++i ){
+        const Lepton& lepton = (*this)[ i ];
+        if( lepton.isMuon() ){
+            _flavorIndices.muonIndices.push_back( i );
+        } else if( lepton.isElectron() ){
+            _flavorIndices.electronIndices.push_back( i );
+        } else if( lepton.isTau() ){
+            _flavorIndices.tauIndices.push_back( i );
+        }
+        if( lepton.isLightLepton() ){
+            _flavorIndices.lightLeptonIndices.push_back( i );
+        }
+    }
+    _flavorIndicesModificationCount = modificationCount();
+    _flavorIndicesComputed = true;
+    return _flavorIndices;
+}
+
+
+Lepton& LeptonCollection::leptonOfFlavor( const std::vector< size_type >& flavorIndices, const size_type index, const std::string& flavorName ) const{
+    if( index >= flavorIndices.size() ){
+        throw std::out_of_range( "Trying to access " + flavorName + " " + std::to_string( index ) + " while the collection only contains " + std::to_string( flavorIndices.size() ) + " " + flavorName + "s." );
+    }
+
+    return **( cbegin() + flavorIndices[ index ] );
+}
+
+
+Muon& LeptonCollection::muon( const size_type muonIndex ) const{
+    return static_cast< Muon& >( leptonOfFlavor( flavorIndices().muonIndices, muonIndex, "muon" ) );
+}
+
+
+Electron& LeptonCollection::electron( const size_type electronIndex ) const{
+    return static_cast< Electron& >( leptonOfFlavor( flavorIndices().electronIndices, electronIndex, "electron" ) );
+}
+
+
+Tau& LeptonCollection::tau( const size_type tauIndex ) const{
+    return static_cast< Tau& >( leptonOfFlavor( flavorIndices().tauIndices, tauIndex, "tau" ) );
+}
+
+
+LightLepton& LeptonCollection::lightLepton( const size_type lightLeptonIndex ) const{
+    return static_cast< LightLepton& >( leptonOfFlavor( flavorIndices().lightLeptonIndices, lightLeptonIndex, "light lepton" ) );
+}
+
+
 MuonCollection LeptonCollection::muonCollection() const{
+    const std::vector< size_type >& indices = flavorIndices().muonIndices;
     std::vector< std::shared_ptr< Muon > > muonVector;
-    for( const auto& leptonPtr : *this ){
-        if( leptonPtr->isMuon() ){
-            muonVector.push_back( std::static_pointer_cast< Muon >( leptonPtr ) );
-        }
+    muonVector.reserve( indices.size() );
+    for( size_type index : indices ){
+        muonVector.push_back( std::static_pointer_cast< Muon >( *( cbegin() + index ) ) );
     }
     return MuonCollection( muonVector );
 }
 
 
 ElectronCollection LeptonCollection::electronCollection() const{
+    const std::vector< size_type >& indices = flavorIndices().electronIndices;
     std::vector< std::shared_ptr< Electron > > electronVector;
-    for( const auto& leptonPtr : *this ){
-        if( leptonPtr->isElectron() ){
-            electronVector.push_back( std::static_pointer_cast< Electron >( leptonPtr ) );
-        }
+    electronVector.reserve( indices.size() );
+    for( size_type index : indices ){
+        electronVector.push_back( std::static_pointer_cast< Electron >( *( cbegin() + index ) ) );
     }
     return ElectronCollection( electronVector );
 }
 
 
 TauCollection LeptonCollection::tauCollection() const{
+    const std::vector< size_type >& indices = flavorIndices().tauIndices;
     std::vector< std::shared_ptr< Tau > > tauVector;
-    for( const auto& leptonPtr : *this  ){
-        if( leptonPtr->isTau() ){
-            tauVector.push_back( std::static_pointer_cast< Tau >( leptonPtr ) );
-        }
+    tauVector.reserve( indices.size() );
+    for( size_type index : indices ){
+        tauVector.push_back( std::static_pointer_cast< Tau >( *( cbegin() + index ) ) );
     }
     return TauCollection( tauVector );
 }
 
 
 LightLeptonCollection LeptonCollection::lightLeptonCollection() const{
+    const std::vector< size_type >& indices = flavorIndices().lightLeptonIndices;
     std::vector< std::shared_ptr< LightLepton > > lightLeptonVector;
-    for( const auto leptonPtr : *this ){
-        if( leptonPtr->isLightLepton() ){
-            lightLeptonVector.push_back( std::static_pointer_cast< LightLepton >( leptonPtr ) );
-        }
+    lightLeptonVector.reserve( indices.size() );
+    for( size_type index : indices ){
+        lightLeptonVector.push_back( std::static_pointer_cast< LightLepton >( *( cbegin() + index ) ) );
     }
     return LightLeptonCollection( lightLeptonVector );
 }
@@ -88,25 +149,25 @@ void LeptonCollection::selectTightLeptons(){
 }
 
 
-LeptonCollection LeptonCollection::selectedCollection( void (LeptonCollection::*applySelection)() ) const{
-    LeptonCollection lepCol( *this );
-    (lepCol.*applySelection)();
-    return lepCol;
+LeptonCollection LeptonCollection::selectedCollection( bool (Lepton::*passSelection)() const ) const{
+
+    //leptons are shared between collections!
+    return LeptonCollection( selectedObjects( passSelection ) );
 }
 
 
 LeptonCollection LeptonCollection::looseLeptonCollection() const{
-    return selectedCollection( &LeptonCollection::selectLooseLeptons );
+    return selectedCollection( &Lepton::isLoose );
 }
 
 
 LeptonCollection LeptonCollection::FOLeptonCollection() const{
-    return selectedCollection( &LeptonCollection::selectFOLeptons );
+    return selectedCollection( &Lepton::isFO );
 }
 
 
 LeptonCollection LeptonCollection::tightLeptonCollection() const{
-    return selectedCollection( &LeptonCollection::selectTightLeptons );
+    return selectedCollection( &Lepton::isTight );
 }
 
 
@@ -135,37 +196,30 @@ LeptonCollection LeptonCollection::leadingLeptonCollection( LeptonCollection::si
 
 void LeptonCollection::clean( bool (Lepton::*isFlavorToClean)() const, bool (Lepton::*isFlavorToCleanFrom)() const, bool (Lepton::*passSelection)() const, const double coneSize ){
 
-    for( const_iterator l1It = cbegin(); l1It != cend(); ){
-        Lepton& l1 = **l1It;
-
-        //to increment iterator when no lepton is deleted 
-        bool isDeleted = false;
-        if( (l1.*isFlavorToClean)() ){
-
-            for( const_iterator l2It = cbegin(); l2It != cend(); ++l2It ){
-
-                //prevent comparing same objects 
-                if( l1It == l2It ) continue;
-
-                Lepton& l2 = **l2It;
-
-                //make sure l2 passes required selection for cleaning 
-                if( ! ( (l2.*isFlavorToCleanFrom)() && (l2.*passSelection)() ) ) continue;
-
-                //clean within given cone size
-                if( deltaR( l1, l2 ) < coneSize ){
-
-                    l1It = erase( l1It );
-                    isDeleted = true;
-
-                    break;
-                }
-            }
-        }
-        if( ! isDeleted ){
-            ++l1It;
+    //the flavors to clean and to clean from are different, so removing a lepton never changes the leptons that others are cleaned from
+    overlapRemoval::EtaPhiArrays cleanedDirections;
+    overlapRemoval::EtaPhiArrays referenceDirections;
+    std::vector< size_type > cleanedIndices;
+    for( size_type i = 0; i < size(); ++i ){
+        const Lepton& lepton = (*this)[ i ];
+        if( (lepton.*isFlavorToClean)() ){
+            cleanedIndices.push_back( i );
+            cleanedDirections.push_back( lepton );
+
+        //make sure reference leptons pass required selection for cleaning 
+        } else if( (lepton.*isFlavorToCleanFrom)() && (lepton.*passSelection)() ){
+            referenceDirections.push_back( lepton );
         }
     }
+    if( cleanedIndices.empty() || referenceDirections.size() == 0 ) return;
+
+    //clean within given cone size
+    std::vector< unsigned char > cleanedMask = overlapRemoval::keepMask( cleanedDirections, referenceDirections, coneSize );
+    std::vector< unsigned char > mask( size(), 1 );
+    for( size_type c = 0; c < cleanedIndices.size(); ++c ){
+        mask[ cleanedIndices[ c ] ] = cleanedMask[ c ];
+    }
+    selectObjects( mask );
 }
 
 
@@ -207,22 +261,22 @@ void LeptonCollection::applyConeCorrection() const{
 
 
 LeptonCollection::size_type LeptonCollection::numberOfMuons() const{
-    return count( &Lepton::isMuon );
+    return flavorIndices().muonIndices.size();
 }
 
 
 LeptonCollection::size_type LeptonCollection::numberOfElectrons() const{
-    return count( &Lepton::isElectron );
+    return flavorIndices().electronIndices.size();
 }
 
 
 LeptonCollection::size_type LeptonCollection::numberOfTaus() const{
-    return count( &Lepton::isTau );
+    return flavorIndices().tauIndices.size();
 }
 
 
 LeptonCollection::size_type LeptonCollection::numberOfLightLeptons() const{
-    return count( &Lepton::isLightLepton );
+    return flavorIndices().lightLeptonIndices.size();
 }
 
 
@@ -241,136 +295,139 @@ LeptonCollection::size_type LeptonCollection::numberOfTightLeptons() const{
 }
 
 
-//numbers signifying lepton flavor-charge combinations
-enum LeptonCollection::FlavorCharge : unsigned int { OSSF_light, OSSF_tau, OS, SS, ZeroOrOneLepton };
+//flags describing the charge and flavor combination of a lepton pair
+namespace{
+    enum PairFlag : unsigned char { oppositeSignFlag = 1, sameFlavorFlag = 2, lightFlag = 4 };
+}
+
+
+const LeptonCollection::PairCombinatorics& LeptonCollection::pairCombinatorics() const{
 
+    //the combinatorics are recomputed when leptons were added, removed or reordered, or when their momenta changed ( e.g. by a cone correction )
+    bool isUpToDate = _pairCombinatoricsComputed && ( _pairCombinatoricsState.size() == size() );
+    for( size_type i = 0; isUpToDate && i < size(); ++i ){
+        const Lepton& lepton = (*this)[ i ];
+        isUpToDate = ( _pairCombinatoricsState[ i ].first == &lepton ) && ( _pairCombinatoricsState[ i ].second == lepton.pt() );
+    }
+    if( !isUpToDate ){
+        computePairCombinatorics();
+    }
+    return _pairCombinatorics;
+}
 
-LeptonCollection::FlavorCharge LeptonCollection::flavorChargeCombination() const{
-    if( size() <= 1 ){
-        return ZeroOrOneLepton;
-    } 
 
+void LeptonCollection::computePairCombinatorics() const{
+    _pairCombinatorics = PairCombinatorics();
+    _pairFlags.clear();
+    _pairCombinatoricsState.clear();
+    for( const auto& leptonPtr : *this ){
+        _pairCombinatoricsState.push_back( { leptonPtr.get(), leptonPtr->pt() } );
+    }
+    _pairCombinatoricsComputed = true;
+
+    //only the masses of light OSSF pairs are needed for Z boson reconstruction, so no other masses are computed
+    double minDiff = std::numeric_limits< double >::max();
+    for( size_type i = 0; i < size(); ++i ){
+        const Lepton& l1 = (*this)[ i ];
+        for( size_type j = i + 1; j < size(); ++j ){
+            const Lepton& l2 = (*this)[ j ];
+            unsigned char flags = 0;
+            if( l1.charge() != l2.charge() ) flags |= oppositeSignFlag;
+            if( sameFlavor( l1, l2 ) ) flags |= sameFlavorFlag;
+            if( l1.isLightLepton() && l2.isLightLepton() ) flags |= lightFlag;
+            _pairFlags.push_back( flags );
+
+            if( !( flags & oppositeSignFlag ) ) continue;
+            _pairCombinatorics.hasOSPair = true;
+            if( !( flags & sameFlavorFlag ) ) continue;
+            _pairCombinatorics.hasOSSFPair = true;
+            if( !( flags & lightFlag ) ) continue;
+            _pairCombinatorics.hasLightOSSFPair = true;
+
+            //minimize mass difference with mZ over light OSSF lepton pairs
+            double mass = ( l1 + l2 ).mass();
+            double massDifference = std::abs( mass - particle::mZ );
+            if( massDifference < minDiff ){
+                minDiff = massDifference;
+                _pairCombinatorics.bestZBosonCandidateMass = mass;
+                _pairCombinatorics.bestZBosonCandidateIndices = { i, j };
+            }
+        }
+    }
+    _pairCombinatorics.numberOfUniqueOSPairs = numberOfUniquePairs( oppositeSignFlag );
+    _pairCombinatorics.numberOfUniqueOSSFPairs = numberOfUniquePairs( oppositeSignFlag | sameFlavorFlag );
+}
 
-    FlavorCharge currentState = SS;
 
-    for( const_iterator l1It = cbegin(); l1It != cend() - 1; ++l1It ){
-        Lepton& l1 = **l1It;
-        for( const_iterator l2It = l1It + 1; l2It != cend(); ++l2It ){
-            Lepton& l2 = **l2It;
+LeptonCollection::size_type LeptonCollection::numberOfUniquePairs( const unsigned char requiredFlags ) const{
+    size_type numberOfPairs = 0;
 
-            if( l1.charge() != l2.charge() ){
-                currentState = OS;
+    //avoid double counting of leptons 
+    std::vector< bool > isUsed( size(), false );
+    size_type pairIndex = 0;
+    for( size_type i = 0; i < size(); ++i ){
+        size_type firstPairIndex = pairIndex;
+        pairIndex += ( size() - i - 1 );
+        if( isUsed[ i ] ) continue;
+        for( size_type j = i + 1; j < size(); ++j ){
+            if( isUsed[ j ] ) continue;
 
-                if( sameFlavor( l1, l2 ) && l1.isLightLepton() ){
+            //if the lepton pair satisfies the condition, count it and make sure it can not be re-used 
+            if( ( _pairFlags[ firstPairIndex + ( j - i - 1 ) ] & requiredFlags ) == requiredFlags ){
+                ++numberOfPairs;
+                isUsed[ i ] = true;
+                isUsed[ j ] = true;
 
-                    //OSSF_light can be returned because it has precedence over other combinations, as it is a requirement for Z boson reconstruction
-                    return OSSF_light;
-                } else if( sameFlavor( l1, l2 ) && l1.isTau() ){
-                    currentState = OSSF_tau;
-                }
+                //without this break there can be cases where lepton i will be making a pair with yet another lepton!
+                break;
             }
         }
     }
-    return currentState;
+    return numberOfPairs;
 }
 
 
 bool LeptonCollection::hasOSSFPair() const{
-    FlavorCharge flavorCharge = flavorChargeCombination();
-    return ( ( flavorCharge == OSSF_light ) || ( flavorCharge == OSSF_tau ) );
+    return pairCombinatorics().hasOSSFPair;
 }
 
 
 bool LeptonCollection::hasLightOSSFPair() const{
-    return ( flavorChargeCombination() == OSSF_light );
+    return pairCombinatorics().hasLightOSSFPair;
 }
 
 
 bool LeptonCollection::hasOSPair() const{
-    FlavorCharge flavorCharge = flavorChargeCombination();
-    return ( ( flavorCharge == OSSF_light ) || ( flavorCharge == OSSF_tau ) || ( flavorCharge == OS ) );
+    return pairCombinatorics().hasOSPair;
 }
 
 
 bool LeptonCollection::isSameSign() const{
-    return ( flavorChargeCombination() == SS );
+    return ( size() > 1 ) && !hasOSPair();
 }
 
 
-template< typename function_type> LeptonCollection::size_type LeptonCollection::numberOfUniquePairs( const function_type& pairSatisfiesCondition ) const{
-    size_type numberOfPairs = 0;
-
-    //there can be no pairs when there are less than 2 leptons
-    if( size() <= 1 ){
-        return 0;
-    }
-
-    //avoid double counting of leptons 
-    std::set< const_iterator > usedLeptonIterators;
-
-    for( const_iterator l1It = cbegin(); l1It != cend() - 1; ++l1It ){
-        if( usedLeptonIterators.find( l1It ) != usedLeptonIterators.cend() ) continue;
-        Lepton& l1 = **l1It;
-        for( const_iterator l2It = l1It + 1; l2It != cend(); ++l2It ){
-            if( usedLeptonIterators.find( l2It ) != usedLeptonIterators.cend() ) continue;
-            Lepton& l2 = **l2It;
-
-            //if the lepton pair satisfies the condition, count it and make sure it can not be re-used 
-            if( pairSatisfiesCondition( l1, l2 ) ){
-                ++numberOfPairs;
-                usedLeptonIterators.insert( {l1It, l2It} );
-
-                //without this break there can be cases where l1 will be making a pair with yet another l2!
-                break;
-            }
-        }
-    }
-    return numberOfPairs;
+LeptonCollection::size_type LeptonCollection::numberOfUniqueOSSFPairs() const{
+    return pairCombinatorics().numberOfUniqueOSSFPairs;
 }
 
 
-LeptonCollection::size_type LeptonCollection::numberOfUniqueOSSFPairs() const{
-    return numberOfUniquePairs( oppositeSignSameFlavor ); 
+LeptonCollection::size_type LeptonCollection::numberOfUniqueOSPairs() const{
+    return pairCombinatorics().numberOfUniqueOSPairs;
 }
 
 
-LeptonCollection::size_type LeptonCollection::numberOfUniqueOSPairs() const{
-    return numberOfUniquePairs( []( const Lepton& lhs, const Lepton& rhs ){ return lhs.charge() != rhs.charge(); } );
+bool LeptonCollection::hasZBosonCandidate() const{
+    return hasLightOSSFPair();
 }
 
 
 std::pair< std::pair< LeptonCollection::size_type, LeptonCollection::size_type >, double > LeptonCollection::bestZBosonCandidateIndicesAndMass() const{
-
-    //currently the code only works when an OSSF pair is present 
-    if( !hasLightOSSFPair() ){
+    const PairCombinatorics& combinatorics = pairCombinatorics();
+    if( !combinatorics.hasLightOSSFPair ){
         throw std::domain_error( "Finding the best leptonic Z decay candidate is only defined when two light leptons of opposite sign and same flavor are present in the event." );
     }
-
-    //minimize mass difference with mZ over OSSF lepton pairs, and determine best mass and indices of the leptons forming this mass 
-    double minDiff = std::numeric_limits< double >::max();
-    double bestMass = 0;
-    std::pair< size_type, size_type > indicesZCandidate = {99, 99};
-
-    for( const_iterator l1It = cbegin(); l1It != cend() - 1; ++l1It ){
-        Lepton& l1 = **l1It;
-
-        //only consider light leptons
-        if( l1.isTau() ) continue;
-        for( const_iterator l2It = l1It + 1; l2It != cend(); ++l2It ){
-            Lepton& l2 = **l2It; 
-            if( !oppositeSignSameFlavor( l1, l2 ) ) continue;
-
-            double mass = ( l1 + l2 ).mass();
-            double massDifference = std::abs( mass - particle::mZ );
-            if( massDifference < minDiff ){
-                minDiff = massDifference;
-                bestMass = mass;
-                indicesZCandidate = { l1It - cbegin(), l2It - cbegin() };
-            }
-        }
-    }
-
-    return { indicesZCandidate, bestMass };
+    return { combinatorics.bestZBosonCandidateIndices, combinatorics.bestZBosonCandidateMass };
 }
 
 
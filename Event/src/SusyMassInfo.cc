@@ -4,15 +4,39 @@
 //include c++ library classes
 #include <exception>
 
+//include other parts of framework
+#include "../../Tools/interface/SusyScan.h"
+
 
 SusyMassInfo::SusyMassInfo( const TreeReader& treeReader ) :
     _massNLSP( treeReader._mChi2 ),
-    _massLSP( treeReader._mChi1 )
+    _massLSP( treeReader._mChi1 ),
+    _massPointIndex( SusyScan::invalidIndex )
 {
-    if( !treeReader.containsSusyMassInfo() ){
+
+    //use the cached flag instead of scanning the branch names for every event
+    if( !treeReader.isSusy() ){
         throw std::runtime_error( "Can not instantiate SUSYMassInfo object since the TreeReader has no SUSY mass information." );
     }
     if( std::abs( _massLSP - 1. ) < 1e-8 ){
         _massLSP = 0.;
     }
+
+    //resolve the mass point index once so analysis code can directly index per-point histograms
+    if( treeReader.susyScanPtr() != nullptr ){
+        _massPointIndex = treeReader.susyScanPtr()->indexOrInvalid( _massNLSP, _massLSP );
+    }
+}
+
+
+bool SusyMassInfo::hasMassPointIndex() const{
+    return ( _massPointIndex != SusyScan::invalidIndex );
+}
+
+
+size_t SusyMassInfo::massPointIndex() const{
+    if( !hasMassPointIndex() ){
+        throw std::domain_error( "Mass point " + std::to_string( _massNLSP ) + "/" + std::to_string( _massLSP ) + " has no index, either no SusyScan was attached to the TreeReader or the point is not part of the scan." );
+    }
+    return _massPointIndex;
 }
@@ -4,19 +4,6 @@
 #include <iostream>
 #include <stdexcept>
 
-//include other parts of framework
-#include "../../Tools/interface/stringTools.h"
-
-
-//remove leading _ from trigger and filter names 
-std::string cleanName( const std::string& name ){
-    std::string ret( name );
-    if( stringTools::stringStartsWith( name, "_" ) ){
-        ret.erase(0, 1);
-    }
-    return ret;
-}
-
 
 TriggerInfo::TriggerInfo( const TreeReader& treeReader, const bool readIndividualTriggers, const bool readIndividualMetFilters ) :
     _passTriggers_e( treeReader._passTrigger_e ),
@@ -35,53 +22,82 @@ TriggerInfo::TriggerInfo( const TreeReader& treeReader, const bool readIndividua
     _passMetFilters( treeReader._passMETFilters )
 {
     if( readIndividualTriggers ){
-        for( const auto& trigger : treeReader._triggerMap ){
-            individualTriggerMap.insert( { cleanName( trigger.first ), trigger.second } );
-        }
+        _triggerTablePtr = treeReader._triggerTablePtr;
+        _individualTriggers = _triggerTablePtr->decisions();
     }
     if( readIndividualMetFilters ){
-        for( const auto& filter : treeReader._MetFilterMap ){
-            individualMetFilterMap.insert( { cleanName( filter.first ), filter.second } );
-        }   
+        _metFilterTablePtr = treeReader._MetFilterTablePtr;
+        _individualMetFilters = _metFilterTablePtr->decisions();
     }
 }
 
 
-bool passTriggerOrFilter( const std::map< std::string, bool >& decisionMap,  const std::string& name ){
-    auto decisionIt = decisionMap.find( name );
+namespace{
+
+    std::size_t decisionIndex( const std::shared_ptr< const DecisionTable >& tablePtr, const std::string& name, const std::string& decisionType ){
+        if( !tablePtr ){
+            throw std::invalid_argument( "Requested " + decisionType + " '" + name + "' while the individual " + decisionType + "s were not read for this event." );
+        }
+        return tablePtr->index( name );
+    }
+
+
+    bool decisionAtIndex( const std::shared_ptr< const DecisionTable >& tablePtr, const DecisionTable::bitset_type& decisions, const std::size_t index, const std::string& decisionType ){
+        if( !tablePtr ){
+            throw std::invalid_argument( "Requested " + decisionType + " " + std::to_string( index ) + " while the individual " + decisionType + "s were not read for this event." );
+        }
+        if( index >= tablePtr->size() ){
+            throw std::out_of_range( "Requested " + decisionType + " " + std::to_string( index ) + " while only " + std::to_string( tablePtr->size() ) + " are available." );
+        }
+        return decisions.test( index );
+    }
+
 
-    //throw error if non-existing trigger or MET filter is requested
-    if( decisionIt == decisionMap.cend() ){
-        throw std::invalid_argument( "Requested trigger or MET filter '" + name + "' does not exist." );
-    } else {
-        return (*decisionIt).second;
+    void printAvailableInfo( const std::shared_ptr< const DecisionTable >& tablePtr, const std::string& decisionType ){
+        std::cout << "Available " << decisionType << " :\n";
+        if( !tablePtr ) return;
+        for( const auto& name : tablePtr->names() ){
+            std::cout << name << "\n";
+        }
     }
 }
 
 
-bool TriggerInfo::passTrigger( const std::string& triggerName ) const{
-    return passTriggerOrFilter( individualTriggerMap, triggerName );
+std::size_t TriggerInfo::triggerIndex( const std::string& triggerName ) const{
+    return decisionIndex( _triggerTablePtr, triggerName, "trigger" );
 }
 
 
-bool TriggerInfo::passMetFilter( const std::string& filterName ) const{
-    return passTriggerOrFilter( individualMetFilterMap, filterName );
+std::size_t TriggerInfo::metFilterIndex( const std::string& filterName ) const{
+    return decisionIndex( _metFilterTablePtr, filterName, "MET filter" );
 }
 
 
-void printAvailableInfo( const std::map< std::string, bool >& decisionMap, const std::string& decisionType ){
-    std::cout << "Available " << decisionType << " :\n";
-    for( const auto& decision : decisionMap ){
-        std::cout << decision.first << "\n";
-    }
+bool TriggerInfo::passTrigger( const std::size_t triggerIndex ) const{
+    return decisionAtIndex( _triggerTablePtr, _individualTriggers, triggerIndex, "trigger" );
+}
+
+
+bool TriggerInfo::passMetFilter( const std::size_t filterIndex ) const{
+    return decisionAtIndex( _metFilterTablePtr, _individualMetFilters, filterIndex, "MET filter" );
+}
+
+
+bool TriggerInfo::passTrigger( const std::string& triggerName ) const{
+    return passTrigger( triggerIndex( triggerName ) );
+}
+
+
+bool TriggerInfo::passMetFilter( const std::string& filterName ) const{
+    return passMetFilter( metFilterIndex( filterName ) );
 }
 
 
 void TriggerInfo::printAvailableIndividualTriggers() const{
-    printAvailableInfo( individualTriggerMap, "triggers" );
+    printAvailableInfo( _triggerTablePtr, "triggers" );
 }
 
 
 void TriggerInfo::printAvailableMetFilters() const{
-    printAvailableInfo( individualMetFilterMap, "MET filters");
+    printAvailableInfo( _metFilterTablePtr, "MET filters");
 }
@@ -0,0 +1,89 @@
+/*
+Opt-in instrumentation of event loops
+Stages (e.g. reading, building events, selection, reweighting) are timed with scoped timers and cut-flow counters can be incremented.
+At the end of the job a summary with the number of events per second, the time spent in every stage and the cut-flow is printed for every sample.
+When the profiler is disabled, timers and counters only check a flag, so they can be left in production code.
+*/
+
+#ifndef EventLoopProfiler_H
+#define EventLoopProfiler_H
+
+//include c++ library classes
+#include <string>
+#include <vector>
+#include <chrono>
+#include <iostream>
+
+
+class EventLoopProfiler {
+
+    public:
+        using clock_type = std::chrono::steady_clock;
+
+        EventLoopProfiler( const bool enabled = false ) : _enabled( enabled ) {}
+
+        bool isEnabled() const{ return _enabled; }
+
+        //register stages and counters once before the event loop, the returned index is used to address them in the loop
+        //registering an existing name returns the index of the existing stage or counter
+        size_t stageIndex( const std::string& );
+        size_t counterIndex( const std::string& );
+
+        //start accumulating the statistics of a new sample
+        void startSample( const std::string& sampleName );
+
+        void addTime( const size_t stage, const clock_type::duration duration ){
+            if( _enabled ) addTimeToCurrentSample( stage, duration );
+        }
+        void count( const size_t counter ){
+            if( _enabled ) incrementCounter( counter );
+        }
+        void countEvent(){
+            if( _enabled ) ++currentSample().numberOfEvents;
+        }
+
+        //print the statistics of all samples
+        void printSummary( std::ostream& os = std::cout ) const;
+
+        //timer adding the time between its construction and destruction to the given stage
+        class ScopedTimer {
+            public:
+                ScopedTimer( EventLoopProfiler& profiler, const size_t stage ) :
+                    _profilerPtr( profiler.isEnabled() ? &profiler : nullptr ), _stage( stage )
+                {
+                    if( _profilerPtr != nullptr ) _start = clock_type::now();
+                }
+                ~ScopedTimer(){
+                    if( _profilerPtr != nullptr ) _profilerPtr->addTimeToCurrentSample( _stage, clock_type::now() - _start );
+                }
+                ScopedTimer( const ScopedTimer& ) = delete;
+                ScopedTimer& operator=( const ScopedTimer& ) = delete;
+
+            private:
+                EventLoopProfiler* _profilerPtr;
+                size_t _stage;
+                clock_type::time_point _start;
+        };
+
+    private:
+        struct SampleStatistics {
+            std::string name;
+            long unsigned numberOfEvents = 0;
+            clock_type::time_point start;
+            clock_type::time_point stop;
+            std::vector< clock_type::duration > stageTimes;
+            std::vector< long unsigned > counts;
+        };
+
+        bool _enabled;
+        std::vector< std::string > _stageNames;
+        std::vector< std::string > _counterNames;
+        std::vector< SampleStatistics > _samples;
+
+        SampleStatistics& currentSample();
+        void addTimeToCurrentSample( const size_t stage, const clock_type::duration );
+        void incrementCounter( const size_t counter );
+        void printSample( std::ostream&, const SampleStatistics& ) const;
+};
+
+#endif
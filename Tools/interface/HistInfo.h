@@ -56,6 +56,9 @@ class HistInfo{
 
         std::string name() const { return fileName; }
         double maxBinCenter() const { return maxBinC; }
+        unsigned numberOfBins() const { return nBins; }
+        double minimum() const { return xMin; }
+        double maximum() const { return xMax; }
 
     private:
         std::string fileName;
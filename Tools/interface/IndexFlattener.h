@@ -3,6 +3,7 @@
 
 
 //include C++ library classes
+#include <cstddef>
 #include <vector>
 #include <map>
 
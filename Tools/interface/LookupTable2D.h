@@ -0,0 +1,82 @@
+/*
+Flat lookup table of one or more values per bin of a two-dimensional binning, such as a scale factor with its variations or a fake-rate map with its varied maps.
+All values of a bin are stored next to each other, so a bin is found once after which the nominal and all varied values are read in a single pass.
+The table is a single contiguous block of doubles, which is either owned by the table or lives in memory owned by another object (e.g. a memory-mapped file).
+Values outside the table range are mapped to the outer bins, as in histogram::contentAtValues.
+The table is immutable after construction, so one table can be shared by all threads of an event loop.
+*/
+
+#ifndef LookupTable2D_H
+#define LookupTable2D_H
+
+//include c++ library classes
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+//include ROOT classes
+#include "TH2.h"
+
+
+class LookupTable2D{
+
+    public:
+        using size_type = std::size_t;
+
+        LookupTable2D() = default;
+
+        //the content of a histogram, followed by the content minus and plus its uncertainty as the down and up variations
+        explicit LookupTable2D( const TH2* );
+
+        //the content of a central histogram followed by the contents of varied histograms, which must have the same binning as the central one
+        LookupTable2D( const TH2* centralHist, const std::vector< const TH2* >& variedHists );
+
+        //view of a block in the layout given by block(), the owner keeps the memory alive
+        LookupTable2D( const double* block, const size_type blockSize, const std::shared_ptr< const void >& owner );
+
+        size_type numberOfBinsX() const{ return _numberOfBinsX; }
+        size_type numberOfBinsY() const{ return _numberOfBinsY; }
+        size_type numberOfValues() const{ return _numberOfValues; }
+        size_type numberOfVariations() const{ return _numberOfValues - 1; }
+        double minXValue() const{ return _xEdges[ 0 ]; }
+        double maxXValue() const{ return _xEdges[ _numberOfBinsX ]; }
+        double minYValue() const{ return _yEdges[ 0 ]; }
+        double maxYValue() const{ return _yEdges[ _numberOfBinsY ]; }
+
+        //bin index in the flattened table, to be reused for the content and its variations
+        size_type findBin( const double valueX, const double valueY ) const;
+
+        //the nominal value followed by the varied values of a bin
+        const double* values( const size_type bin ) const{ return _values + bin*_numberOfValues; }
+        const double* valuesAtValues( const double valueX, const double valueY ) const{ return values( findBin( valueX, valueY ) ); }
+        double value( const size_type bin, const size_type variation ) const{ return _values[ bin*_numberOfValues + variation ]; }
+
+        double content( const size_type bin ) const{ return value( bin, 0 ); }
+        double contentAtValues( const double valueX, const double valueY ) const{ return content( findBin( valueX, valueY ) ); }
+
+        //only meaningful for tables built from a single histogram with its uncertainties
+        double contentDown( const size_type bin ) const{ return value( bin, 1 ); }
+        double contentUp( const size_type bin ) const{ return value( bin, 2 ); }
+
+        //the block consists of the number of bins along x and y, the number of values per bin, the x and y bin edges, and the values of every bin
+        const double* block() const{ return _block; }
+        size_type blockSize() const{ return _blockSize; }
+
+    private:
+        std::shared_ptr< const void > _owner;
+        const double* _block = nullptr;
+        size_type _blockSize = 0;
+
+        size_type _numberOfBinsX = 0;
+        size_type _numberOfBinsY = 0;
+        size_type _numberOfValues = 0;
+        const double* _xEdges = nullptr;
+        const double* _yEdges = nullptr;
+        const double* _values = nullptr;
+
+        //allocate an owned block with the binning of the histogram, the values are filled by the caller
+        std::vector< double >& allocate( const TH2*, const size_type numberOfValues );
+        void setPointers();
+};
+
+#endif
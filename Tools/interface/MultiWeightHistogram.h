@@ -0,0 +1,71 @@
+/*
+Histogram storing a set of weight variations ( e.g. pdf, scale or parton shower variations ) next to the nominal weights in every bin.
+The bin is located once per fill, after which the weights of all variations are added to one contiguous block.
+ROOT histograms of single variations, or of their envelope or RMS, are only made when they are requested for output.
+*/
+
+#ifndef MultiWeightHistogram_H
+#define MultiWeightHistogram_H
+
+//include c++ library classes
+#include <vector>
+#include <string>
+#include <memory>
+#include <utility>
+
+//include other parts of framework
+#include "HistInfo.h"
+
+//include ROOT classes
+#include "TH1D.h"
+
+
+class MultiWeightHistogram {
+
+    public:
+        using size_type = size_t;
+
+        MultiWeightHistogram( const HistInfo&, const size_type numberOfVariations );
+
+        size_type numberOfVariations() const{ return _numberOfVariations; }
+        size_type numberOfBins() const{ return _histInfo.numberOfBins(); }
+
+        //factors multiplying the weights of each variation, e.g. the inverse SampleCrossSections ratios to only keep shape effects
+        //they are applied while filling, so they can be changed when moving to the next sample
+        void setVariationScales( const std::vector< double >& );
+        void resetVariationScales();
+
+        //fill the nominal weight and the relative weights of each variation w.r.t. the nominal weight
+        //values outside of the histogram range end up in the first or last bin, as done by histogram::fillValue
+        //the number of relative weights must equal the number of variations, otherwise std::invalid_argument is thrown
+        void fill( const double value, const double weight, const double* relativeWeights, const size_type numberOfRelativeWeights );
+        void fill( const double value, const double weight, const std::vector< double >& relativeWeights ){ fill( value, weight, relativeWeights.data(), relativeWeights.size() ); }
+
+        std::shared_ptr< TH1D > makeNominalHistogram( const std::string& histName ) const;
+        std::shared_ptr< TH1D > makeVariationHistogram( const size_type variationIndex, const std::string& histName ) const;
+
+        //histograms of all variations, named histName + "_var" + index
+        std::vector< std::shared_ptr< TH1D > > makeVariationHistograms( const std::string& histName ) const;
+
+        //down and up histograms taking the minimum and maximum of the nominal and varied contents in every bin
+        //an empty vector of indices uses all variations, the bin errors are those of the nominal histogram
+        std::pair< std::shared_ptr< TH1D >, std::shared_ptr< TH1D > > makeEnvelopeHistograms( const std::string& histName, const std::vector< size_type >& variationIndices = std::vector< size_type >() ) const;
+
+        //down and up histograms shifting the nominal contents by the RMS of the variations around them in every bin
+        std::pair< std::shared_ptr< TH1D >, std::shared_ptr< TH1D > > makeRMSHistograms( const std::string& histName, const std::vector< size_type >& variationIndices = std::vector< size_type >() ) const;
+
+    private:
+        HistInfo _histInfo;
+        size_type _numberOfVariations;
+        std::vector< double > _variationScales;
+
+        //every bin holds the sum of nominal weights and its squares, followed by the sums of weights and the sums of squared weights of all variations
+        std::vector< double > _bins;
+
+        size_type blockSize() const{ return 2*( _numberOfVariations + 1 ); }
+        size_type binIndex( const double value ) const;
+        std::vector< size_type > variationIndicesOrAll( const std::vector< size_type >& ) const;
+        std::shared_ptr< TH1D > makeHistogram( const std::string& histName, const size_type sumOffset, const size_type sumSquaredOffset ) const;
+};
+
+#endif
@@ -6,6 +6,7 @@ Class used for storing the info related to a particular sample: xSec, process na
 #define Sample_H
 
 //include c++ library classes
+#include <cstdint>
 #include <string>
 #include <vector>
 #include <iostream>
@@ -32,7 +33,7 @@ class Sample{
         std::string processName() const { return _processName; } 
     
         //to prevent overlapping file names when re-using a sample in both the 2016 and 2017 data lists 
-        std::string uniqueName() const { return _uniqueName; }
+        const std::string& uniqueName() const { return _uniqueName; }
 
         double xSec() const { return _xSec; }
 
@@ -46,11 +47,17 @@ class Sample{
         bool isSMSignal() const { return _isSMSignal; }
         bool isNewPhysicsSignal() const { return _isNewPhysicsSignal; }
 
+        std::string filePath() const;
         std::shared_ptr<TFile> filePtr() const;
 
+        //identifier that is shared by copies of a Sample and never reused by another constructed Sample
+        //this allows per-sample caches to detect a change of sample with an integer comparison
+        std::uint64_t identifier() const{ return _identifier; }
+
     private:
         void setIsData(); 
         void setOptions(const std::string&);
+        static std::uint64_t newIdentifier();
 
         std::string _fileName;
         std::string _directory;
@@ -64,6 +71,7 @@ class Sample{
         bool _isSMSignal;
         bool _isNewPhysicsSignal;
 
+        std::uint64_t _identifier = newIdentifier();
 };
 
 //read a txt file containing a list of samples
@@ -2,6 +2,7 @@
 #define SampleCrossSections_H
 
 #include "Sample.h"
+#include "SampleMetadataIndex.h"
 
 
 class SampleCrossSections{
@@ -12,6 +13,9 @@ class SampleCrossSections{
         SampleCrossSections() = default;
 		SampleCrossSections( const Sample& );
 
+        //use the counters stored in a SampleMetadataIndex instead of reading them from the sample file
+        SampleCrossSections( const Sample&, const SampleMetadataIndex& );
+
         size_type numberOfLheVariations() const{ return lheCrossSectionRatios.size(); }
 		double crossSectionRatio_pdfVar( const size_type ) const;
 
@@ -0,0 +1,88 @@
+/*
+Index of the metadata of the files in a sample list: the sums of simulated event weights, the LHE and parton shower counters, the pileup profile, the SUSY mass point counters, the number of entries and which kinds of branches are present.
+The index is written to disk once and reused by later jobs, so the counters do not have to be read from every file again.
+Entries are validated against the size and modification time of their file, and only changed or new files are reopened.
+*/
+
+#ifndef SampleMetadataIndex_H
+#define SampleMetadataIndex_H
+
+//include c++ library classes
+#include <string>
+#include <vector>
+#include <map>
+#include <memory>
+
+//include other parts of framework
+#include "Sample.h"
+
+//include ROOT classes
+#include "TH1D.h"
+
+
+struct SampleMetadata{
+
+    //SUSY mass point with events, at the bin centers of the SUSY counter
+    struct SusyCounterBin{
+        double massNLSP;
+        double massLSP;
+        double sumOfWeights;
+    };
+
+    std::string filePath;
+    long long fileSize = 0;
+    long long modificationTime = 0;
+
+    long long numberOfEntries = 0;
+    double sumOfSimulatedEventWeights = 0.;
+    std::vector< double > lheSumsOfWeights;
+    std::vector< double > psSumsOfWeights;
+    std::vector< double > pileupBinEdges;
+    std::vector< double > pileupContents;
+    std::vector< SusyCounterBin > susyCounterBins;
+
+    bool hasGeneratorInfo = false;
+    bool hasSusyMassInfo = false;
+    bool hasIndividualTriggers = false;
+
+    //check whether the file still has the size and modification time with which the metadata was read
+    bool isUpToDate() const;
+
+    //distribution of the number of true interactions, throws when the file had none
+    std::shared_ptr< TH1D > pileupProfile( const std::string& histName ) const;
+};
+
+
+class SampleMetadataIndex{
+
+    public:
+        using size_type = std::size_t;
+
+        //load the index at the given path, read the metadata of new or changed files in the sample list and rewrite the index if anything changed
+        SampleMetadataIndex( const std::vector< Sample >&, const std::string& indexPath );
+
+        //default location of the index of a sample list
+        static std::string defaultIndexPath( const std::string& sampleListFile ){ return sampleListFile + ".metadata"; }
+
+        //read the metadata of a single file directly from the file
+        static SampleMetadata readMetadata( const std::string& filePath );
+
+        bool contains( const Sample& ) const;
+        const SampleMetadata& metadata( const Sample& ) const;
+        const SampleMetadata* metadataPtr( const Sample& ) const;
+
+        size_type size() const{ return _metadata.size(); }
+
+        //number of files whose metadata was read from the file itself instead of the stored index
+        size_type numberOfReadFiles() const{ return _numberOfReadFiles; }
+
+        void write( const std::string& indexPath ) const;
+
+    private:
+        std::map< std::string, SampleMetadata > _metadata;
+        size_type _numberOfReadFiles = 0;
+
+        static std::map< std::string, SampleMetadata > readIndex( const std::string& indexPath );
+};
+
+#endif
@@ -0,0 +1,65 @@
+/*
+Sparse storage of histograms for every (mass point, systematic, variable) combination of a signal scan.
+Bins are only allocated once a combination is filled for the first time, and are stored in one contiguous buffer.
+ROOT histograms are only made when they are requested for output.
+*/
+
+#ifndef SparseHistogramCollection_H
+#define SparseHistogramCollection_H
+
+//include c++ library classes
+#include <vector>
+#include <string>
+#include <memory>
+#include <unordered_map>
+#include <map>
+
+//include other parts of framework
+#include "HistInfo.h"
+
+//include ROOT classes
+#include "TH1D.h"
+
+
+class SparseHistogramCollection {
+
+    public:
+        using size_type = size_t;
+
+        SparseHistogramCollection( const std::vector< HistInfo >&, const std::vector< std::string >& systematicNames );
+
+        //resolve the index of a systematic once, outside of the event loop
+        size_type systematicIndex( const std::string& ) const;
+        size_type numberOfSystematics() const{ return _systematicNames.size(); }
+        size_type numberOfVariables() const{ return _histInfos.size(); }
+
+        //fill a value, which is bounded to the histogram range in the same way as histogram::fillValue
+        void fill( const size_type massPointIndex, const size_type systematicIndex, const size_type variableIndex, const double value, const double weight );
+
+        //fill all variables at once, the vector of values must be ordered as the HistInfo objects
+        void fill( const size_type massPointIndex, const size_type systematicIndex, const std::vector< double >& values, const double weight );
+
+        bool isFilled( const size_type massPointIndex, const size_type systematicIndex, const size_type variableIndex ) const;
+        std::vector< size_type > filledMassPoints() const;
+
+        //convert the stored bins to a ROOT histogram, unfilled combinations give an empty histogram
+        std::shared_ptr< TH1D > makeHistogram( const size_type massPointIndex, const size_type systematicIndex, const size_type variableIndex, const std::string& histName ) const;
+
+        //number of histograms for which bins were allocated
+        size_type numberOfAllocatedHistograms() const{ return _offsets.size(); }
+
+    private:
+        std::vector< HistInfo > _histInfos;
+        std::vector< std::string > _systematicNames;
+        std::map< std::string, size_type > _systematicIndices;
+
+        //sum of weights and sum of squared weights for each bin are stored next to each other
+        std::unordered_map< size_type, size_type > _offsets;
+        std::vector< double > _bins;
+
+        size_type key( const size_type massPointIndex, const size_type systematicIndex, const size_type variableIndex ) const;
+        size_type binIndex( const size_type variableIndex, const double value ) const;
+        size_type allocate( const size_type key, const size_type variableIndex );
+};
+
+#endif
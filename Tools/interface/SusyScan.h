@@ -6,16 +6,25 @@ Class to collect information about SUSY samples. These samples contain several s
 
 //include c++ library classes 
 #include <map>
+#include <unordered_map>
+#include <vector>
 #include <utility>
+#include <limits>
+#include <cstdint>
 
 //include other parts of code
 #include "Sample.h"
+#include "SampleMetadataIndex.h"
 
 
 
 class SusyScan {
 
     public:
+
+        //index returned by the non-throwing lookup for mass points that are not part of the scan
+        static constexpr size_t invalidIndex = std::numeric_limits< size_t >::max();
+
         SusyScan() = default;
         SusyScan( const double massSplitting );
         SusyScan( const double massSplitting, const double massSplittingHalfWindow );
@@ -27,6 +36,13 @@ class SusyScan {
         size_t numberOfPoints() const;
         size_t index( const double mChi2, const double mChi1 ) const;
 
+        //O(1) lookup which returns SusyScan::invalidIndex instead of throwing for unknown mass points
+        size_t indexOrInvalid( const double mChi2, const double mChi1 ) const;
+        bool containsMassPoint( const double mChi2, const double mChi1 ) const{ return ( indexOrInvalid( mChi2, mChi1 ) != invalidIndex ); }
+
+        //check whether the index lookup uses the dense grid or the hashed fallback for irregular scans
+        bool hasDenseGrid() const{ return !denseGridIndices.empty(); }
+
         std::pair< double, double > masses( const size_t ) const;
         std::string massesString( const size_t ) const;
 
@@ -34,20 +50,41 @@ class SusyScan {
         double sumOfWeights( const size_t ) const;
 
         void addScan( const Sample& sample ){ addMassPoints_Fast( sample ); }
+
+        //add the mass points of a sample from its stored SUSY counter, without opening the sample file
+        void addScan( const Sample&, const SampleMetadataIndex& );
         std::vector< unsigned > massSplittings() const;
 
         bool containsMassSplitting( const double ) const;
 
     private:
-        std::map< std::pair< unsigned, unsigned>, size_t > massesToIndices;
-        std::map< size_t, std::pair< unsigned, unsigned > > indicesToMasses;
-        std::map< size_t, double > indicesToSumOfWeights;
+
+        //indices are assigned contiguously, so the per-index information can be stored in vectors
+        std::unordered_map< std::uint64_t, size_t > massesToIndices;
+        std::vector< std::pair< unsigned, unsigned > > indicesToMasses;
+        std::vector< double > indicesToSumOfWeights;
+
+        //dense lookup table over the regular (NLSP, LSP) grid spanned by the mass points
+        std::vector< size_t > denseGridIndices;
+        unsigned gridMinimumNLSP = 0;
+        unsigned gridMinimumLSP = 0;
+        unsigned gridStepNLSP = 1;
+        unsigned gridStepLSP = 1;
+        unsigned gridSizeNLSP = 0;
+        unsigned gridSizeLSP = 0;
+
         unsigned _massSplitting = 0;
         //unsigned _massSplittingHalfWindow = 0;
         unsigned _minimumMassSplitting = 0;
         unsigned _maximumMassSplitting = 0;
         
         void addMassPoints_Fast( const Sample& );
+        void addMassPoints( const std::vector< SampleMetadata::SusyCounterBin >& );
+
+        //rebuild the dense grid after mass points were added, falls back to the hash map if the grid would be too sparse
+        void buildDenseGrid();
+        size_t lookupIndex( const unsigned massNLSP, const unsigned massLSP ) const;
+        static std::uint64_t massKey( const unsigned massNLSP, const unsigned massLSP ){ return ( ( static_cast< std::uint64_t >( massNLSP ) << 32 ) | massLSP ); }
 
         std::pair< unsigned, unsigned > massesAtIndex( const size_t ) const;
 };
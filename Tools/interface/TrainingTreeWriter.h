@@ -0,0 +1,76 @@
+/*
+Class to write a flat tree of training variables for neural network or BDT training
+The variables are stored in a fixed-order float buffer that is bound to the tree branches once, so filling requires no copies.
+Optionally the entries are also exported to a columnar binary file that can be memory-mapped with python/trainingColumns.py.
+*/
+
+#ifndef TrainingTreeWriter_H
+#define TrainingTreeWriter_H
+
+//include c++ library classes
+#include <vector>
+#include <string>
+#include <map>
+
+//include ROOT classes
+#include "TFile.h"
+#include "TTree.h"
+
+
+class TrainingTreeWriter {
+
+    public:
+
+        //an empty columnar file name disables the columnar export
+        TrainingTreeWriter( const std::string& fileName, const std::string& treeName, const std::vector< std::string >& variableNames, const std::string& columnarFileName = "" );
+        ~TrainingTreeWriter();
+
+        //the writer owns the output file, so it can not be copied
+        TrainingTreeWriter( const TrainingTreeWriter& ) = delete;
+        TrainingTreeWriter& operator=( const TrainingTreeWriter& ) = delete;
+
+        //resolve the buffer index of a variable once, outside of the event loop
+        size_t variableIndex( const std::string& ) const;
+        size_t numberOfVariables() const{ return _variableNames.size(); }
+
+        //access the buffer that is written at the next call to fill
+        float& operator[]( const size_t index ){ return _buffer[ index ]; }
+        float& at( const std::string& variableName ){ return _buffer[ variableIndex( variableName ) ]; }
+
+        void fill();
+        long unsigned numberOfEntries() const{ return _numberOfEntries; }
+
+        //write the tree and the columnar file
+        //this is done automatically at destruction, but errors are then only printed, so call close() to get them as exceptions
+        void close();
+
+    private:
+        std::vector< std::string > _variableNames;
+        std::map< std::string, size_t > _variableIndices;
+        std::vector< float > _buffer;
+        long unsigned _numberOfEntries = 0;
+
+        TFile* _filePtr = nullptr;
+        TTree* _treePtr = nullptr;
+
+        std::string _columnarFileName;
+        std::vector< std::vector< float > > _columns;
+
+        void writeColumnarFile() const;
+};
+
+
+namespace trainingColumns{
+
+    //format identifier at the start of columnar training files
+    const std::string magic = "TRNCOL01";
+
+    //the column data starts at a multiple of this alignment
+    const size_t alignment = 64;
+
+    //read back the variable names and columns of a columnar training file
+    std::vector< std::string > readVariableNames( const std::string& );
+    std::vector< std::vector< float > > readColumns( const std::string& );
+}
+
+#endif
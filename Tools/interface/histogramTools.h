@@ -24,6 +24,10 @@ namespace histogram{
     double minYValue( const TH2* );
     double maxYValue( const TH2* );
 
+    //global bin index corresponding to the given value(s), with under- and overflow mapped to the outer bins
+    int findBinAtValue( TH1*, const double value );
+    int findBinAtValues( TH2*, const double valueX, const double valueY );
+
     double contentAtValue( TH1*, const double value );
     double uncertaintyAtValue( TH1*, const double value );
     double uncertaintyDownAtValue( TH1*, const double value );
@@ -27,6 +27,10 @@ namespace systemTools{
     //check if file exists
     bool fileExists( const std::string& );
 
+    //size in bytes and modification time in nanoseconds since the epoch of a file, used to detect changed files
+    long long fileSize( const std::string& );
+    long long fileModificationTime( const std::string& );
+
     //check if directory exists
     bool directoryExists( const std::string& );
 
@@ -0,0 +1,116 @@
+#include "../interface/EventLoopProfiler.h"
+
+//include c++ library classes
+#include <algorithm>
+#include <iomanip>
+#include <stdexcept>
+
+
+namespace{
+
+    size_t indexOfName( std::vector< std::string >& names, const std::string& name ){
+        auto it = std::find( names.cbegin(), names.cend(), name );
+        if( it != names.cend() ){
+            return static_cast< size_t >( it - names.cbegin() );
+        }
+        names.push_back( name );
+        return names.size() - 1;
+    }
+}
+
+
+size_t EventLoopProfiler::stageIndex( const std::string& stageName ){
+    return indexOfName( _stageNames, stageName );
+}
+
+
+size_t EventLoopProfiler::counterIndex( const std::string& counterName ){
+    return indexOfName( _counterNames, counterName );
+}
+
+
+void EventLoopProfiler::startSample( const std::string& sampleName ){
+    if( !_enabled ) return;
+    clock_type::time_point now = clock_type::now();
+    if( !_samples.empty() ){
+        _samples.back().stop = now;
+    }
+    _samples.push_back( SampleStatistics() );
+    _samples.back().name = sampleName;
+    _samples.back().start = now;
+}
+
+
+EventLoopProfiler::SampleStatistics& EventLoopProfiler::currentSample(){
+
+    //allow the profiler to be used without explicitly starting a sample
+    if( _samples.empty() ){
+        startSample( "unnamed sample" );
+    }
+    return _samples.back();
+}
+
+
+void EventLoopProfiler::addTimeToCurrentSample( const size_t stage, const clock_type::duration duration ){
+    if( stage >= _stageNames.size() ){
+        throw std::out_of_range( "Stage index " + std::to_string( stage ) + " is out of range for " + std::to_string( _stageNames.size() ) + " registered stages." );
+    }
+    SampleStatistics& sample = currentSample();
+    if( sample.stageTimes.size() <= stage ){
+        sample.stageTimes.resize( _stageNames.size(), clock_type::duration::zero() );
+    }
+    sample.stageTimes[ stage ] += duration;
+}
+
+
+void EventLoopProfiler::incrementCounter( const size_t counter ){
+    if( counter >= _counterNames.size() ){
+        throw std::out_of_range( "Counter index " + std::to_string( counter ) + " is out of range for " + std::to_string( _counterNames.size() ) + " registered counters." );
+    }
+    SampleStatistics& sample = currentSample();
+    if( sample.counts.size() <= counter ){
+        sample.counts.resize( _counterNames.size(), 0 );
+    }
+    ++sample.counts[ counter ];
+}
+
+
+namespace{
+
+    double seconds( const EventLoopProfiler::clock_type::duration duration ){
+        return std::chrono::duration< double >( duration ).count();
+    }
+}
+
+
+void EventLoopProfiler::printSample( std::ostream& os, const SampleStatistics& sample ) const{
+    clock_type::time_point stop = ( &sample == &_samples.back() ) ? clock_type::now() : sample.stop;
+    double totalSeconds = seconds( stop - sample.start );
+    os << "sample " << sample.name << " : " << sample.numberOfEvents << " events in " << std::fixed << std::setprecision( 2 ) << totalSeconds << " s";
+    if( totalSeconds > 0 ){
+        os << " (" << sample.numberOfEvents / totalSeconds << " events/s)";
+    }
+    os << "\n";
+    for( size_t s = 0; s < _stageNames.size(); ++s ){
+        double stageSeconds = ( s < sample.stageTimes.size() ) ? seconds( sample.stageTimes[ s ] ) : 0.;
+        os << "    stage " << std::left << std::setw( 25 ) << _stageNames[ s ] << std::right << std::setw( 12 ) << stageSeconds << " s" << std::setw( 8 ) << ( totalSeconds > 0 ? 100*stageSeconds/totalSeconds : 0. ) << " %";
+        if( sample.numberOfEvents > 0 ){
+            os << std::setw( 12 ) << 1e6*stageSeconds/sample.numberOfEvents << " us/event";
+        }
+        os << "\n";
+    }
+    for( size_t c = 0; c < _counterNames.size(); ++c ){
+        os << "    count " << std::left << std::setw( 25 ) << _counterNames[ c ] << std::right << std::setw( 12 ) << ( c < sample.counts.size() ? sample.counts[ c ] : 0 ) << "\n";
+    }
+    os.unsetf( std::ios::floatfield );
+}
+
+
+void EventLoopProfiler::printSummary( std::ostream& os ) const{
+    if( !_enabled ) return;
+    os << "~~~~~~~~~~ event loop profile ~~~~~~~~~~\n";
+    for( const auto& sample : _samples ){
+        printSample( os, sample );
+    }
+    os << std::flush;
+}
@@ -1,5 +1,9 @@
 #include "../interface/IndexFlattener.h"
 
+//include c++ library classes
+#include <stdexcept>
+#include <string>
+
 
 IndexFlattener::IndexFlattener( const std::vector< size_type >& rangeVector ) : ranges( rangeVector )
 {}
@@ -0,0 +1,114 @@
+#include "../interface/LookupTable2D.h"
+
+//include c++ library classes
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+
+namespace{
+
+    std::vector< double > binEdges( const TAxis* axis ){
+        std::vector< double > edges;
+        edges.reserve( axis->GetNbins() + 1 );
+        for( int b = 1; b < axis->GetNbins() + 2; ++b ){
+            edges.push_back( axis->GetBinLowEdge( b ) );
+        }
+        return edges;
+    }
+}
+
+
+LookupTable2D::LookupTable2D( const TH2* histPtr ){
+    std::vector< double >& storage = allocate( histPtr, 3 );
+
+    //the bins are ordered with x varying fastest
+    for( size_type y = 1; y <= _numberOfBinsY; ++y ){
+        for( size_type x = 1; x <= _numberOfBinsX; ++x ){
+            int bin = histPtr->GetBin( x, y );
+            storage.push_back( histPtr->GetBinContent( bin ) );
+            storage.push_back( histPtr->GetBinContent( bin ) - histPtr->GetBinErrorLow( bin ) );
+            storage.push_back( histPtr->GetBinContent( bin ) + histPtr->GetBinErrorUp( bin ) );
+        }
+    }
+    _block = storage.data();
+    _blockSize = storage.size();
+    setPointers();
+}
+
+
+LookupTable2D::LookupTable2D( const TH2* centralHist, const std::vector< const TH2* >& variedHists ){
+    std::vector< double > xEdges = binEdges( centralHist->GetXaxis() );
+    std::vector< double > yEdges = binEdges( centralHist->GetYaxis() );
+    for( const auto histPtr : variedHists ){
+        if( binEdges( histPtr->GetXaxis() ) != xEdges || binEdges( histPtr->GetYaxis() ) != yEdges ){
+            throw std::invalid_argument( "Varied histogram " + std::string( histPtr->GetName() ) + " does not have the same binning as the central histogram " + centralHist->GetName() + "." );
+        }
+    }
+
+    std::vector< double >& storage = allocate( centralHist, 1 + variedHists.size() );
+    for( size_type y = 1; y <= _numberOfBinsY; ++y ){
+        for( size_type x = 1; x <= _numberOfBinsX; ++x ){
+            storage.push_back( centralHist->GetBinContent( x, y ) );
+            for( const auto histPtr : variedHists ){
+                storage.push_back( histPtr->GetBinContent( x, y ) );
+            }
+        }
+    }
+    _block = storage.data();
+    _blockSize = storage.size();
+    setPointers();
+}
+
+
+LookupTable2D::LookupTable2D( const double* block, const size_type blockSize, const std::shared_ptr< const void >& owner ) :
+    _owner( owner ),
+    _block( block ),
+    _blockSize( blockSize )
+{
+    setPointers();
+}
+
+
+std::vector< double >& LookupTable2D::allocate( const TH2* histPtr, const size_type numberOfValues ){
+    std::vector< double > xEdges = binEdges( histPtr->GetXaxis() );
+    std::vector< double > yEdges = binEdges( histPtr->GetYaxis() );
+    _numberOfBinsX = xEdges.size() - 1;
+    _numberOfBinsY = yEdges.size() - 1;
+
+    std::shared_ptr< std::vector< double > > storage = std::make_shared< std::vector< double > >();
+    storage->reserve( 3 + xEdges.size() + yEdges.size() + numberOfValues * _numberOfBinsX * _numberOfBinsY );
+    storage->push_back( _numberOfBinsX );
+    storage->push_back( _numberOfBinsY );
+    storage->push_back( numberOfValues );
+    storage->insert( storage->end(), xEdges.cbegin(), xEdges.cend() );
+    storage->insert( storage->end(), yEdges.cbegin(), yEdges.cend() );
+    _owner = storage;
+    return *storage;
+}
+
+
+void LookupTable2D::setPointers(){
+    if( _blockSize < 3 ){
+        throw std::invalid_argument( "Block of size " + std::to_string( _blockSize ) + " is too small to contain a LookupTable2D." );
+    }
+    _numberOfBinsX = static_cast< size_type >( _block[ 0 ] );
+    _numberOfBinsY = static_cast< size_type >( _block[ 1 ] );
+    _numberOfValues = static_cast< size_type >( _block[ 2 ] );
+    size_type numberOfBins = _numberOfBinsX * _numberOfBinsY;
+    if( numberOfBins == 0 || _numberOfValues == 0 || _blockSize != 3 + ( _numberOfBinsX + 1 ) + ( _numberOfBinsY + 1 ) + _numberOfValues * numberOfBins ){
+        throw std::invalid_argument( "Block of size " + std::to_string( _blockSize ) + " does not match a LookupTable2D of " + std::to_string( _numberOfBinsX ) + " x " + std::to_string( _numberOfBinsY ) + " bins with " + std::to_string( _numberOfValues ) + " values per bin." );
+    }
+    _xEdges = _block + 3;
+    _yEdges = _xEdges + _numberOfBinsX + 1;
+    _values = _yEdges + _numberOfBinsY + 1;
+}
+
+
+LookupTable2D::size_type LookupTable2D::findBin( const double valueX, const double valueY ) const{
+
+    //searching only the inner edges maps under- and overflow to the outer bins
+    size_type x = std::upper_bound( _xEdges + 1, _xEdges + _numberOfBinsX, valueX ) - ( _xEdges + 1 );
+    size_type y = std::upper_bound( _yEdges + 1, _yEdges + _numberOfBinsY, valueY ) - ( _yEdges + 1 );
+    return x + _numberOfBinsX * y;
+}
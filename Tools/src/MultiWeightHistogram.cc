@@ -0,0 +1,149 @@
+#include "../interface/MultiWeightHistogram.h"
+
+//include c++ library classes
+#include <stdexcept>
+#include <cmath>
+#include <algorithm>
+
+
+MultiWeightHistogram::MultiWeightHistogram( const HistInfo& histInfo, const size_type numberOfVariations ) :
+    _histInfo( histInfo ),
+    _numberOfVariations( numberOfVariations ),
+    _variationScales( numberOfVariations, 1. )
+{
+    if( _histInfo.numberOfBins() == 0 || !( _histInfo.maximum() > _histInfo.minimum() ) ){
+        throw std::invalid_argument( "HistInfo '" + _histInfo.name() + "' has an invalid binning." );
+    }
+    _bins.assign( _histInfo.numberOfBins()*blockSize(), 0. );
+}
+
+
+void MultiWeightHistogram::setVariationScales( const std::vector< double >& variationScales ){
+    if( variationScales.size() != _numberOfVariations ){
+        throw std::invalid_argument( "Given " + std::to_string( variationScales.size() ) + " variation scales while there are " + std::to_string( _numberOfVariations ) + " variations." );
+    }
+    _variationScales = variationScales;
+}
+
+
+void MultiWeightHistogram::resetVariationScales(){
+    std::fill( _variationScales.begin(), _variationScales.end(), 1. );
+}
+
+
+MultiWeightHistogram::size_type MultiWeightHistogram::binIndex( const double value ) const{
+    if( !( value > _histInfo.minimum() ) ) return 0;
+    size_type numberOfBins = _histInfo.numberOfBins();
+    size_type bin = static_cast< size_type >( numberOfBins * ( value - _histInfo.minimum() ) / ( _histInfo.maximum() - _histInfo.minimum() ) );
+    return std::min( bin, numberOfBins - 1 );
+}
+
+
+void MultiWeightHistogram::fill( const double value, const double weight, const double* relativeWeights, const size_type numberOfRelativeWeights ){
+    if( numberOfRelativeWeights != _numberOfVariations ){
+        throw std::invalid_argument( "Given " + std::to_string( numberOfRelativeWeights ) + " relative weights while there are " + std::to_string( _numberOfVariations ) + " variations." );
+    }
+    double* block = _bins.data() + binIndex( value )*blockSize();
+    block[ 0 ] += weight;
+    block[ 1 ] += weight*weight;
+
+    double* sums = block + 2;
+    double* sumsSquared = sums + _numberOfVariations;
+    const double* scales = _variationScales.data();
+    for( size_type v = 0; v < _numberOfVariations; ++v ){
+        double variedWeight = weight*relativeWeights[ v ]*scales[ v ];
+        sums[ v ] += variedWeight;
+        sumsSquared[ v ] += variedWeight*variedWeight;
+    }
+}
+
+
+std::shared_ptr< TH1D > MultiWeightHistogram::makeHistogram( const std::string& histName, const size_type sumOffset, const size_type sumSquaredOffset ) const{
+    std::shared_ptr< TH1D > hist = _histInfo.makeHist( histName );
+    for( size_type b = 0; b < _histInfo.numberOfBins(); ++b ){
+        const double* block = _bins.data() + b*blockSize();
+        hist->SetBinContent( b + 1, block[ sumOffset ] );
+        hist->SetBinError( b + 1, std::sqrt( block[ sumSquaredOffset ] ) );
+    }
+    hist->SetEntries( hist->GetEffectiveEntries() );
+    return hist;
+}
+
+
+std::shared_ptr< TH1D > MultiWeightHistogram::makeNominalHistogram( const std::string& histName ) const{
+    return makeHistogram( histName, 0, 1 );
+}
+
+
+std::shared_ptr< TH1D > MultiWeightHistogram::makeVariationHistogram( const size_type variationIndex, const std::string& histName ) const{
+    if( variationIndex >= _numberOfVariations ){
+        throw std::out_of_range( "Variation index " + std::to_string( variationIndex ) + " is out of range for " + std::to_string( _numberOfVariations ) + " variations." );
+    }
+    return makeHistogram( histName, 2 + variationIndex, 2 + _numberOfVariations + variationIndex );
+}
+
+
+std::vector< std::shared_ptr< TH1D > > MultiWeightHistogram::makeVariationHistograms( const std::string& histName ) const{
+    std::vector< std::shared_ptr< TH1D > > histograms;
+    histograms.reserve( _numberOfVariations );
+    for( size_type v = 0; v < _numberOfVariations; ++v ){
+        histograms.push_back( makeVariationHistogram( v, histName + "_var" + std::to_string( v ) ) );
+    }
+    return histograms;
+}
+
+
+std::vector< MultiWeightHistogram::size_type > MultiWeightHistogram::variationIndicesOrAll( const std::vector< size_type >& variationIndices ) const{
+    if( variationIndices.empty() ){
+        std::vector< size_type > allIndices( _numberOfVariations );
+        for( size_type v = 0; v < _numberOfVariations; ++v ){
+            allIndices[ v ] = v;
+        }
+        return allIndices;
+    }
+    for( auto index : variationIndices ){
+        if( index >= _numberOfVariations ){
+            throw std::out_of_range( "Variation index " + std::to_string( index ) + " is out of range for " + std::to_string( _numberOfVariations ) + " variations." );
+        }
+    }
+    return variationIndices;
+}
+
+
+std::pair< std::shared_ptr< TH1D >, std::shared_ptr< TH1D > > MultiWeightHistogram::makeEnvelopeHistograms( const std::string& histName, const std::vector< size_type >& variationIndices ) const{
+    std::vector< size_type > indices = variationIndicesOrAll( variationIndices );
+    std::shared_ptr< TH1D > down = makeNominalHistogram( histName + "Down" );
+    std::shared_ptr< TH1D > up = makeNominalHistogram( histName + "Up" );
+    for( size_type b = 0; b < _histInfo.numberOfBins(); ++b ){
+        const double* block = _bins.data() + b*blockSize();
+        double minimum = block[ 0 ];
+        double maximum = block[ 0 ];
+        for( auto v : indices ){
+            minimum = std::min( minimum, block[ 2 + v ] );
+            maximum = std::max( maximum, block[ 2 + v ] );
+        }
+        down->SetBinContent( b + 1, minimum );
+        up->SetBinContent( b + 1, maximum );
+    }
+    return { down, up };
+}
+
+
+std::pair< std::shared_ptr< TH1D >, std::shared_ptr< TH1D > > MultiWeightHistogram::makeRMSHistograms( const std::string& histName, const std::vector< size_type >& variationIndices ) const{
+    std::vector< size_type > indices = variationIndicesOrAll( variationIndices );
+    std::shared_ptr< TH1D > down = makeNominalHistogram( histName + "Down" );
+    std::shared_ptr< TH1D > up = makeNominalHistogram( histName + "Up" );
+    if( indices.empty() ) return { down, up };
+    for( size_type b = 0; b < _histInfo.numberOfBins(); ++b ){
+        const double* block = _bins.data() + b*blockSize();
+        double sumOfSquaredDifferences = 0.;
+        for( auto v : indices ){
+            double difference = block[ 2 + v ] - block[ 0 ];
+            sumOfSquaredDifferences += difference*difference;
+        }
+        double rms = std::sqrt( sumOfSquaredDifferences/indices.size() );
+        down->SetBinContent( b + 1, block[ 0 ] - rms );
+        up->SetBinContent( b + 1, block[ 0 ] + rms );
+    }
+    return { down, up };
+}
@@ -1,6 +1,7 @@
 #include "../interface/Sample.h"
 
 //include c++ library classes 
+#include <atomic>
 #include <sstream>
 #include <fstream>
 #include <stdexcept>
@@ -182,8 +183,13 @@ void Sample::setOptions( const std::string& optionString ){
 }
 
 
+std::string Sample::filePath() const{
+    return stringTools::formatDirectoryName( _directory ) + _fileName;
+}
+
+
 std::shared_ptr<TFile> Sample::filePtr() const{
-    return std::make_shared<TFile>( ( stringTools::formatDirectoryName( _directory ) + _fileName ).c_str() , "read");
+    return std::make_shared<TFile>( filePath().c_str() , "read");
 }
 
 
@@ -200,6 +206,12 @@ std::ostream& operator<<( std::ostream& os, const Sample& sam ){
 }
 
 
+std::uint64_t Sample::newIdentifier(){
+    static std::atomic< std::uint64_t > nextIdentifier( 1 );
+    return nextIdentifier++;
+}
+
+
 //read a list of samples into a vector 
 std::vector< Sample > readSampleList( const std::string& listFile, const std::string& directory ){
 
@@ -55,6 +55,30 @@ SampleCrossSections::SampleCrossSections( const Sample& sample ){
 }
 
 
+//ratios of the varied sums of weights to the nominal one, up to the first variation without entries
+std::vector< double > crossSectionRatios( const std::vector< double >& variedSumsOfWeights, const double nominalSumOfWeights ){
+    std::vector< double > ratios;
+    for( auto variedSumOfWeights : variedSumsOfWeights ){
+
+        //0 entries indicate that a sample didn't have the respective weights
+        if( variedSumOfWeights < 1e-6 ) break;
+
+        ratios.push_back( variedSumOfWeights / nominalSumOfWeights );
+    }
+    return ratios;
+}
+
+
+SampleCrossSections::SampleCrossSections( const Sample& sample, const SampleMetadataIndex& metadataIndex ){
+    const SampleMetadata& metadata = metadataIndex.metadata( sample );
+    if( metadata.lheSumsOfWeights.empty() || metadata.psSumsOfWeights.empty() ){
+        throw std::invalid_argument( "lheCounter or psCounter is not present in file '" + sample.fileName() + "'." );
+    }
+    lheCrossSectionRatios = crossSectionRatios( metadata.lheSumsOfWeights, metadata.sumOfSimulatedEventWeights );
+    psCrossSectionRatios = crossSectionRatios( metadata.psSumsOfWeights, metadata.sumOfSimulatedEventWeights );
+}
+
+
 double SampleCrossSections::crossSectionRatio_lheVar( const size_type index ) const{
     if( index > lheCrossSectionRatios.size() ){
         throw std::out_of_range( "Requesting lhe cross section variation " + std::to_string( index ) + " while only " + std::to_string( lheCrossSectionRatios.size() ) + " are present." );
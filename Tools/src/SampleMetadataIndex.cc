@@ -0,0 +1,279 @@
+#include "../interface/SampleMetadataIndex.h"
+
+//include c++ library classes
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <stdexcept>
+
+//include other parts of framework
+#include "../interface/systemTools.h"
+#include "../interface/stringTools.h"
+
+//include ROOT classes
+#include "TFile.h"
+#include "TTree.h"
+#include "TH2.h"
+
+
+//version of the index format, indices with another version are rebuilt
+static const std::string indexHeader = "SampleMetadataIndex 1";
+
+
+bool SampleMetadata::isUpToDate() const{
+    if( !systemTools::fileExists( filePath ) ) return false;
+    return ( systemTools::fileSize( filePath ) == fileSize && systemTools::fileModificationTime( filePath ) == modificationTime );
+}
+
+
+std::shared_ptr< TH1D > SampleMetadata::pileupProfile( const std::string& histName ) const{
+    if( pileupContents.empty() || pileupBinEdges.size() != pileupContents.size() + 1 ){
+        throw std::domain_error( "No pileup profile is stored for file '" + filePath + "'." );
+    }
+    std::shared_ptr< TH1D > profile = std::make_shared< TH1D >( histName.c_str(), histName.c_str(), pileupContents.size(), pileupBinEdges.data() );
+    profile->SetDirectory( nullptr );
+    for( std::size_t b = 0; b < pileupContents.size(); ++b ){
+        profile->SetBinContent( b + 1, pileupContents[ b ] );
+    }
+    return profile;
+}
+
+
+namespace{
+
+    std::vector< double > binContents( const TH1* hist ){
+        std::vector< double > contents;
+        if( hist == nullptr ) return contents;
+        contents.reserve( hist->GetNbinsX() );
+        for( int b = 1; b < hist->GetNbinsX() + 1; ++b ){
+            contents.push_back( hist->GetBinContent( b ) );
+        }
+        return contents;
+    }
+}
+
+
+SampleMetadata SampleMetadataIndex::readMetadata( const std::string& filePath ){
+
+    //the size and modification time are taken before reading, so a file changed while reading is reread by the next job
+    SampleMetadata metadata;
+    metadata.filePath = filePath;
+    metadata.fileSize = systemTools::fileSize( filePath );
+    metadata.modificationTime = systemTools::fileModificationTime( filePath );
+
+    std::shared_ptr< TFile > filePtr( TFile::Open( filePath.c_str(), "read" ) );
+    if( filePtr == nullptr || filePtr->IsZombie() ){
+        throw std::invalid_argument( "File '" + filePath + "' can not be opened to read its metadata." );
+    }
+
+    //objects read from the file are owned by it and deleted when it is closed
+    TTree* treePtr = dynamic_cast< TTree* >( filePtr->Get( "blackJackAndHookers/blackJackAndHookersTree" ) );
+    if( treePtr == nullptr ){
+        throw std::invalid_argument( "File '" + filePath + "' does not contain 'blackJackAndHookers/blackJackAndHookersTree'." );
+    }
+    metadata.numberOfEntries = treePtr->GetEntries();
+    for( const auto& branchPtr : *treePtr->GetListOfBranches() ){
+        std::string branchName = branchPtr->GetName();
+        metadata.hasGeneratorInfo = metadata.hasGeneratorInfo || stringTools::stringContains( branchName, "_gen_" );
+        metadata.hasSusyMassInfo = metadata.hasSusyMassInfo || stringTools::stringContains( branchName, "_mChi" );
+        metadata.hasIndividualTriggers = metadata.hasIndividualTriggers || stringTools::stringContains( branchName, "HLT" );
+    }
+
+    //the counters are only present in simulation
+    TH1* hCounter = dynamic_cast< TH1* >( filePtr->Get( "blackJackAndHookers/hCounter" ) );
+    if( hCounter != nullptr ){
+        metadata.sumOfSimulatedEventWeights = hCounter->GetBinContent( 1 );
+    }
+    metadata.lheSumsOfWeights = binContents( dynamic_cast< TH1* >( filePtr->Get( "blackJackAndHookers/lheCounter" ) ) );
+    metadata.psSumsOfWeights = binContents( dynamic_cast< TH1* >( filePtr->Get( "blackJackAndHookers/psCounter" ) ) );
+
+    TH1* pileupMC = dynamic_cast< TH1* >( filePtr->Get( "blackJackAndHookers/nTrueInteractions" ) );
+    if( pileupMC != nullptr ){
+        for( int b = 1; b < pileupMC->GetNbinsX() + 2; ++b ){
+            metadata.pileupBinEdges.push_back( pileupMC->GetBinLowEdge( b ) );
+        }
+        metadata.pileupContents = binContents( pileupMC );
+    }
+
+    //only mass points with events are stored, in the order in which SusyScan loops over the bins
+    TH2* susyCounter = dynamic_cast< TH2* >( filePtr->Get( "blackJackAndHookers/hCounterSUSY" ) );
+    if( susyCounter != nullptr ){
+        for( int xBin = 1; xBin < susyCounter->GetNbinsX() + 1; ++xBin ){
+            for( int yBin = 1; yBin < susyCounter->GetNbinsY() + 1; ++yBin ){
+                double sumOfWeights = susyCounter->GetBinContent( xBin, yBin );
+                if( sumOfWeights > 0 ){
+                    metadata.susyCounterBins.push_back( { susyCounter->GetXaxis()->GetBinCenter( xBin ), susyCounter->GetYaxis()->GetBinCenter( yBin ), sumOfWeights } );
+                }
+            }
+        }
+    }
+    filePtr->Close();
+    return metadata;
+}
+
+
+SampleMetadataIndex::SampleMetadataIndex( const std::vector< Sample >& samples, const std::string& indexPath ){
+    std::map< std::string, SampleMetadata > storedMetadata;
+    if( systemTools::fileExists( indexPath ) ){
+        storedMetadata = readIndex( indexPath );
+    }
+
+    for( const auto& sample : samples ){
+        std::string filePath = sample.filePath();
+        if( _metadata.find( filePath ) != _metadata.cend() ) continue;
+
+        auto it = storedMetadata.find( filePath );
+        if( it != storedMetadata.cend() && it->second.isUpToDate() ){
+            _metadata.insert( *it );
+        } else {
+            _metadata.insert( { filePath, readMetadata( filePath ) } );
+            ++_numberOfReadFiles;
+        }
+    }
+
+    //files that are no longer in the sample list are dropped from the index
+    if( _numberOfReadFiles > 0 || storedMetadata.size() != _metadata.size() ){
+        write( indexPath );
+    }
+}
+
+
+const SampleMetadata* SampleMetadataIndex::metadataPtr( const Sample& sample ) const{
+    auto it = _metadata.find( sample.filePath() );
+    if( it == _metadata.cend() ) return nullptr;
+    return &( it->second );
+}
+
+
+bool SampleMetadataIndex::contains( const Sample& sample ) const{
+    return ( metadataPtr( sample ) != nullptr );
+}
+
+
+const SampleMetadata& SampleMetadataIndex::metadata( const Sample& sample ) const{
+    const SampleMetadata* metadataPointer = metadataPtr( sample );
+    if( metadataPointer == nullptr ){
+        throw std::out_of_range( "File '" + sample.filePath() + "' of sample " + sample.uniqueName() + " is not present in the SampleMetadataIndex." );
+    }
+    return *metadataPointer;
+}
+
+
+namespace{
+
+    void writeValues( std::ostream& os, const std::string& key, const std::vector< double >& values ){
+        os << key << " " << values.size();
+        for( auto value : values ){
+            os << " " << value;
+        }
+        os << "\n";
+    }
+}
+
+
+void SampleMetadataIndex::write( const std::string& indexPath ) const{
+
+    //write to a temporary file first, so other jobs never read a partially written index
+    std::string temporaryPath = systemTools::uniqueFileName( indexPath + ".tmp" );
+    std::ofstream output( temporaryPath, std::ios::trunc );
+    if( !output ){
+        throw std::runtime_error( "Sample metadata index " + temporaryPath + " can not be opened for writing." );
+    }
+    output << std::setprecision( std::numeric_limits< double >::max_digits10 );
+    output << indexHeader << "\n";
+    for( const auto& entry : _metadata ){
+        const SampleMetadata& metadata = entry.second;
+        output << "file " << metadata.filePath << "\n";
+        output << "stamp " << metadata.fileSize << " " << metadata.modificationTime << "\n";
+        output << "entries " << metadata.numberOfEntries << "\n";
+        output << "branches " << metadata.hasGeneratorInfo << " " << metadata.hasSusyMassInfo << " " << metadata.hasIndividualTriggers << "\n";
+        output << "sumOfWeights " << metadata.sumOfSimulatedEventWeights << "\n";
+        writeValues( output, "lhe", metadata.lheSumsOfWeights );
+        writeValues( output, "ps", metadata.psSumsOfWeights );
+        writeValues( output, "pileupEdges", metadata.pileupBinEdges );
+        writeValues( output, "pileupContents", metadata.pileupContents );
+
+        //the SUSY mass points are stored as consecutive ( NLSP mass, LSP mass, sum of weights ) triplets
+        std::vector< double > susyValues;
+        susyValues.reserve( 3*metadata.susyCounterBins.size() );
+        for( const auto& bin : metadata.susyCounterBins ){
+            susyValues.insert( susyValues.end(), { bin.massNLSP, bin.massLSP, bin.sumOfWeights } );
+        }
+        writeValues( output, "susy", susyValues );
+    }
+    output.close();
+    if( !output ){
+        throw std::runtime_error( "Writing sample metadata index " + temporaryPath + " failed." );
+    }
+    if( std::rename( temporaryPath.c_str(), indexPath.c_str() ) != 0 ){
+        throw std::runtime_error( "Sample metadata index " + temporaryPath + " can not be moved to " + indexPath + "." );
+    }
+}
+
+
+namespace{
+
+    bool readValues( std::istream& is, const std::string& key, std::vector< double >& values ){
+        std::string line;
+        if( !std::getline( is, line ) ) return false;
+        std::istringstream lineStream( line );
+        std::string readKey;
+        std::size_t numberOfValues;
+        if( !( lineStream >> readKey >> numberOfValues ) || readKey != key ) return false;
+
+        //every value takes at least two characters, which protects against allocating a corrupted number of values
+        if( 2*numberOfValues > line.size() ) return false;
+        values.resize( numberOfValues );
+        for( auto& value : values ){
+            if( !( lineStream >> value ) ) return false;
+        }
+        return true;
+    }
+
+
+    bool readEntry( std::istream& is, SampleMetadata& metadata ){
+        std::string line;
+        if( !std::getline( is, line ) || !stringTools::stringStartsWith( line, "file " ) ) return false;
+        metadata.filePath = line.substr( 5 );
+
+        std::string key;
+        if( !( is >> key >> metadata.fileSize >> metadata.modificationTime ) || key != "stamp" ) return false;
+        if( !( is >> key >> metadata.numberOfEntries ) || key != "entries" ) return false;
+        if( !( is >> key >> metadata.hasGeneratorInfo >> metadata.hasSusyMassInfo >> metadata.hasIndividualTriggers ) || key != "branches" ) return false;
+        if( !( is >> key >> metadata.sumOfSimulatedEventWeights ) || key != "sumOfWeights" ) return false;
+        is.ignore( std::numeric_limits< std::streamsize >::max(), '\n' );
+        if( !readValues( is, "lhe", metadata.lheSumsOfWeights ) ) return false;
+        if( !readValues( is, "ps", metadata.psSumsOfWeights ) ) return false;
+        if( !readValues( is, "pileupEdges", metadata.pileupBinEdges ) ) return false;
+        if( !readValues( is, "pileupContents", metadata.pileupContents ) ) return false;
+
+        std::vector< double > susyValues;
+        if( !readValues( is, "susy", susyValues ) || susyValues.size() % 3 != 0 ) return false;
+        metadata.susyCounterBins.clear();
+        for( std::size_t i = 0; i < susyValues.size(); i += 3 ){
+            metadata.susyCounterBins.push_back( { susyValues[ i ], susyValues[ i + 1 ], susyValues[ i + 2 ] } );
+        }
+        return true;
+    }
+}
+
+
+//an index that can not be parsed, for instance because it was written with another format version, is rebuilt from the files
+std::map< std::string, SampleMetadata > SampleMetadataIndex::readIndex( const std::string& indexPath ){
+    std::map< std::string, SampleMetadata > storedMetadata;
+    std::ifstream input( indexPath );
+    std::string header;
+    if( !std::getline( input, header ) || header != indexHeader ) return storedMetadata;
+    while( input.peek() != std::ifstream::traits_type::eof() ){
+        SampleMetadata metadata;
+        if( !readEntry( input, metadata ) ){
+            std::cerr << "Warning: sample metadata index " << indexPath << " can not be parsed, it will be rebuilt." << std::endl;
+            return std::map< std::string, SampleMetadata >();
+        }
+        storedMetadata.insert( { metadata.filePath, metadata } );
+    }
+    return storedMetadata;
+}
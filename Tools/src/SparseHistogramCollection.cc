@@ -0,0 +1,112 @@
+#include "../interface/SparseHistogramCollection.h"
+
+//include c++ library classes
+#include <stdexcept>
+#include <set>
+#include <cmath>
+#include <algorithm>
+
+
+SparseHistogramCollection::SparseHistogramCollection( const std::vector< HistInfo >& histInfos, const std::vector< std::string >& systematicNames ) :
+    _histInfos( histInfos ),
+    _systematicNames( systematicNames )
+{
+    for( size_type s = 0; s < _systematicNames.size(); ++s ){
+        if( !_systematicIndices.insert( { _systematicNames[ s ], s } ).second ){
+            throw std::invalid_argument( "Systematic '" + _systematicNames[ s ] + "' is given more than once to SparseHistogramCollection." );
+        }
+    }
+    for( const auto& histInfo : _histInfos ){
+        if( histInfo.numberOfBins() == 0 || !( histInfo.maximum() > histInfo.minimum() ) ){
+            throw std::invalid_argument( "HistInfo '" + histInfo.name() + "' has an invalid binning." );
+        }
+    }
+}
+
+
+SparseHistogramCollection::size_type SparseHistogramCollection::systematicIndex( const std::string& systematicName ) const{
+    auto it = _systematicIndices.find( systematicName );
+    if( it == _systematicIndices.cend() ){
+        throw std::invalid_argument( "Systematic '" + systematicName + "' is not present in SparseHistogramCollection." );
+    }
+    return it->second;
+}
+
+
+SparseHistogramCollection::size_type SparseHistogramCollection::key( const size_type massPointIndex, const size_type systematicIndex, const size_type variableIndex ) const{
+    if( systematicIndex >= _systematicNames.size() ){
+        throw std::out_of_range( "Systematic index " + std::to_string( systematicIndex ) + " is out of range for " + std::to_string( _systematicNames.size() ) + " systematics." );
+    }
+    if( variableIndex >= _histInfos.size() ){
+        throw std::out_of_range( "Variable index " + std::to_string( variableIndex ) + " is out of range for " + std::to_string( _histInfos.size() ) + " variables." );
+    }
+    return ( massPointIndex * _systematicNames.size() + systematicIndex ) * _histInfos.size() + variableIndex;
+}
+
+
+//values outside of the histogram range end up in the first or last bin, as done by histogram::fillValue
+SparseHistogramCollection::size_type SparseHistogramCollection::binIndex( const size_type variableIndex, const double value ) const{
+    const HistInfo& histInfo = _histInfos[ variableIndex ];
+    if( !( value > histInfo.minimum() ) ) return 0;
+    size_type numberOfBins = histInfo.numberOfBins();
+    size_type bin = static_cast< size_type >( numberOfBins * ( value - histInfo.minimum() ) / ( histInfo.maximum() - histInfo.minimum() ) );
+    return std::min( bin, numberOfBins - 1 );
+}
+
+
+SparseHistogramCollection::size_type SparseHistogramCollection::allocate( const size_type histKey, const size_type variableIndex ){
+    auto it = _offsets.find( histKey );
+    if( it != _offsets.cend() ) return it->second;
+    size_type offset = _bins.size();
+    _bins.resize( offset + 2*_histInfos[ variableIndex ].numberOfBins(), 0. );
+    _offsets.insert( { histKey, offset } );
+    return offset;
+}
+
+
+void SparseHistogramCollection::fill( const size_type massPointIndex, const size_type systematicIndex, const size_type variableIndex, const double value, const double weight ){
+    size_type offset = allocate( key( massPointIndex, systematicIndex, variableIndex ), variableIndex );
+    size_type bin = offset + 2*binIndex( variableIndex, value );
+    _bins[ bin ] += weight;
+    _bins[ bin + 1 ] += weight*weight;
+}
+
+
+void SparseHistogramCollection::fill( const size_type massPointIndex, const size_type systematicIndex, const std::vector< double >& values, const double weight ){
+    if( values.size() != _histInfos.size() ){
+        throw std::invalid_argument( "Given " + std::to_string( values.size() ) + " values to fill while there are " + std::to_string( _histInfos.size() ) + " variables." );
+    }
+    for( size_type v = 0; v < values.size(); ++v ){
+        fill( massPointIndex, systematicIndex, v, values[ v ], weight );
+    }
+}
+
+
+bool SparseHistogramCollection::isFilled( const size_type massPointIndex, const size_type systematicIndex, const size_type variableIndex ) const{
+    return ( _offsets.find( key( massPointIndex, systematicIndex, variableIndex ) ) != _offsets.cend() );
+}
+
+
+std::vector< SparseHistogramCollection::size_type > SparseHistogramCollection::filledMassPoints() const{
+    std::set< size_type > massPoints;
+    const size_type histogramsPerMassPoint = _systematicNames.size() * _histInfos.size();
+    for( const auto& entry : _offsets ){
+        massPoints.insert( entry.first / histogramsPerMassPoint );
+    }
+    return std::vector< size_type >( massPoints.cbegin(), massPoints.cend() );
+}
+
+
+std::shared_ptr< TH1D > SparseHistogramCollection::makeHistogram( const size_type massPointIndex, const size_type systematicIndex, const size_type variableIndex, const std::string& histName ) const{
+    auto it = _offsets.find( key( massPointIndex, systematicIndex, variableIndex ) );
+    std::shared_ptr< TH1D > hist = _histInfos[ variableIndex ].makeHist( histName );
+    if( it == _offsets.cend() ) return hist;
+
+    size_type offset = it->second;
+    for( size_type b = 0; b < _histInfos[ variableIndex ].numberOfBins(); ++b ){
+        hist->SetBinContent( b + 1, _bins[ offset + 2*b ] );
+        hist->SetBinError( b + 1, std::sqrt( _bins[ offset + 2*b + 1 ] ) );
+    }
+    hist->SetEntries( hist->GetEffectiveEntries() );
+    return hist;
+}
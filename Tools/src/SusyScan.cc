@@ -7,11 +7,17 @@
 
 //include c++ library classes 
 #include <cmath>
+#include <set>
+#include <algorithm>
 
 //import ROOT classes 
 #include "TH2D.h"
 
 
+//out-of-class definition needed when invalidIndex is bound to a reference
+constexpr size_t SusyScan::invalidIndex;
+
+
 SusyScan::SusyScan( const double massSplitting ) :
     _massSplitting( numeric::floatToUnsigned( massSplitting ) )
 {}
@@ -41,11 +47,18 @@ SusyScan::SusyScan( const Sample& sample, const double minimumMassSplitting, con
 SusyScan::SusyScan( const Sample& sample ) : SusyScan( sample, 0 ) {}
 
 
-void SusyScan::addMassPoints_Fast( const Sample& sample ){
+namespace{
 
-    if( ! analysisTools::sampleIsSusy( sample.fileName() ) ){
-        throw std::invalid_argument( "Given Sample " + sample.uniqueName() + " does not correspond to a SUSY scan, so a SusyScan object can not be instantiated." );
+    void checkSampleIsSusy( const Sample& sample ){
+        if( ! analysisTools::sampleIsSusy( sample.fileName() ) ){
+            throw std::invalid_argument( "Given Sample " + sample.uniqueName() + " does not correspond to a SUSY scan, so a SusyScan object can not be instantiated." );
+        }
     }
+}
+
+
+void SusyScan::addMassPoints_Fast( const Sample& sample ){
+    checkSampleIsSusy( sample );
 
     std::shared_ptr< TFile > file( sample.filePtr() );
 
@@ -54,71 +67,164 @@ void SusyScan::addMassPoints_Fast( const Sample& sample ){
 
     //WARNING: the following code makes some assumptions about the binning (make sure this is in sync with : https://github.com/GhentAnalysis/heavyNeutrino/blob/master/multilep/src/SUSYMassAnalyzer.cc)
     //The assumption in what follows is that bin centers are integer values, if this is not the case, the code will not work!
+    std::vector< SampleMetadata::SusyCounterBin > counterBins;
+    for( int xBin = 1; xBin < susyCounter->GetNbinsX() + 1; ++xBin ){
+        double xCenter = susyCounter->GetXaxis()->GetBinCenter( xBin );
+        for( int yBin = 1; yBin < susyCounter->GetNbinsY() + 1; ++yBin ){
+            double yCenter = susyCounter->GetYaxis()->GetBinCenter( yBin );
+            counterBins.push_back( { xCenter, yCenter, susyCounter->GetBinContent( xBin, yBin ) } );
+        }
+    }
+    addMassPoints( counterBins );
+}
+
+
+void SusyScan::addScan( const Sample& sample, const SampleMetadataIndex& metadataIndex ){
+    checkSampleIsSusy( sample );
+    addMassPoints( metadataIndex.metadata( sample ).susyCounterBins );
+}
+
+
+void SusyScan::addMassPoints( const std::vector< SampleMetadata::SusyCounterBin >& counterBins ){
 
     //internal index for keeping track of mass points 
     //start the index at the current amount of mass points so several scans can be combined
     size_t pointIndex = numberOfPoints();
 
     //loop over all bins, extract the mass point for each and check if there are events
-    for( int xBin = 1; xBin < susyCounter->GetNbinsX() + 1; ++xBin ){
-        double xCenter = susyCounter->GetXaxis()->GetBinCenter( xBin );
-        unsigned massNLSP = numeric::floatToUnsigned( xCenter );
-        for( int yBin = 1; yBin < susyCounter->GetNbinsY() + 1; ++yBin ){
-            double yCenter = susyCounter->GetYaxis()->GetBinCenter( yBin );
-            unsigned massLSP = numeric::floatToUnsigned( yCenter );
+    for( const auto& counterBin : counterBins ){
+        unsigned massNLSP = numeric::floatToUnsigned( counterBin.massNLSP );
+        unsigned massLSP = numeric::floatToUnsigned( counterBin.massLSP );
 
-            //consider 1 GeV LSP as massless to avoid having separate mass splittings that are 1 GeV apart
-            if( massLSP == 1 ){
-                massLSP = 0;
-            }
+        //consider 1 GeV LSP as massless to avoid having separate mass splittings that are 1 GeV apart
+        if( massLSP == 1 ){
+            massLSP = 0;
+        }
 
-            //LSP mass can not be higher than NLSP mass
-            if( massLSP > massNLSP ) continue;
+        //LSP mass can not be higher than NLSP mass
+        if( massLSP > massNLSP ) continue;
 
-            //if a particular mass-splitting was required, only allow points at this splitting
-            unsigned deltaM = ( massNLSP - massLSP );
-            if( _massSplitting != 0 && deltaM != _massSplitting ) continue;
-            if( _minimumMassSplitting != 0 || _maximumMassSplitting != 0 ){
-                if( deltaM < _minimumMassSplitting || deltaM > _maximumMassSplitting ) continue;
-            }
+        //if a particular mass-splitting was required, only allow points at this splitting
+        unsigned deltaM = ( massNLSP - massLSP );
+        if( _massSplitting != 0 && deltaM != _massSplitting ) continue;
+        if( _minimumMassSplitting != 0 || _maximumMassSplitting != 0 ){
+            if( deltaM < _minimumMassSplitting || deltaM > _maximumMassSplitting ) continue;
+        }
 
-            double sumOfWeights = susyCounter->GetBinContent( xBin, yBin );
+        double sumOfWeights = counterBin.sumOfWeights;
 
-            //if there are any events for this mass point, add it to the collection
-            if( sumOfWeights > 0 ){
+        //if there are any events for this mass point, add it to the collection
+        if( sumOfWeights > 0 ){
 
-                //check if the mass-point is present
-                std::pair< unsigned, unsigned > massPair( massNLSP, massLSP );
-        
-                //not yet present
-                if( massesToIndices.find( massPair ) == massesToIndices.cend() ){
-                    massesToIndices[ massPair ] = pointIndex;
-                    indicesToMasses[ pointIndex ] = massPair;
-                    indicesToSumOfWeights[ pointIndex ] = sumOfWeights;
+            //check if the mass-point is present
+            std::pair< unsigned, unsigned > massPair( massNLSP, massLSP );
+    
+            //not yet present
+            auto indexIt = massesToIndices.find( massKey( massNLSP, massLSP ) );
+            if( indexIt == massesToIndices.cend() ){
+                massesToIndices[ massKey( massNLSP, massLSP ) ] = pointIndex;
+                indicesToMasses.push_back( massPair );
+                indicesToSumOfWeights.push_back( sumOfWeights );
 
-                    //next point
-                    ++pointIndex;
+                //next point
+                ++pointIndex;
 
-                //already present
-                } else {
+            //already present
+            } else {
 
-                    //maps don't have to be modified in this case, only the sum of weights
-                    //warning, you can't use pointIndex as the index here, that would be a bug
-                    indicesToSumOfWeights[ massesToIndices[ massPair ] ] += sumOfWeights;
-                }
+                //maps don't have to be modified in this case, only the sum of weights
+                //warning, you can't use pointIndex as the index here, that would be a bug
+                indicesToSumOfWeights[ indexIt->second ] += sumOfWeights;
             }
         }
     }
+
+    //the grid has to be rebuilt since the new points can change its boundaries and spacing
+    buildDenseGrid();
+}
+
+
+namespace{
+
+    unsigned greatestCommonDivisor( unsigned lhs, unsigned rhs ){
+        while( rhs != 0 ){
+            unsigned remainder = lhs % rhs;
+            lhs = rhs;
+            rhs = remainder;
+        }
+        return lhs;
+    }
+}
+
+
+void SusyScan::buildDenseGrid(){
+    denseGridIndices.clear();
+    if( indicesToMasses.empty() ) return;
+
+    //determine the boundaries of the grid 
+    unsigned maximumNLSP = 0;
+    unsigned maximumLSP = 0;
+    gridMinimumNLSP = std::numeric_limits< unsigned >::max();
+    gridMinimumLSP = std::numeric_limits< unsigned >::max();
+    for( const auto& massPair : indicesToMasses ){
+        gridMinimumNLSP = std::min( gridMinimumNLSP, massPair.first );
+        gridMinimumLSP = std::min( gridMinimumLSP, massPair.second );
+        maximumNLSP = std::max( maximumNLSP, massPair.first );
+        maximumLSP = std::max( maximumLSP, massPair.second );
+    }
+
+    //the grid spacing is the greatest common divisor of all distances to the lowest mass
+    unsigned stepNLSP = 0;
+    unsigned stepLSP = 0;
+    for( const auto& massPair : indicesToMasses ){
+        stepNLSP = greatestCommonDivisor( stepNLSP, massPair.first - gridMinimumNLSP );
+        stepLSP = greatestCommonDivisor( stepLSP, massPair.second - gridMinimumLSP );
+    }
+    gridStepNLSP = std::max( stepNLSP, 1u );
+    gridStepLSP = std::max( stepLSP, 1u );
+    gridSizeNLSP = ( maximumNLSP - gridMinimumNLSP ) / gridStepNLSP + 1;
+    gridSizeLSP = ( maximumLSP - gridMinimumLSP ) / gridStepLSP + 1;
+
+    //scans are usually triangular, but if the grid is much larger than the number of points (e.g. when combining irregular scans) the hash map is used instead 
+    const size_t maximumGridSize = std::max( static_cast< size_t >( 8*numberOfPoints() ), static_cast< size_t >( 4096 ) );
+    size_t gridSize = static_cast< size_t >( gridSizeNLSP ) * gridSizeLSP;
+    if( gridSize > maximumGridSize ) return;
+
+    denseGridIndices.assign( gridSize, invalidIndex );
+    for( size_t pointIndex = 0; pointIndex < indicesToMasses.size(); ++pointIndex ){
+        const auto& massPair = indicesToMasses[ pointIndex ];
+        size_t gridIndex = static_cast< size_t >( ( massPair.first - gridMinimumNLSP ) / gridStepNLSP ) * gridSizeLSP + ( massPair.second - gridMinimumLSP ) / gridStepLSP;
+        denseGridIndices[ gridIndex ] = pointIndex;
+    }
+}
+
+
+size_t SusyScan::lookupIndex( const unsigned massNLSP, const unsigned massLSP ) const{
+
+    //hash map fallback for irregular scans
+    if( denseGridIndices.empty() ){
+        auto it = massesToIndices.find( massKey( massNLSP, massLSP ) );
+        return ( it == massesToIndices.cend() ) ? invalidIndex : it->second;
+    }
+
+    //masses outside of the grid or in between grid points do not correspond to a point of the scan 
+    if( massNLSP < gridMinimumNLSP || massLSP < gridMinimumLSP ) return invalidIndex;
+    unsigned distanceNLSP = massNLSP - gridMinimumNLSP;
+    unsigned distanceLSP = massLSP - gridMinimumLSP;
+    if( ( distanceNLSP % gridStepNLSP ) != 0 || ( distanceLSP % gridStepLSP ) != 0 ) return invalidIndex;
+    unsigned binNLSP = distanceNLSP / gridStepNLSP;
+    unsigned binLSP = distanceLSP / gridStepLSP;
+    if( binNLSP >= gridSizeNLSP || binLSP >= gridSizeLSP ) return invalidIndex;
+    return denseGridIndices[ static_cast< size_t >( binNLSP ) * gridSizeLSP + binLSP ];
 }
 
 
 
 std::pair< unsigned, unsigned > SusyScan::massesAtIndex( const size_t pointIndex ) const{
-    auto it = indicesToMasses.find( pointIndex );
-    if( it == indicesToMasses.cend() ){
+    if( pointIndex >= indicesToMasses.size() ){
         throw std::invalid_argument( "Index " + std::to_string( pointIndex ) + " does not correspond to any masses." );
     } else {
-        return it->second;
+        return indicesToMasses[ pointIndex ];
     }
 }
 
@@ -139,16 +245,21 @@ std::string SusyScan::massesString( const size_t pointIndex ) const{
 
 
 size_t SusyScan::numberOfPoints() const{
-    return massesToIndices.size();
+    return indicesToMasses.size();
+}
+
+
+size_t SusyScan::indexOrInvalid( const double mChi2, const double mChi1 ) const{
+    return lookupIndex( numeric::floatToUnsigned( mChi2 ), numeric::floatToUnsigned( mChi1 ) );
 }
 
 
 size_t SusyScan::index( const double mChi2, const double mChi1 ) const{
-    auto it = massesToIndices.find( { numeric::floatToUnsigned( mChi2 ), numeric::floatToUnsigned( mChi1 ) } );
-    if( it == massesToIndices.cend() ){
+    size_t pointIndex = indexOrInvalid( mChi2, mChi1 );
+    if( pointIndex == invalidIndex ){
         throw std::invalid_argument( "Mass point " + std::to_string( mChi2 ) + "/" + std::to_string( mChi1 ) + " is unknown and does not correspond to an index." );
     } else {
-        return it->second;
+        return pointIndex;
     }
 }
 
@@ -160,11 +271,10 @@ double SusyScan::sumOfWeights( const double mChi2, const double mChi1 ) const{
 
 
 double SusyScan::sumOfWeights( const size_t index ) const{
-    auto it = indicesToSumOfWeights.find( index );
-    if( it== indicesToSumOfWeights.cend() ){
+    if( index >= indicesToSumOfWeights.size() ){
         throw std::invalid_argument( "Index " + std::to_string( index ) + " does not correspond to any known mass point." );
     } else {
-        return it->second;
+        return indicesToSumOfWeights[ index ];
     }
 }
 
@@ -0,0 +1,185 @@
+#include "../interface/TrainingTreeWriter.h"
+
+//include c++ library classes
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <cstdint>
+
+
+TrainingTreeWriter::TrainingTreeWriter( const std::string& fileName, const std::string& treeName, const std::vector< std::string >& variableNames, const std::string& columnarFileName ) :
+    _variableNames( variableNames ),
+    _buffer( variableNames.size(), 0. ),
+    _columnarFileName( columnarFileName )
+{
+    for( size_t v = 0; v < _variableNames.size(); ++v ){
+        if( !_variableIndices.insert( { _variableNames[ v ], v } ).second ){
+            throw std::invalid_argument( "Variable '" + _variableNames[ v ] + "' is given more than once to TrainingTreeWriter." );
+        }
+    }
+
+    _filePtr = TFile::Open( fileName.c_str(), "RECREATE" );
+    if( _filePtr == nullptr || _filePtr->IsZombie() ){
+        throw std::runtime_error( "Can not open file '" + fileName + "' to write training tree." );
+    }
+
+    //the buffer is never resized, so the branch addresses stay valid
+    _treePtr = new TTree( treeName.c_str(), treeName.c_str() );
+    for( size_t v = 0; v < _variableNames.size(); ++v ){
+        _treePtr->Branch( _variableNames[ v ].c_str(), &_buffer[ v ], ( _variableNames[ v ] + "/F" ).c_str() );
+    }
+
+    if( !_columnarFileName.empty() ){
+        _columns = std::vector< std::vector< float > >( _variableNames.size() );
+    }
+}
+
+
+TrainingTreeWriter::~TrainingTreeWriter(){
+
+    //a destructor must not throw, so write errors can only be reported here
+    try{
+        close();
+    } catch( const std::exception& error ){
+        std::cerr << "Error in TrainingTreeWriter destructor : " << error.what() << std::endl;
+    }
+}
+
+
+size_t TrainingTreeWriter::variableIndex( const std::string& variableName ) const{
+    auto it = _variableIndices.find( variableName );
+    if( it == _variableIndices.cend() ){
+        throw std::invalid_argument( "Variable '" + variableName + "' is not present in TrainingTreeWriter." );
+    }
+    return it->second;
+}
+
+
+void TrainingTreeWriter::fill(){
+    if( _filePtr == nullptr ){
+        throw std::logic_error( "Trying to fill TrainingTreeWriter after it was closed." );
+    }
+    _treePtr->Fill();
+    for( size_t v = 0; v < _columns.size(); ++v ){
+        _columns[ v ].push_back( _buffer[ v ] );
+    }
+    ++_numberOfEntries;
+}
+
+
+void TrainingTreeWriter::close(){
+    if( _filePtr == nullptr ) return;
+
+    //the tree is owned by the file and is deleted when it is closed
+    _filePtr->cd();
+    _treePtr->Write( "", TObject::kOverwrite );
+    _filePtr->Close();
+    delete _filePtr;
+    _filePtr = nullptr;
+    _treePtr = nullptr;
+
+    if( !_columnarFileName.empty() ){
+        writeColumnarFile();
+        _columns.clear();
+    }
+}
+
+
+namespace{
+
+    void writeUnsigned( std::ostream& stream, const std::uint64_t value ){
+        stream.write( reinterpret_cast< const char* >( &value ), sizeof( std::uint64_t ) );
+    }
+
+
+    std::uint64_t readUnsigned( std::istream& stream ){
+        std::uint64_t value;
+        stream.read( reinterpret_cast< char* >( &value ), sizeof( std::uint64_t ) );
+        return value;
+    }
+}
+
+
+//layout : magic, number of variables, number of entries, offset of the column data, null-terminated variable names, padding, float32 columns
+void TrainingTreeWriter::writeColumnarFile() const{
+    std::ofstream columnarFile( _columnarFileName, std::ios::binary | std::ios::trunc );
+    if( !columnarFile.is_open() ){
+        throw std::runtime_error( "Can not open file '" + _columnarFileName + "' to write training columns." );
+    }
+
+    size_t headerSize = trainingColumns::magic.size() + 3*sizeof( std::uint64_t );
+    for( const auto& name : _variableNames ){
+        headerSize += name.size() + 1;
+    }
+    size_t dataOffset = ( ( headerSize + trainingColumns::alignment - 1 ) / trainingColumns::alignment ) * trainingColumns::alignment;
+
+    columnarFile.write( trainingColumns::magic.c_str(), trainingColumns::magic.size() );
+    writeUnsigned( columnarFile, _variableNames.size() );
+    writeUnsigned( columnarFile, _numberOfEntries );
+    writeUnsigned( columnarFile, dataOffset );
+    for( const auto& name : _variableNames ){
+        columnarFile.write( name.c_str(), name.size() + 1 );
+    }
+    std::string padding( dataOffset - headerSize, '\0' );
+    columnarFile.write( padding.c_str(), padding.size() );
+
+    for( const auto& column : _columns ){
+        columnarFile.write( reinterpret_cast< const char* >( column.data() ), column.size()*sizeof( float ) );
+    }
+    if( !columnarFile ){
+        throw std::runtime_error( "Writing training columns to '" + _columnarFileName + "' failed." );
+    }
+}
+
+
+namespace{
+
+    std::ifstream openColumnarFile( const std::string& fileName, std::uint64_t& numberOfVariables, std::uint64_t& numberOfEntries, std::uint64_t& dataOffset, std::vector< std::string >& variableNames ){
+        std::ifstream columnarFile( fileName, std::ios::binary );
+        if( !columnarFile.is_open() ){
+            throw std::runtime_error( "Can not open columnar training file '" + fileName + "'." );
+        }
+        std::string magic( trainingColumns::magic.size(), '\0' );
+        columnarFile.read( &magic[0], magic.size() );
+        if( magic != trainingColumns::magic ){
+            throw std::runtime_error( "File '" + fileName + "' is not a columnar training file." );
+        }
+        numberOfVariables = readUnsigned( columnarFile );
+        numberOfEntries = readUnsigned( columnarFile );
+        dataOffset = readUnsigned( columnarFile );
+        variableNames.clear();
+        for( std::uint64_t v = 0; v < numberOfVariables; ++v ){
+            std::string name;
+            std::getline( columnarFile, name, '\0' );
+            variableNames.push_back( name );
+        }
+        if( !columnarFile ){
+            throw std::runtime_error( "Header of columnar training file '" + fileName + "' is corrupted." );
+        }
+        return columnarFile;
+    }
+}
+
+
+std::vector< std::string > trainingColumns::readVariableNames( const std::string& fileName ){
+    std::uint64_t numberOfVariables, numberOfEntries, dataOffset;
+    std::vector< std::string > variableNames;
+    openColumnarFile( fileName, numberOfVariables, numberOfEntries, dataOffset, variableNames );
+    return variableNames;
+}
+
+
+std::vector< std::vector< float > > trainingColumns::readColumns( const std::string& fileName ){
+    std::uint64_t numberOfVariables, numberOfEntries, dataOffset;
+    std::vector< std::string > variableNames;
+    std::ifstream columnarFile = openColumnarFile( fileName, numberOfVariables, numberOfEntries, dataOffset, variableNames );
+    columnarFile.seekg( dataOffset );
+    std::vector< std::vector< float > > columns( numberOfVariables, std::vector< float >( numberOfEntries ) );
+    for( auto& column : columns ){
+        columnarFile.read( reinterpret_cast< char* >( column.data() ), column.size()*sizeof( float ) );
+    }
+    if( !columnarFile ){
+        throw std::runtime_error( "Columnar training file '" + fileName + "' is truncated." );
+    }
+    return columns;
+}
@@ -80,6 +80,16 @@ double boundedYValue( const TH2* histPtr, double yValue ){
 }
 
 
+int histogram::findBinAtValue( TH1* histPtr, const double value ){
+    return histPtr->FindBin( boundedValue( histPtr, value ) );
+}
+
+
+int histogram::findBinAtValues( TH2* histPtr, const double valueX, const double valueY ){
+    return histPtr->FindBin( boundedXValue( histPtr, valueX ), boundedYValue( histPtr, valueY ) );
+}
+
+
 double histogram::contentAtValue( TH1* histPtr, const double value ){
     return histPtr->GetBinContent( histPtr->FindBin( boundedValue( histPtr, value ) ) );
 }
@@ -1,5 +1,8 @@
 #include "../interface/mergeAndRemoveOverlap.h"
 
+//include c++ library classes
+#include <set>
+
 //include ROOT classes 
 #include "TFile.h"
 
@@ -8,6 +8,8 @@
 #include <chrono>
 #include <thread>
 #include <cstdlib>
+#include <stdexcept>
+#include <sys/stat.h>
 
 //include other parts of code 
 #include "../interface/stringTools.h"
@@ -48,6 +50,29 @@ bool systemTools::fileExists( const std::string& fileName ){
 }
 
 
+namespace{
+
+    struct stat fileStatus( const std::string& fileName ){
+        struct stat status;
+        if( stat( fileName.c_str(), &status ) != 0 ){
+            throw std::invalid_argument( "File '" + fileName + "' does not exist or can not be accessed." );
+        }
+        return status;
+    }
+}
+
+
+long long systemTools::fileSize( const std::string& fileName ){
+    return static_cast< long long >( fileStatus( fileName ).st_size );
+}
+
+
+long long systemTools::fileModificationTime( const std::string& fileName ){
+    struct stat status = fileStatus( fileName );
+    return static_cast< long long >( status.st_mtim.tv_sec )*1000000000LL + status.st_mtim.tv_nsec;
+}
+
+
 //check if file name is already in use, and return a randomized filename if it is 
 std::string systemTools::uniqueFileName( const std::string& fileName ){
 
@@ -0,0 +1,61 @@
+/*
+Classification of the branches of a tree schema
+The branch names are scanned once for every distinct schema, after which the presence of generator and SUSY mass branches and the names of the individual triggers and MET filters are looked up directly.
+Trees with the same branches in the same order are recognized by a hash of their branch names, so samples sharing a schema share one index.
+*/
+
+#ifndef BranchIndex_H
+#define BranchIndex_H
+
+//include c++ library classes
+#include <string>
+#include <vector>
+#include <unordered_set>
+#include <cstdint>
+
+//include ROOT classes
+#include "TTree.h"
+
+
+class BranchIndex {
+
+    public:
+        using size_type = std::vector< std::string >::size_type;
+
+        explicit BranchIndex( TTree* );
+
+        //hash of the names of all branches of a tree, in their order in the tree
+        static std::uint64_t schemaHash( TTree* );
+        std::uint64_t hash() const{ return _hash; }
+
+        //check whether a tree has exactly the branches of this index
+        bool matches( TTree* ) const;
+
+        size_type numberOfBranches() const{ return _branchNames.size(); }
+        const std::vector< std::string >& branchNames() const{ return _branchNames; }
+
+        //exact lookup of a branch name
+        bool contains( const std::string& branchName ) const{ return ( _branchNameSet.find( branchName ) != _branchNameSet.cend() ); }
+
+        //check whether any branch name contains the given string, complete branch names are resolved without scanning the branches
+        bool containsSubstring( const std::string& ) const;
+
+        bool hasGeneratorInfo() const{ return _hasGeneratorInfo; }
+        bool hasSusyMassInfo() const{ return _hasSusyMassInfo; }
+
+        //names of the branches with individual trigger and MET filter decisions
+        const std::vector< std::string >& triggerNames() const{ return _triggerNames; }
+        const std::vector< std::string >& metFilterNames() const{ return _metFilterNames; }
+
+    private:
+        std::vector< std::string > _branchNames;
+        std::unordered_set< std::string > _branchNameSet;
+        std::uint64_t _hash;
+
+        bool _hasGeneratorInfo = false;
+        bool _hasSusyMassInfo = false;
+        std::vector< std::string > _triggerNames;
+        std::vector< std::string > _metFilterNames;
+};
+
+#endif
@@ -0,0 +1,44 @@
+/*
+Individually stored trigger or MET filter decisions of a sample
+The names are resolved to indices once per sample, after which the decisions of an event are stored as a fixed-size bitset.
+Checking a decision of an event is then a single bit test, and copying the decisions of an event does not allocate memory.
+*/
+
+#ifndef DecisionTable_H
+#define DecisionTable_H
+
+//include c++ library classes
+#include <bitset>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <cstddef>
+
+
+class DecisionTable {
+
+    public:
+        static constexpr std::size_t maximumNumberOfDecisions = 1024;
+        using bitset_type = std::bitset< maximumNumberOfDecisions >;
+
+        //the table points to the values of the map, which must be the map holding the branch buffers of the decisions
+        DecisionTable( const std::map< std::string, bool >& decisionMap );
+
+        std::size_t size() const{ return _names.size(); }
+        const std::vector< std::string >& names() const{ return _names; }
+
+        //names are given without the leading '_' of the branch names
+        bool contains( const std::string& name ) const{ return ( _indices.find( name ) != _indices.cend() ); }
+        std::size_t index( const std::string& name ) const;
+
+        //pack the decisions currently in the branch buffers
+        bitset_type decisions() const;
+
+    private:
+        std::vector< std::string > _names;
+        std::vector< const bool* > _decisionPtrs;
+        std::unordered_map< std::string, std::size_t > _indices;
+};
+
+#endif
@@ -12,9 +12,19 @@
 
 //include other parts of code
 #include "../../Tools/interface/Sample.h"
+#include "DecisionTable.h"
+#include "BranchIndex.h"
+
+//include c++ library classes
+#include <unordered_map>
+#include <cstdint>
 
 
 class Event;
+class SusyScan;
+class SampleMetadataIndex;
+struct SampleMetadata;
+class EventLoopProfiler;
 
 
 class TreeReader {
@@ -214,6 +224,10 @@ class TreeReader {
         std::map< std::string, bool > _triggerMap;
         std::map< std::string, bool > _MetFilterMap;
 
+        //names of the individual triggers and MET filters resolved to indices, rebuilt for every sample
+        std::shared_ptr< const DecisionTable > _triggerTablePtr;
+        std::shared_ptr< const DecisionTable > _MetFilterTablePtr;
+
         //weight including cross section scaling 
         double          _scaledWeight;
 
@@ -257,6 +271,10 @@ class TreeReader {
         //check whether a particular trigger is present 
         bool containsTriggerInfo( const std::string& triggerPath ) const;
 
+        //index of an individual trigger or MET filter in the current sample, to check its decision in events with a single bit test
+        std::size_t triggerIndex( const std::string& triggerName ) const{ return _triggerTablePtr->index( triggerName ); }
+        std::size_t metFilterIndex( const std::string& filterName ) const{ return _MetFilterTablePtr->index( filterName ); }
+
         //check which year the current sample belongs to
         bool is2016() const;
         bool is2017() const;
@@ -269,6 +287,32 @@ class TreeReader {
         bool isNewPhysicsSignal() const;
         bool isSusy() const{ return _isSusy; }
 
+        //the LHE and parton shower weights are only needed for scale, pdf and parton shower variations
+        //when they are not read, their branches are not decompressed and the events carry no such weights
+        //this takes effect for the samples initialized after the call, and trees with generator weights can then not be written
+        void setReadGeneratorWeights( const bool readWeights ){ _readGeneratorWeights = readWeights; }
+        bool readsGeneratorWeights() const{ return _readGeneratorWeights; }
+
+        //read only the branches whose names start with one of the given prefixes, an empty list reads all branches
+        //objects built from branches that are not read have undefined contents, and trees can then not be written
+        //this takes effect for the samples initialized after the call
+        void setReadBranchPrefixes( const std::vector< std::string >& prefixes ){ _readBranchPrefixes = prefixes; }
+        const std::vector< std::string >& readBranchPrefixes() const{ return _readBranchPrefixes; }
+        bool readsBranch( const std::string& branchName ) const;
+
+        //attach a profiler to time reading and building events, the profiler is not owned by the TreeReader
+        void setProfiler( EventLoopProfiler* profilerPtr );
+
+        //attach a SusyScan so the mass point index of SUSY events is resolved when they are built
+        void setSusyScan( const SusyScan& );
+        const SusyScan* susyScanPtr() const{ return _susyScanPtr.get(); }
+
+        //load or build the metadata index of the current sample list ( see SampleMetadataIndex )
+        //samples initialized afterwards take their normalization and branch content from the index instead of the file counters
+        void useSampleMetadataIndex( const std::string& indexPath );
+        void setSampleMetadataIndex( const std::shared_ptr< const SampleMetadataIndex >& );
+        const SampleMetadataIndex* sampleMetadataIndexPtr() const{ return _sampleMetadataIndexPtr.get(); }
+
         //access number of samples and current sample
         const Sample& currentSample() const{ return *_currentSamplePtr; }
         const Sample* currentSamplePtr() const{ return _currentSamplePtr.get(); }
@@ -382,6 +426,22 @@ class TreeReader {
         //cache whether current sample is SUSY to avoid having to check the branch names for each event
         bool _isSusy = false;
 
+        //whether the LHE and parton shower weights are read
+        bool _readGeneratorWeights = true;
+        std::vector< std::string > _readBranchPrefixes;
+
+        //optional scan used to index the SUSY mass points
+        std::shared_ptr< const SusyScan > _susyScanPtr;
+
+        //optional index of the sample metadata, and the entry of the current sample if it is present in the index
+        std::shared_ptr< const SampleMetadataIndex > _sampleMetadataIndexPtr;
+        const SampleMetadata* _currentMetadataPtr = nullptr;
+
+        //optional profiler and the indices of its stages
+        EventLoopProfiler* _profilerPtr = nullptr;
+        size_t _readStage = 0;
+        size_t _buildStage = 0;
+
         //check whether current sample is initialized, throw an error if it is not 
         void checkCurrentSample() const;
 
@@ -470,8 +530,18 @@ class TreeReader {
         void readSamples(const std::string&, const std::string&, std::vector<Sample>&);
 
         //initialize triggerMap
-        void initializeTriggerMap( TTree* );
-        void initializeMetFilterMap( TTree* );
+        void initializeTriggerMap( const BranchIndex& );
+        void initializeMetFilterMap( const BranchIndex& );
+
+        //classified branches of the current tree, shared by all trees with the same schema
+        std::shared_ptr< const BranchIndex > _currentBranchIndexPtr;
+        std::unordered_map< std::uint64_t, std::shared_ptr< const BranchIndex > > _branchIndices;
+
+        //schema from which the trigger and MET filter maps were built
+        std::shared_ptr< const BranchIndex > _decisionMapsBranchIndexPtr;
+
+        void updateBranchIndex();
+        const BranchIndex& currentBranchIndex() const;
 
         //list of branches
         TBranch        *b__runNb;   
@@ -0,0 +1,67 @@
+#include "../interface/BranchIndex.h"
+
+//include c++ library classes
+#include <cstring>
+
+//include other parts of framework
+#include "../../Tools/interface/stringTools.h"
+
+
+BranchIndex::BranchIndex( TTree* treePtr ) :
+    _hash( schemaHash( treePtr ) )
+{
+    TObjArray* branch_list = treePtr->GetListOfBranches();
+    _branchNames.reserve( branch_list->GetEntries() );
+    for( const auto& branchPtr : *branch_list ){
+        _branchNames.push_back( branchPtr->GetName() );
+    }
+    _branchNameSet.insert( _branchNames.cbegin(), _branchNames.cend() );
+
+    for( const auto& branchName : _branchNames ){
+        _hasGeneratorInfo = _hasGeneratorInfo || stringTools::stringContains( branchName, "_gen_" );
+        _hasSusyMassInfo = _hasSusyMassInfo || stringTools::stringContains( branchName, "_mChi" );
+        if( stringTools::stringContains( branchName, "HLT" ) && !stringTools::stringContains( branchName, "prescale" ) ){
+            _triggerNames.push_back( branchName );
+        }
+
+        //WARNING: Currently one MET filter contains 'updated' rather than 'Flag' in the name. If this changes, make sure to modify the code here!
+        if( stringTools::stringContains( branchName, "Flag" ) || stringTools::stringContains( branchName, "updated" ) ){
+            _metFilterNames.push_back( branchName );
+        }
+    }
+}
+
+
+//64-bit FNV-1a hash, the branch names are separated by a 0 byte so that different splits of the same characters differ
+std::uint64_t BranchIndex::schemaHash( TTree* treePtr ){
+    std::uint64_t hash = 14695981039346656037ULL;
+    for( const auto& branchPtr : *treePtr->GetListOfBranches() ){
+        for( const char* c = branchPtr->GetName(); ; ++c ){
+            hash ^= static_cast< unsigned char >( *c );
+            hash *= 1099511628211ULL;
+            if( *c == '\0' ) break;
+        }
+    }
+    return hash;
+}
+
+
+bool BranchIndex::matches( TTree* treePtr ) const{
+    TObjArray* branch_list = treePtr->GetListOfBranches();
+    if( static_cast< size_type >( branch_list->GetEntries() ) != _branchNames.size() ) return false;
+    size_type b = 0;
+    for( const auto& branchPtr : *branch_list ){
+        if( std::strcmp( branchPtr->GetName(), _branchNames[ b ].c_str() ) != 0 ) return false;
+        ++b;
+    }
+    return true;
+}
+
+
+bool BranchIndex::containsSubstring( const std::string& nameToFind ) const{
+    if( contains( nameToFind ) ) return true;
+    for( const auto& branchName : _branchNames ){
+        if( stringTools::stringContains( branchName, nameToFind ) ) return true;
+    }
+    return false;
+}
@@ -0,0 +1,57 @@
+#include "../interface/DecisionTable.h"
+
+//include c++ library classes
+#include <stdexcept>
+
+//include other parts of framework
+#include "../../Tools/interface/stringTools.h"
+
+
+namespace{
+
+    //remove leading _ from trigger and filter names 
+    std::string cleanName( const std::string& name ){
+        std::string ret( name );
+        if( stringTools::stringStartsWith( name, "_" ) ){
+            ret.erase(0, 1);
+        }
+        return ret;
+    }
+}
+
+
+DecisionTable::DecisionTable( const std::map< std::string, bool >& decisionMap ){
+    if( decisionMap.size() > maximumNumberOfDecisions ){
+        throw std::runtime_error( "Sample contains " + std::to_string( decisionMap.size() ) + " individual decisions while at most " + std::to_string( maximumNumberOfDecisions ) + " can be stored, increase DecisionTable::maximumNumberOfDecisions." );
+    }
+    _names.reserve( decisionMap.size() );
+    _decisionPtrs.reserve( decisionMap.size() );
+    for( const auto& decision : decisionMap ){
+        std::string name = cleanName( decision.first );
+        _indices.insert( { name, _names.size() } );
+        _names.push_back( name );
+        _decisionPtrs.push_back( &decision.second );
+    }
+}
+
+
+std::size_t DecisionTable::index( const std::string& name ) const{
+    auto indexIt = _indices.find( name );
+
+    //throw error if non-existing trigger or MET filter is requested
+    if( indexIt == _indices.cend() ){
+        throw std::invalid_argument( "Requested trigger or MET filter '" + name + "' does not exist." );
+    }
+    return indexIt->second;
+}
+
+
+DecisionTable::bitset_type DecisionTable::decisions() const{
+    bitset_type decisionBits;
+    for( std::size_t i = 0; i < _decisionPtrs.size(); ++i ){
+        if( *_decisionPtrs[ i ] ){
+            decisionBits.set( i );
+        }
+    }
+    return decisionBits;
+}
@@ -10,6 +10,9 @@
 #include "../../Tools/interface/stringTools.h"
 #include "../../Tools/interface/systemTools.h"
 #include "../../Tools/interface/analysisTools.h"
+#include "../../Tools/interface/SusyScan.h"
+#include "../../Tools/interface/SampleMetadataIndex.h"
+#include "../../Tools/interface/EventLoopProfiler.h"
 #include "../../Event/interface/Event.h"
 #include "../../constants/luminosities.h"
 
@@ -85,66 +88,67 @@ void TreeReader::readSamples2018( const std::string& list, const std::string& di
 }
 
 
-std::pair< std::map< std::string, bool >, std::map< std::string, TBranch* > > buildBranchMap( TTree* treePtr, const std::string& nameIdentifier, const std::string& antiIdentifier = "" ){   
+std::pair< std::map< std::string, bool >, std::map< std::string, TBranch* > > buildBranchMap( const std::vector< std::string >& branchNames ){
     std::map< std::string, bool > decisionMap;
     std::map< std::string, TBranch* > branchMap;
-    TObjArray* branch_list = treePtr->GetListOfBranches();
-    for( const auto& branchPtr : *branch_list ){
-        std::string branchName = branchPtr->GetName();
-        if( stringTools::stringContains( branchName, nameIdentifier ) ){
-            if( antiIdentifier != "" && stringTools::stringContains( branchName, antiIdentifier ) ) continue;
-            decisionMap[ branchName ] = false;
-            branchMap[ branchName ] = nullptr;
-        }
+    for( const auto& branchName : branchNames ){
+        decisionMap[ branchName ] = false;
+        branchMap[ branchName ] = nullptr;
     }
     return { decisionMap, branchMap };
 }
 
 
-void TreeReader::initializeTriggerMap( TTree* treePtr ){
-    auto triggerMaps = buildBranchMap( treePtr, "HLT", "prescale" );
+void TreeReader::initializeTriggerMap( const BranchIndex& branchIndex ){
+    auto triggerMaps = buildBranchMap( branchIndex.triggerNames() );
     _triggerMap = triggerMaps.first;
     b__triggerMap = triggerMaps.second;
 }
 
 
-void TreeReader::initializeMetFilterMap( TTree* treePtr ){
-
-    //WARNING: Currently one MET filter contains 'updated' rather than 'Flag' in the name. If this changes, make sure to modify the code here!
-    auto filterMaps = buildBranchMap( treePtr, "Flag" );
-    auto filterMaps_part2 = buildBranchMap( treePtr , "updated" );
-    filterMaps.first.insert( filterMaps_part2.first.cbegin(), filterMaps_part2.first.cend() );
-    filterMaps.second.insert( filterMaps_part2.second.cbegin(), filterMaps_part2.second.cend() );
-
+void TreeReader::initializeMetFilterMap( const BranchIndex& branchIndex ){
+    auto filterMaps = buildBranchMap( branchIndex.metFilterNames() );
     _MetFilterMap = filterMaps.first;
     b__MetFilterMap = filterMaps.second;
 }
 
 
-bool treeHasBranchWithName( TTree* treePtr, const std::string& nameToFind ){
-	TObjArray* branch_list = treePtr->GetListOfBranches();
-    for( const auto& branchPtr : *branch_list ){
-        std::string branchName = branchPtr->GetName();
-		if( stringTools::stringContains( branchName, nameToFind ) ){
-			return true;
-		}
-	}
-	return false;
+//classify the branches of the current tree, reusing the index of an earlier tree with the same schema
+void TreeReader::updateBranchIndex(){
+    std::uint64_t hash = BranchIndex::schemaHash( _currentTreePtr );
+    auto it = _branchIndices.find( hash );
+    if( it != _branchIndices.cend() && it->second->matches( _currentTreePtr ) ){
+        _currentBranchIndexPtr = it->second;
+    } else {
+        _currentBranchIndexPtr = std::make_shared< const BranchIndex >( _currentTreePtr );
+        _branchIndices[ hash ] = _currentBranchIndexPtr;
+    }
+}
+
+
+const BranchIndex& TreeReader::currentBranchIndex() const{
+    checkCurrentTree();
+    if( !_currentBranchIndexPtr ){
+        throw std::domain_error( "pointer to the BranchIndex of the current TTree is nullptr." );
+    }
+    return *_currentBranchIndexPtr;
 }
 
 
 bool TreeReader::containsGeneratorInfo() const{
-    return treeHasBranchWithName( _currentTreePtr, "_gen_" );
+    if( _currentMetadataPtr != nullptr ) return _currentMetadataPtr->hasGeneratorInfo;
+    return currentBranchIndex().hasGeneratorInfo();
 }
 
 
 bool TreeReader::containsSusyMassInfo() const{
-    return treeHasBranchWithName( _currentTreePtr, "_mChi" );
+    if( _currentMetadataPtr != nullptr ) return _currentMetadataPtr->hasSusyMassInfo;
+    return currentBranchIndex().hasSusyMassInfo();
 }
 
 
 bool TreeReader::containsTriggerInfo( const std::string& triggerPath ) const{
-    return treeHasBranchWithName( _currentTreePtr, triggerPath );
+    return currentBranchIndex().containsSubstring( triggerPath );
 }
 
 
@@ -221,24 +225,36 @@ long unsigned TreeReader::numberOfEntries() const{
 
 void TreeReader::initSample( const Sample& samp ){ 
 
+    //the time spent opening the sample is attributed to the new sample
+    if( _profilerPtr != nullptr ){
+        _profilerPtr->startSample( samp.uniqueName() );
+    }
+
     //update current sample
     //I wonder if the extra copy can be avoided here, its however hard if we want to keep the functionality of reading the sample vector, and also having the function initSampleFromFile. It's not clear how we can make a new sample in one of them and refer to an existing one in the other. It can be done with a static Sample in 'initSampleFromFile', but this makes the entire TreeReader class unthreadsafe, so no parallel sample processing in one process can be done 
     _currentSamplePtr = std::make_shared< Sample >( samp );
     _currentFilePtr = samp.filePtr();
+    _currentMetadataPtr = ( _sampleMetadataIndexPtr ? _sampleMetadataIndexPtr->metadataPtr( samp ) : nullptr );
 
     //Warning: this pointer is overwritten, but it is not a memory leak. ROOT is dirty and deletes the previous tree upon closure of the TFile it belongs to.
     //The previous TFile is closed by the std::shared_ptr destructor, implicitly called above when opening a new TFile.
     _currentTreePtr = (TTree*) _currentFilePtr->Get( "blackJackAndHookers/blackJackAndHookersTree" );
     checkCurrentTree();
+    updateBranchIndex();
     initTree();
     if( !samp.isData() ){
 
-        //read sum of simulated event weights
-        TH1D* hCounter = new TH1D( "hCounter", "Events counter", 1, 0, 1 );
-        _currentFilePtr->cd( "blackJackAndHookers" );
-        hCounter->Read( "hCounter" ); 
-        double sumSimulatedEventWeights = hCounter->GetBinContent(1);
-        delete hCounter;
+        //read sum of simulated event weights, from the metadata index when the sample is present in it
+        double sumSimulatedEventWeights;
+        if( _currentMetadataPtr != nullptr ){
+            sumSimulatedEventWeights = _currentMetadataPtr->sumOfSimulatedEventWeights;
+        } else {
+            TH1D* hCounter = new TH1D( "hCounter", "Events counter", 1, 0, 1 );
+            _currentFilePtr->cd( "blackJackAndHookers" );
+            hCounter->Read( "hCounter" ); 
+            sumSimulatedEventWeights = hCounter->GetBinContent(1);
+            delete hCounter;
+        }
 
         //event weights set with lumi depending on sample's era 
         double dataLumi;
@@ -272,15 +288,20 @@ void TreeReader::initSampleFromFile( const std::string& pathToFile, const bool i
     }
 
     _currentFilePtr = std::shared_ptr< TFile >( new TFile( pathToFile.c_str() ) );
+    _currentMetadataPtr = nullptr;
 
     //Warning: this pointer is overwritten, but it is not a memory leak. ROOT is dirty and deletes the previous tree upon closure of the TFile it belongs to.
     //The previous TFile is closed by the std::shared_ptr destructor, implicitly called above when opening a new TFile.
     _currentTreePtr = (TTree*) _currentFilePtr->Get( "blackJackAndHookers/blackJackAndHookersTree" );
     checkCurrentTree();
+    updateBranchIndex();
 
     //make a new sample, and make sure the pointer remains valid
     //new is no option here since this would also require a destructor for the class which does not work for the other initSample case
     _currentSamplePtr = std::make_shared< Sample >( pathToFile, is2017, is2018, isData() );
+    if( _profilerPtr != nullptr ){
+        _profilerPtr->startSample( _currentSamplePtr->uniqueName() );
+    }
 
     //initialize tree
     initTree( resetTriggersAndFilters );
@@ -320,12 +341,30 @@ void TreeReader::GetEntry( long unsigned entry ){
 
 
 Event TreeReader::buildEvent( const Sample& samp, long unsigned entry, const bool readIndividualTriggers, const bool readIndividualMetFilters ){
+    if( _profilerPtr != nullptr && _profilerPtr->isEnabled() ){
+        _profilerPtr->countEvent();
+        {
+            EventLoopProfiler::ScopedTimer timer( *_profilerPtr, _readStage );
+            GetEntry( samp, entry );
+        }
+        EventLoopProfiler::ScopedTimer timer( *_profilerPtr, _buildStage );
+        return Event( *this, readIndividualTriggers, readIndividualMetFilters );
+    }
     GetEntry( samp, entry );
     return Event( *this, readIndividualTriggers, readIndividualMetFilters );
 }
 
 
 Event TreeReader::buildEvent( long unsigned entry, const bool readIndividualTriggers, const bool readIndividualMetFilters ){
+    if( _profilerPtr != nullptr && _profilerPtr->isEnabled() ){
+        _profilerPtr->countEvent();
+        {
+            EventLoopProfiler::ScopedTimer timer( *_profilerPtr, _readStage );
+            GetEntry( entry );
+        }
+        EventLoopProfiler::ScopedTimer timer( *_profilerPtr, _buildStage );
+        return Event( *this, readIndividualTriggers, readIndividualMetFilters );
+    }
     GetEntry( entry );
     return Event( *this, readIndividualTriggers, readIndividualMetFilters );
 }
@@ -502,12 +541,20 @@ void TreeReader::initTree( const bool resetTriggersAndFilters ){
     _currentTreePtr->SetBranchAddress("_metPhiUnclUp", &_metPhiUnclUp, &b__metPhiUnclUp);
     _currentTreePtr->SetBranchAddress("_metSignificance", &_metSignificance, &b__metSignificance);
     
+    //the generator weights are large arrays, so they are only read when needed
+    _nLheWeights = 0;
+    _nPsWeights = 0;
     if( containsGeneratorInfo() ){
         _currentTreePtr->SetBranchAddress("_weight", &_weight, &b__weight);
-        _currentTreePtr->SetBranchAddress("_nLheWeights", &_nLheWeights, &b__nLheWeights);
-        _currentTreePtr->SetBranchAddress("_lheWeight", _lheWeight, &b__lheWeight);
-        _currentTreePtr->SetBranchAddress("_nPsWeights", &_nPsWeights, &b__nPsWeights);
-        _currentTreePtr->SetBranchAddress("_psWeight", _psWeight, &b__psWeight);
+        for( const auto& branchName : { "_nLheWeights", "_lheWeight", "_nPsWeights", "_psWeight" } ){
+            _currentTreePtr->SetBranchStatus( branchName, _readGeneratorWeights );
+        }
+        if( _readGeneratorWeights ){
+            _currentTreePtr->SetBranchAddress("_nLheWeights", &_nLheWeights, &b__nLheWeights);
+            _currentTreePtr->SetBranchAddress("_lheWeight", _lheWeight, &b__lheWeight);
+            _currentTreePtr->SetBranchAddress("_nPsWeights", &_nPsWeights, &b__nPsWeights);
+            _currentTreePtr->SetBranchAddress("_psWeight", _psWeight, &b__psWeight);
+        }
         _currentTreePtr->SetBranchAddress("_nTrueInt", &_nTrueInt, &b__nTrueInt);
         _currentTreePtr->SetBranchAddress("_lheHTIncoming", &_lheHTIncoming, &b__lheHTIncoming);
         _currentTreePtr->SetBranchAddress("_gen_met", &_gen_met, &b__gen_met);
@@ -543,23 +590,53 @@ void TreeReader::initTree( const bool resetTriggersAndFilters ){
 		_currentTreePtr->SetBranchAddress("_mChi2", &_mChi2, &b__mChi2);
 	}
 
-    //add all individually stored triggers 
-    //always reset triggers instead of rare case of combining primary datasets to prevent invalidating addresses set by setOutputTree
-    if( resetTriggersAndFilters || _triggerMap.empty() ){
-        initializeTriggerMap( _currentTreePtr );
+    //add all individually stored triggers and MET filters
+    //always reset triggers and filters instead of rare case of combining primary datasets to prevent invalidating addresses set by setOutputTree
+    //maps built from the same schema as the current tree already hold the right names, so they are kept
+    bool resetDecisionMaps = ( resetTriggersAndFilters || _triggerMap.empty() || _MetFilterMap.empty() );
+    if( resetDecisionMaps && _decisionMapsBranchIndexPtr != _currentBranchIndexPtr ){
+        if( resetTriggersAndFilters || _triggerMap.empty() ){
+            initializeTriggerMap( *_currentBranchIndexPtr );
+        }
+        if( resetTriggersAndFilters || _MetFilterMap.empty() ){
+            initializeMetFilterMap( *_currentBranchIndexPtr );
+        }
+        _decisionMapsBranchIndexPtr = _currentBranchIndexPtr;
+
+        //events of the new sample share these tables, events of earlier samples keep their own
+        _triggerTablePtr = std::make_shared< const DecisionTable >( _triggerMap );
+        _MetFilterTablePtr = std::make_shared< const DecisionTable >( _MetFilterMap );
     }
     setMapBranchAddresses( _currentTreePtr, _triggerMap, b__triggerMap );
+    setMapBranchAddresses( _currentTreePtr, _MetFilterMap, b__MetFilterMap );
 
-    //add all individually stored MET filters
-    //always reset filters instead of rare case of combining primary datasets to prevent invalidating addresses set by setOutputTree
-    if( resetTriggersAndFilters || _MetFilterMap.empty() ){
-        initializeMetFilterMap( _currentTreePtr );
+    //branches outside the selection are not decompressed by GetEntry
+    if( !_readBranchPrefixes.empty() ){
+        for( const auto& branchName : _currentBranchIndexPtr->branchNames() ){
+            if( !readsBranch( branchName ) ){
+                _currentTreePtr->SetBranchStatus( branchName.c_str(), 0 );
+            }
+        }
     }
-    setMapBranchAddresses( _currentTreePtr, _MetFilterMap, b__MetFilterMap );
+}
+
+
+bool TreeReader::readsBranch( const std::string& branchName ) const{
+    if( _readBranchPrefixes.empty() ) return true;
+    for( const auto& prefix : _readBranchPrefixes ){
+        if( stringTools::stringStartsWith( branchName, prefix ) ) return true;
+    }
+    return false;
 }
 
 
 void TreeReader::setOutputTree( TTree* outputTree ){
+    if( containsGeneratorInfo() && !_readGeneratorWeights ){
+        throw std::domain_error( "Trying to write generator weights to an output tree while they are not read, enable them with setReadGeneratorWeights." );
+    }
+    if( !_readBranchPrefixes.empty() ){
+        throw std::domain_error( "Trying to write an output tree while only a selection of the branches is read, clear the selection with setReadBranchPrefixes." );
+    }
     outputTree->Branch("_runNb",                        &_runNb,                        "_runNb/l");
     outputTree->Branch("_lumiBlock",                    &_lumiBlock,                    "_lumiBlock/l");
     outputTree->Branch("_eventNb",                      &_eventNb,                      "_eventNb/l");
@@ -796,6 +873,30 @@ std::vector< std::shared_ptr< TH1 > > TreeReader::getHistogramsFromCurrentFile()
 }
 
 
+void TreeReader::setProfiler( EventLoopProfiler* profilerPtr ){
+    _profilerPtr = profilerPtr;
+    if( _profilerPtr != nullptr ){
+        _readStage = _profilerPtr->stageIndex( "TreeReader read" );
+        _buildStage = _profilerPtr->stageIndex( "buildEvent" );
+    }
+}
+
+
+void TreeReader::setSusyScan( const SusyScan& susyScan ){
+    _susyScanPtr = std::make_shared< const SusyScan >( susyScan );
+}
+
+
+void TreeReader::useSampleMetadataIndex( const std::string& indexPath ){
+    setSampleMetadataIndex( std::make_shared< const SampleMetadataIndex >( samples, indexPath ) );
+}
+
+
+void TreeReader::setSampleMetadataIndex( const std::shared_ptr< const SampleMetadataIndex >& metadataIndexPtr ){
+    _sampleMetadataIndexPtr = metadataIndexPtr;
+}
+
+
 void TreeReader::removeBSMSignalSamples(){
     for( auto it = samples.begin(); it != samples.end(); ){
         if( it->isNewPhysicsSignal() ){
@@ -0,0 +1,45 @@
+#build configurations of the framework libraries and the executables linked against them
+#the configuration is chosen with BUILD=<configuration> on the make command line, and must be the same for the libraries and the executables
+#    portable (default) : -O3 code that runs on any x86-64 machine
+#    native             : additionally vectorize for the instruction set of the machine that compiles the code
+#    lto                : native, with link-time optimization across the translation units of each library and executable
+#    pgo-generate       : instrumented lto build, running it writes execution profiles to PROFILE_DIR
+#    pgo-use            : lto build optimized with the profiles collected by the pgo-generate build
+#native builds only run on machines supporting the same instruction set, use the portable build for jobs on heterogeneous clusters
+#buildPGO.sh runs the full profile-guided build
+#independently of the configuration, PRECISION=float stores the kinematic and identification quantities of the physics objects as float ( see objects/interface/objectPrecision.h )
+#the float precision libraries and executables are built in their own subdirectories, since the object layout differs from the default double precision
+
+BUILD ?= portable
+PROFILE_DIR ?= $(abspath $(FRAMEWORK_DIR)/pgoProfiles)
+
+NATIVE_FLAGS= -march=native
+LTO_FLAGS= $(NATIVE_FLAGS) -flto=auto
+
+#profiles are attributed to object files by their full path, so the instrumented and the optimized build must use the same directories
+ifeq ($(BUILD),portable)
+    BUILD_FLAGS=
+    BUILD_SUBDIRECTORY=
+else ifeq ($(BUILD),native)
+    BUILD_FLAGS= $(NATIVE_FLAGS)
+    BUILD_SUBDIRECTORY=/native
+else ifeq ($(BUILD),lto)
+    BUILD_FLAGS= $(LTO_FLAGS)
+    BUILD_SUBDIRECTORY=/lto
+else ifeq ($(BUILD),pgo-generate)
+    BUILD_FLAGS= $(LTO_FLAGS) -fprofile-generate=$(PROFILE_DIR) -fprofile-update=atomic
+    BUILD_SUBDIRECTORY=/pgo
+else ifeq ($(BUILD),pgo-use)
+    BUILD_FLAGS= $(LTO_FLAGS) -fprofile-use=$(PROFILE_DIR) -fprofile-correction -Wno-missing-profile
+    BUILD_SUBDIRECTORY=/pgo
+else
+    $(error Unknown build configuration '$(BUILD)', choose one of : portable, native, lto, pgo-generate, pgo-use)
+endif
+
+PRECISION ?= double
+ifeq ($(PRECISION),float)
+    BUILD_FLAGS+= -DFLOAT_PRECISION_OBJECTS
+    BUILD_SUBDIRECTORY:=$(BUILD_SUBDIRECTORY)/float
+else ifneq ($(PRECISION),double)
+    $(error Unknown precision '$(PRECISION)', choose one of : double, float)
+endif
@@ -0,0 +1,79 @@
+#!/bin/bash
+#profile-guided build of the framework libraries and the production executables
+#usage : ./buildPGO.sh [number of cores]
+#1) build instrumented libraries and executables (BUILD=pgo-generate)
+#2) collect execution profiles by running over the test data in test/testData
+#3) rebuild the libraries and the production executables with the profiles (BUILD=pgo-use)
+#the production executables do not run on the test data themselves, their event loops are profiled through the shared framework code in the libraries
+
+set -e
+
+cores=${1:-$(nproc)}
+frameworkDirectory=$(cd "$(dirname "$0")" && pwd)
+profileDirectory=${frameworkDirectory}/pgoProfiles
+
+#executables that are rebuilt with the profiles, as <directory> <make file>
+productionExecutables=(
+    "ewkinoAnalysis makeControlRegions"
+    "skimmer makeSkimmer"
+    "fakeRate makeFillFakeRateMeasurement"
+    "fakeRate makeFillMCFakeRateMeasurement"
+    "fakeRate makeFillMagicFactor"
+    "fakeRate makeFillPrescaleMeasurement"
+    "fakeRate makeFillTuneFOSelection"
+)
+
+#executables running over the test data to collect the profiles, as <directory> <make file> <command>
+trainingExecutables=(
+    "test/Event makeEvent_loop_example ./Event_loop_example"
+    "test/benchmarks makeBenchmarks ./benchmarks pgo-training /dev/null"
+)
+
+#inputs of the training runs, checked before the instrumented build so a missing file does not abort the script halfway
+requiredFiles=(
+    "test/testData/samples_test.txt"
+    "test/testData/testsamplelist.txt"
+    "weights/weightFiles/bTagSF/DeepCSV_2016LegacySF_WP_V1.csv"
+)
+for requiredFile in "${requiredFiles[@]}"; do
+    if [ ! -f "${frameworkDirectory}/${requiredFile}" ]; then
+        echo "Error: ${requiredFile} is needed for the profile training runs, but does not exist." >&2
+        exit 1
+    fi
+done
+if ! compgen -G "${frameworkDirectory}/test/testData/*.root" > /dev/null; then
+    echo "Error: no test data files found in test/testData to collect the profiles." >&2
+    exit 1
+fi
+
+buildExecutable(){
+    ( cd "${frameworkDirectory}/$1" && make -f "$2" BUILD="$3" PROFILE_DIR="${profileDirectory}" )
+}
+
+#instrumented build, old profiles are removed since they do not match the current code
+rm -rf "${profileDirectory}"
+make -C "${frameworkDirectory}" -f makeLibraries -j"${cores}" BUILD=pgo-generate PROFILE_DIR="${profileDirectory}"
+for executable in "${trainingExecutables[@]}" "${productionExecutables[@]}"; do
+    read -r directory makeFile command <<< "${executable}"
+    buildExecutable "${directory}" "${makeFile}" pgo-generate
+done
+
+#training runs
+for executable in "${trainingExecutables[@]}"; do
+    read -r directory makeFile command <<< "${executable}"
+    ( cd "${frameworkDirectory}/${directory}" && ${command} )
+done
+skimDirectory=$(mktemp -d)
+for inputFile in "${frameworkDirectory}"/test/testData/*.root; do
+    for skimCondition in dilepton trilepton fakerate; do
+        ( cd "${frameworkDirectory}/skimmer" && ./skimmer "${inputFile}" "${skimDirectory}" "${skimCondition}" )
+    done
+done
+rm -rf "${skimDirectory}"
+
+#optimized build
+make -C "${frameworkDirectory}" -f makeLibraries -j"${cores}" BUILD=pgo-use PROFILE_DIR="${profileDirectory}"
+for executable in "${productionExecutables[@]}"; do
+    read -r directory makeFile command <<< "${executable}"
+    buildExecutable "${directory}" "${makeFile}" pgo-use
+done
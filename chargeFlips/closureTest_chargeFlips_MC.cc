@@ -69,7 +69,8 @@ void closureTest_MC( const std::string& process, const std::string& year, const
     }
     
     //read fake-rate map corresponding to this year and flavor 
-    std::shared_ptr< TH2D > chargeFlipMap_electron = readChargeFlipMap( year );
+    std::shared_ptr< TH2D > chargeFlipHist_electron = readChargeFlipMap( year );
+    const LookupTable2D chargeFlipMap_electron( chargeFlipHist_electron.get() );
 
 
 	//loop over samples to fill histograms
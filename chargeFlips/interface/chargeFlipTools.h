@@ -7,7 +7,9 @@
 
 //include other parts of framework
 #include "../../Event/interface/Event.h"
+#include "../../weights/interface/transferFactors.h"
 
 namespace chargeFlips{
     double chargeFlipWeight( const Event&, const std::shared_ptr< TH2 >& );
+    double chargeFlipWeight( const Event&, const LookupTable2D& );
 }
@@ -17,3 +17,8 @@ double chargeFlips::chargeFlipWeight( const Event& event, const std::shared_ptr<
     }
     return ( summedProbabilities - multipliedProbabilities );
 }
+
+
+double chargeFlips::chargeFlipWeight( const Event& event, const LookupTable2D& chargeFlipMap ){
+    return transferFactors::chargeFlipWeight( event, chargeFlipMap );
+}
@@ -1,61 +0,0 @@
-//include object code 
-#include "objects/src/LorentzVector.cc"
-#include "objects/src/PhysicsObject.cc"
-#include "objects/src/Lepton.cc"
-#include "objects/src/LightLepton.cc"
-#include "objects/src/Muon.cc"
-#include "objects/src/Electron.cc"
-#include "objects/src/Tau.cc"
-#include "objects/src/Jet.cc" 
-#include "objects/src/Met.cc"
-#include "objects/src/LeptonGeneratorInfo.cc"
-#include "objects/src/LeptonSelector.cc"
-#include "objects/src/GenMet.cc"
-#include "objectSelection/MuonSelector.cc"
-#include "objectSelection/ElectronSelector.cc"
-#include "objectSelection/TauSelector.cc"
-#include "objectSelection/JetSelector.cc"
-#include "objectSelection/bTagWP.cc"
-
-//include Event code 
-#include "Event/src/LeptonCollection.cc"
-#include "Event/src/JetCollection.cc"
-#include "Event/src/TriggerInfo.cc"
-#include "Event/src/GeneratorInfo.cc"
-#include "Event/src/SusyMassInfo.cc"
-#include "Event/src/EventTags.cc"
-#include "Event/src/Event.cc"
-
-//include Tools code 
-#include "Tools/src/stringTools.cc"
-#include "Tools/src/systemTools.cc"
-#include "Tools/src/analysisTools.cc"
-#include "Tools/src/IndexFlattener.cc"
-#include "Tools/src/Categorization.cc"
-#include "Tools/src/Sample.cc"
-#include "Tools/src/mergeAndRemoveOverlap.cc"
-#include "Tools/src/histogramTools.cc"
-#include "Tools/src/SusyScan.cc"
-#include "Tools/src/ConstantFit.cc"
-#include "Tools/src/SampleCrossSections.cc"
-#include "Tools/src/QuantileBinner.cc"
-#include "Tools/src/mt2.cc"
-
-//include TreeReader code 
-#include "TreeReader/src/TreeReader.cc"
-#include "TreeReader/src/TreeReaderErrors.cc"
-
-//include plotting code 
-#include "plotting/drawLumi.cc"
-#include "plotting/tdrStyle.cc"
-#include "plotting/plotCode.cc"
-
-//include Reweighter code 
-#include "weights/bTagSFCode/BTagCalibrationStandalone.cc"
-#include "weights/src/ReweighterBTag.cc"
-#include "weights/src/ReweighterBTagHeavyFlavor.cc"
-#include "weights/src/ReweighterBTagLightFlavor.cc"
-#include "weights/src/ReweighterPileup.cc"
-#include "weights/src/ReweighterPrefire.cc"
-#include "weights/src/CombinedReweighter.cc"
-#include "weights/src/ConcreteReweighterFactory.cc"
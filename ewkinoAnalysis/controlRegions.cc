@@ -10,12 +10,15 @@
 #include "../Tools/interface/systemTools.h"
 #include "../Tools/interface/stringTools.h"
 #include "../Tools/interface/HistInfo.h"
+#include "../Tools/interface/MultiWeightHistogram.h"
 #include "../weights/interface/ConcreteReweighterFactory.h"
 #include "../Tools/interface/SusyScan.h"
+#include "../Tools/interface/SampleMetadataIndex.h"
 #include "../Tools/interface/histogramTools.h"
 #include "../plotting/plotCode.h"
 #include "../plotting/tdrStyle.h"
 #include "../Tools/interface/KerasModelReader.h"
+#include "../Tools/interface/EventLoopProfiler.h"
 
 //include ewkino specific code
 #include "interface/ewkinoSelection.h"
@@ -68,7 +71,7 @@ std::vector< HistInfo > makeDistributionInfo( const std::string& deltaM, const s
 }
 
 
-std::vector< double > buildFillingVector( Event& event, const std::string& uncertainty, const double massSplitting, const KerasModelReader* nnReader ){
+std::vector< double > buildFillingVector( Event& event, const std::string& uncertainty, const double massSplitting, const KerasModelReader* nnReader, EventLoopProfiler& profiler, const size_t inferenceStage ){
     
     auto varMap = ewkino::computeVariables( event, uncertainty );
     std::vector< double > fillValues;
@@ -97,6 +100,7 @@ std::vector< double > buildFillingVector( Event& event, const std::string& uncer
     } else {
         std::vector< double > nnInput = { varMap.at("met"), varMap.at("mll"), varMap.at("mtW"), varMap.at("ltmet"), varMap.at("ht"), varMap.at("m3l"), varMap.at("mt3l") };
         std::vector< double > parameters = { massSplitting };
+        EventLoopProfiler::ScopedTimer inferenceTimer( profiler, inferenceStage );
         double nnOutput = nnReader->predict( nnInput, parameters );
         fillValues = { nnOutput };
     
@@ -109,7 +113,7 @@ std::vector< double > buildFillingVector( Event& event, const std::string& uncer
 
 
 
-void analyze( const std::string& modelName, const std::string& deltaM, const std::string& year, const std::string& controlRegion, const std::string& sampleDirectoryPath ){
+void analyze( const std::string& modelName, const std::string& deltaM, const std::string& year, const std::string& controlRegion, const std::string& sampleDirectoryPath, const bool profile = false ){
 
 	analysisTools::checkYearString( year );
 
@@ -150,13 +154,35 @@ void analyze( const std::string& modelName, const std::string& deltaM, const std
 
     //build TreeReader and loop over samples
     std::cout << "building treeReader" << std::endl;
-    TreeReader treeReader( "sampleLists/samples_" + modelName + "_" + year + ".txt", sampleDirectoryPath );
+    const std::string sampleListPath = "sampleLists/samples_" + modelName + "_" + year + ".txt";
+    TreeReader treeReader( sampleListPath, sampleDirectoryPath );
+
+    //the metadata index of the full sample list provides the sums of weights and pileup profiles without opening every file
+    std::shared_ptr< const SampleMetadataIndex > metadataIndexPtr = std::make_shared< const SampleMetadataIndex >( treeReader.sampleVector(), SampleMetadataIndex::defaultIndexPath( sampleListPath ) );
+    treeReader.setSampleMetadataIndex( metadataIndexPtr );
     treeReader.removeBSMSignalSamples();
 
+    //optional timing of the event loop stages and cut-flow
+    EventLoopProfiler profiler( profile );
+    treeReader.setProfiler( &profiler );
+    const size_t objectSelectionStage = profiler.stageIndex( "object selection" );
+    const size_t selectionStage = profiler.stageIndex( "event selection" );
+    const size_t reweightingStage = profiler.stageIndex( "reweighting" );
+    const size_t fillStage = profiler.stageIndex( "histogram fill" );
+    const size_t inferenceStage = profiler.stageIndex( "NN inference" );
+    const size_t baselineCounter = profiler.counterIndex( "baseline" );
+    const size_t ptCounter = profiler.counterIndex( "lepton pT" );
+    const size_t triggerCounter = profiler.counterIndex( "trigger" );
+    const size_t photonCounter = profiler.counterIndex( "photon overlap" );
+    const size_t promptCounter = profiler.counterIndex( "prompt" );
+    const size_t categoryCounter = profiler.counterIndex( "trilepton category" );
+
     //build ewkino reweighter
     std::cout << "building reweighter" << std::endl;
-    std::shared_ptr< ReweighterFactory >reweighterFactory( new EwkinoReweighterFactory() );
-    CombinedReweighter reweighter = reweighterFactory->buildReweighter( "../weights/", year, treeReader.sampleVector() );
+    ScaleFactorSource scaleFactorSource = ScaleFactorSource::forYear( "../weights/", year );
+    scaleFactorSource.setSampleMetadataIndex( metadataIndexPtr );
+    EwkinoReweighterFactory reweighterFactory;
+    CombinedReweighter reweighter = reweighterFactory.buildReweighter( scaleFactorSource, year, treeReader.sampleVector() );
 
     //read FR maps
     std::cout << "building FR maps" << std::endl;
@@ -170,6 +196,10 @@ void analyze( const std::string& modelName, const std::string& deltaM, const std
     frMapElectrons->SetDirectory( gROOT );
     frFileElectrons->Close();
 
+    //flat copies of the maps for the lookups in the event loop
+    const LookupTable2D frTableMuons( frMapMuons.get() );
+    const LookupTable2D frTableElectrons( frMapElectrons.get() );
+
     //histogram collection
     std::cout << "building histograms" << std::endl;
     std::vector< HistInfo > histInfoVector = makeDistributionInfo( deltaM, controlRegion  );
@@ -194,6 +224,9 @@ void analyze( const std::string& modelName, const std::string& deltaM, const std
     for( const auto& unc : shapeUncNames ){
         histogramsUncDown[ unc ] = std::vector< std::vector< std::shared_ptr< TH1D > > >( histInfoVector.size(), std::vector< std::shared_ptr< TH1D > >( sampleVec.size() + 1 )  );
         histogramsUncUp[ unc ] = std::vector< std::vector< std::shared_ptr< TH1D > > >( histInfoVector.size(), std::vector< std::shared_ptr< TH1D > >( sampleVec.size() + 1 )  );
+
+        //the scale histograms are made from scaleHistograms after the event loop
+        if( unc == "scale" ) continue;
         
         for( size_t dist = 0; dist < histInfoVector.size(); ++dist ){
             for( size_t p = 0; p < sampleVec.size() + 1; ++p ){
@@ -208,6 +241,15 @@ void analyze( const std::string& modelName, const std::string& deltaM, const std
         }
     }
 
+    //the scale down and up variations are filled together, with a single bin lookup per distribution
+    const std::vector< double > nominalScaleWeights = { 1., 1. };
+    std::vector< std::vector< MultiWeightHistogram > > scaleHistograms( histInfoVector.size() );
+    for( size_t dist = 0; dist < histInfoVector.size(); ++dist ){
+        for( size_t p = 0; p < sampleVec.size() + 1; ++p ){
+            scaleHistograms[ dist ].emplace_back( histInfoVector[ dist ], nominalScaleWeights.size() );
+        }
+    }
+
     std::cout << "event loop" << std::endl;
 
     for( unsigned sampleIndex = 0; sampleIndex < treeReader.numberOfSamples(); ++sampleIndex ){
@@ -220,43 +262,68 @@ void analyze( const std::string& modelName, const std::string& deltaM, const std
         for( long unsigned entry = 0; entry < treeReader.numberOfEntries(); ++entry ){
             Event event = treeReader.buildEvent( entry );
 
-            //apply baseline selection
-            if( !ewkino::passBaselineSelection( event, true, false, true ) ) continue;
+            //select and clean the objects, timed separately from the event-level cuts
+            {
+                EventLoopProfiler::ScopedTimer objectSelectionTimer( profiler, objectSelectionStage );
+                ewkino::applyBaselineObjectSelection( event, true );
+            }
+
+            {
+                EventLoopProfiler::ScopedTimer selectionTimer( profiler, selectionStage );
 
+                //apply baseline selection
+                if( !ewkino::passBaselineEventSelection( event, true, false, true ) ) continue;
+                profiler.count( baselineCounter );
 
-            //apply lepton pT cuts
-            if( !ewkino::passPtCuts( event ) ) continue;
+                //apply lepton pT cuts
+                if( !ewkino::passPtCuts( event ) ) continue;
+                profiler.count( ptCounter );
 
-            //require triggers
-            if( !treeReader.isSusy() && !ewkino::passTriggerSelection( event ) ) continue;
+                //require triggers
+                if( !treeReader.isSusy() && !ewkino::passTriggerSelection( event ) ) continue;
+                profiler.count( triggerCounter );
 
-            //remove photon overlap
-            if( !ewkino::passPhotonOverlapRemoval( event ) ) continue;
+                //remove photon overlap
+                if( !ewkino::passPhotonOverlapRemoval( event ) ) continue;
+                profiler.count( photonCounter );
 
-            //require MC events to only contain prompt leptons
-            if( event.isMC() && !treeReader.isSusy() && !ewkino::leptonsArePrompt( event ) ) continue;
+                //require MC events to only contain prompt leptons
+                if( event.isMC() && !treeReader.isSusy() && !ewkino::leptonsArePrompt( event ) ) continue;
+                profiler.count( promptCounter );
 
-            ewkino::EwkinoCategory category = ewkino::ewkinoCategory( event );
-            if( !( category == ewkino::trilepLightOSSF || category == ewkino::trilepLightNoOSSF ) ) continue;
+                ewkino::EwkinoCategory category = ewkino::ewkinoCategory( event );
+                if( !( category == ewkino::trilepLightOSSF || category == ewkino::trilepLightNoOSSF ) ) continue;
+                profiler.count( categoryCounter );
+            }
             
             //apply scale-factors and reweighting
             double weight = event.weight();
-            if( event.isMC() ){
-                weight *= reweighter.totalWeight( event );
-            }
-
-            //apply fake-rate weight
             size_t fillIndex = sampleIndex;
-            if( !ewkino::leptonsAreTight( event ) && !treeReader.isSusy() ){
-                fillIndex = treeReader.numberOfSamples();
-                weight *= ewkino::fakeRateWeight( event, frMapMuons, frMapElectrons );
-                if( event.isMC() ) weight *= -1.;
+
+            //the nominal weight and all scale-factor variations, also for varied jet momenta, are computed in a single pass
+            CombinedWeightVariations weightVariations;
+            {
+                EventLoopProfiler::ScopedTimer reweightingTimer( profiler, reweightingStage );
+                if( event.isMC() ){
+                    weightVariations = reweighter.weightVariations( event, true );
+                    weight *= weightVariations.nominal();
+                }
+
+                //apply fake-rate weight
+                if( !ewkino::leptonsAreTight( event ) && !treeReader.isSusy() ){
+                    fillIndex = treeReader.numberOfSamples();
+                    weight *= ewkino::fakeRateWeight( event, frTableMuons, frTableElectrons );
+                    if( event.isMC() ) weight *= -1.;
+                }
             }
 
+            //the variables, systematic weights and neural network evaluation are included in the filling time
+            EventLoopProfiler::ScopedTimer fillTimer( profiler, fillStage );
+
             //fill nominal histograms
             //if( assVariedSelectionWZCR( event, "nominal" ) ){
             if( passSelection( event, "nominal" ) ){
-                auto fillValues = buildFillingVector( event, "nominal", massSplitting, nnReader );
+                auto fillValues = buildFillingVector( event, "nominal", massSplitting, nnReader, profiler, inferenceStage );
                 for( size_t dist = 0; dist < histInfoVector.size(); ++dist ){
                     histogram::fillValue( histograms[ dist ][ fillIndex ].get(), fillValues[ dist ], weight );
                 }
@@ -264,7 +331,9 @@ void analyze( const std::string& modelName, const std::string& deltaM, const std
                 //in case of data fakes fill all uncertainties for nonprompt with nominal values
                 if( event.isData() && ( fillIndex == treeReader.numberOfSamples() ) ){
                     for( size_t dist = 0; dist < histInfoVector.size(); ++dist ){
+                        scaleHistograms[ dist ][ fillIndex ].fill( fillValues[ dist ], weight, nominalScaleWeights );
                         for( const auto& key : shapeUncNames ){
+                            if( key == "scale" ) continue;
                             histogram::fillValue( histogramsUncDown[ key ][ dist ][ fillIndex ].get(), fillValues[ dist ], weight );
                             histogram::fillValue( histogramsUncUp[ key ][ dist ][ fillIndex ].get(), fillValues[ dist ], weight );       
                         }
@@ -278,39 +347,43 @@ void analyze( const std::string& modelName, const std::string& deltaM, const std
             
             //fill JEC down histograms
             if( passSelection( event, "JECDown" ) ){
-                auto fillValues = buildFillingVector( event, "JECDown", massSplitting, nnReader );
+                auto fillValues = buildFillingVector( event, "JECDown", massSplitting, nnReader, profiler, inferenceStage );
+                double weightJECDown = weight * weightVariations.jetVariationRatio( JECDownJets );
                 for( size_t dist = 0; dist < histInfoVector.size(); ++dist ){
-                    histogram::fillValue( histogramsUncDown[ "JEC_" + year ][ dist ][ fillIndex ].get(), fillValues[ dist ], weight );
+                    histogram::fillValue( histogramsUncDown[ "JEC_" + year ][ dist ][ fillIndex ].get(), fillValues[ dist ], weightJECDown );
                 }
             }
 
             //fill JEC up histograms
             if( passSelection( event, "JECUp" ) ){
-                auto fillValues = buildFillingVector( event, "JECUp", massSplitting, nnReader );
+                auto fillValues = buildFillingVector( event, "JECUp", massSplitting, nnReader, profiler, inferenceStage );
+                double weightJECUp = weight * weightVariations.jetVariationRatio( JECUpJets );
                 for( size_t dist = 0; dist < histInfoVector.size(); ++dist ){
-                    histogram::fillValue( histogramsUncUp[ "JEC_" + year ][ dist ][ fillIndex ].get(), fillValues[ dist ], weight );
+                    histogram::fillValue( histogramsUncUp[ "JEC_" + year ][ dist ][ fillIndex ].get(), fillValues[ dist ], weightJECUp );
                 }
             }
 
             //fill JER down histograms
             if( passSelection( event, "JERDown" ) ){
-                auto fillValues = buildFillingVector( event, "JERDown", massSplitting, nnReader );
+                auto fillValues = buildFillingVector( event, "JERDown", massSplitting, nnReader, profiler, inferenceStage );
+                double weightJERDown = weight * weightVariations.jetVariationRatio( JERDownJets );
                 for( size_t dist = 0; dist < histInfoVector.size(); ++dist ){
-                    histogram::fillValue( histogramsUncDown[ "JER_" + year ][ dist ][ fillIndex ].get(), fillValues[ dist ], weight );
+                    histogram::fillValue( histogramsUncDown[ "JER_" + year ][ dist ][ fillIndex ].get(), fillValues[ dist ], weightJERDown );
                 }
             }
 
             //fill JER up histograms
             if( passSelection( event, "JERUp" ) ){
-                auto fillValues = buildFillingVector( event, "JERUp", massSplitting, nnReader );
+                auto fillValues = buildFillingVector( event, "JERUp", massSplitting, nnReader, profiler, inferenceStage );
+                double weightJERUp = weight * weightVariations.jetVariationRatio( JERUpJets );
                 for( size_t dist = 0; dist < histInfoVector.size(); ++dist ){
-                    histogram::fillValue( histogramsUncUp[ "JER_" + year ][ dist ][ fillIndex ].get(), fillValues[ dist ], weight );
+                    histogram::fillValue( histogramsUncUp[ "JER_" + year ][ dist ][ fillIndex ].get(), fillValues[ dist ], weightJERUp );
                 }
             }
 
             //fill unclustered down histograms
             if( passSelection( event, "UnclDown" ) ){
-                auto fillValues = buildFillingVector( event, "UnclDown", massSplitting, nnReader );
+                auto fillValues = buildFillingVector( event, "UnclDown", massSplitting, nnReader, profiler, inferenceStage );
                 for( size_t dist = 0; dist < histInfoVector.size(); ++dist ){
                     histogram::fillValue( histogramsUncDown[ "uncl" ][ dist ][ fillIndex ].get(), fillValues[ dist ], weight );
                 }
@@ -318,7 +391,7 @@ void analyze( const std::string& modelName, const std::string& deltaM, const std
 
             //fill unclustered up histograms 
             if( passSelection( event, "UnclUp" ) ){
-                auto fillValues = buildFillingVector( event, "UnclUp", massSplitting, nnReader );
+                auto fillValues = buildFillingVector( event, "UnclUp", massSplitting, nnReader, profiler, inferenceStage );
                 for( size_t dist = 0; dist < histInfoVector.size(); ++dist ){
                     histogram::fillValue( histogramsUncUp[ "uncl" ][ dist ][ fillIndex ].get(), fillValues[ dist ], weight );
                 }
@@ -326,64 +399,58 @@ void analyze( const std::string& modelName, const std::string& deltaM, const std
             
             //apply nominal selection and compute nominal variables
             if( !passSelection( event, "nominal" ) ) continue;
-            auto fillValues = buildFillingVector( event, "nominal", massSplitting, nnReader );
+            auto fillValues = buildFillingVector( event, "nominal", massSplitting, nnReader, profiler, inferenceStage );
 
-            //fill scale down histograms
-            double weightScaleDown;
+            //fill scale down and up histograms
+            double scaleWeights[ 2 ];
             try{
-                weightScaleDown =  event.generatorInfo().relativeWeight_MuR_0p5_MuF_0p5();
+                scaleWeights[ 0 ] = event.generatorInfo().relativeWeight_MuR_0p5_MuF_0p5();
             } catch( std::out_of_range& ){
-                weightScaleDown = 1.;
-            }
-            for( size_t dist = 0; dist < histInfoVector.size(); ++dist ){
-                histogram::fillValue( histogramsUncDown[ "scale" ][ dist ][ fillIndex ].get(), fillValues[ dist ], weight * weightScaleDown );
+                scaleWeights[ 0 ] = 1.;
             }
-        
-            //fill scale up histograms
-            double weightScaleUp;
             try{
-                weightScaleUp = event.generatorInfo().relativeWeight_MuR_2_MuF_2();
+                scaleWeights[ 1 ] = event.generatorInfo().relativeWeight_MuR_2_MuF_2();
             } catch( std::out_of_range& ){
-                weightScaleUp = 1.;
+                scaleWeights[ 1 ] = 1.;
             }
             for( size_t dist = 0; dist < histInfoVector.size(); ++dist ){
-                histogram::fillValue( histogramsUncUp[ "scale" ][ dist ][ fillIndex ].get(), fillValues[ dist ], weight * weightScaleUp );
+                scaleHistograms[ dist ][ fillIndex ].fill( fillValues[ dist ], weight, scaleWeights, 2 );
             }
 
             //fill pileup down histograms
-            double weightPileupDown = reweighter[ "pileup" ]->weightDown( event ) / reweighter[ "pileup" ]->weight( event );
+            double weightPileupDown = weightVariations.ratioDown( "pileup" );
             for( size_t dist = 0; dist < histInfoVector.size(); ++dist ){
                 histogram::fillValue( histogramsUncDown[ "pileup" ][ dist ][ fillIndex ].get(), fillValues[ dist ], weight * weightPileupDown );
             }
 
             //fill pileup up histograms
-            double weightPileupUp = reweighter[ "pileup" ]->weightUp( event ) / reweighter[ "pileup" ]->weight( event );
+            double weightPileupUp = weightVariations.ratioUp( "pileup" );
             for( size_t dist = 0; dist < histInfoVector.size(); ++dist ){
                 histogram::fillValue( histogramsUncUp[ "pileup" ][ dist ][ fillIndex ].get(), fillValues[ dist ], weight * weightPileupUp );
             }
 
             //fill b-tag down histograms
             //WARNING : THESE SHOULD ACTUALLY BE SPLIT BETWEEN HEAVY AND LIGHT FLAVORS
-            double weightBTagDown = reweighter[ "bTag" ]->weightDown( event ) / reweighter[ "bTag" ]->weight( event );
+            double weightBTagDown = weightVariations.ratioDown( "bTag_heavy" ) * weightVariations.ratioDown( "bTag_light" );
             for( size_t dist = 0; dist < histInfoVector.size(); ++dist ){
                 histogram::fillValue( histogramsUncDown[ "bTag_" + year ][ dist ][ fillIndex ].get(), fillValues[ dist ], weight * weightBTagDown );
             }
 
             //fill b-tag up histograms
             //WARNING : THESE SHOULD ACTUALLY BE SPLIT BETWEEN HEAVY AND LIGHT FLAVORS
-            double weightBTagUp = reweighter[ "bTag" ]->weightUp( event ) / reweighter[ "bTag" ]->weight( event );
+            double weightBTagUp = weightVariations.ratioUp( "bTag_heavy" ) * weightVariations.ratioUp( "bTag_light" );
             for( size_t dist = 0; dist < histInfoVector.size(); ++dist ){
                 histogram::fillValue( histogramsUncUp[ "bTag_" + year ][ dist ][ fillIndex ].get(), fillValues[ dist ], weight * weightBTagUp );
             }
 
             //fill prefiring down histograms
-            double weightPrefireDown = reweighter[ "prefire" ]->weightDown( event ) / reweighter[ "prefire" ]->weight( event );
+            double weightPrefireDown = weightVariations.ratioDown( "prefire" );
             for( size_t dist = 0; dist < histInfoVector.size(); ++dist ){
                 histogram::fillValue( histogramsUncDown[ "prefire" ][ dist ][ fillIndex ].get(), fillValues[ dist ], weight * weightPrefireDown );
             }
         
             //fill prefiring up histograms
-            double weightPrefireUp = reweighter[ "prefire" ]->weightUp( event ) / reweighter[ "prefire" ]->weight( event );
+            double weightPrefireUp = weightVariations.ratioUp( "prefire" );
             for( size_t dist = 0; dist < histInfoVector.size(); ++dist ){
                 histogram::fillValue( histogramsUncUp[ "prefire" ][ dist ][ fillIndex ].get(), fillValues[ dist ], weight * weightPrefireUp );
             }
@@ -391,11 +458,11 @@ void analyze( const std::string& modelName, const std::string& deltaM, const std
             double recoWeightDown;
             double recoWeightUp;
             if( !event.is2018() ){
-                recoWeightDown = reweighter[ "electronReco_pTBelow20" ]->weightDown( event ) * reweighter[ "electronReco_pTAbove20" ]->weightDown( event ) / ( reweighter[ "electronReco_pTBelow20" ]->weight( event ) * reweighter[ "electronReco_pTAbove20" ]->weight( event ) );
-                recoWeightUp = reweighter[ "electronReco_pTBelow20" ]->weightUp( event ) * reweighter[ "electronReco_pTAbove20" ]->weightUp( event ) / ( reweighter[ "electronReco_pTBelow20" ]->weight( event ) * reweighter[ "electronReco_pTAbove20" ]->weight( event ) );
+                recoWeightDown = weightVariations.ratioDown( "electronReco_pTBelow20" ) * weightVariations.ratioDown( "electronReco_pTAbove20" );
+                recoWeightUp = weightVariations.ratioUp( "electronReco_pTBelow20" ) * weightVariations.ratioUp( "electronReco_pTAbove20" );
             } else {
-                recoWeightDown = reweighter[ "electronReco" ]->weightDown( event ) / ( reweighter[ "electronReco" ]->weight( event ) );
-                recoWeightUp = reweighter[ "electronReco" ]->weightUp( event ) / ( reweighter[ "electronReco" ]->weight( event ) );
+                recoWeightDown = weightVariations.ratioDown( "electronReco" );
+                recoWeightUp = weightVariations.ratioUp( "electronReco" );
             }
 
             //fill lepton reco down histograms 
@@ -408,8 +475,8 @@ void analyze( const std::string& modelName, const std::string& deltaM, const std
                 histogram::fillValue( histogramsUncUp[ "lepton_reco" ][ dist ][ fillIndex ].get(), fillValues[ dist ], weight * recoWeightUp );
             }
 
-            double leptonIDWeightDown = reweighter[ "muonID" ]->weightDown( event ) * reweighter[ "electronID" ]->weightDown( event ) / ( reweighter[ "muonID" ]->weight( event ) * reweighter[ "electronID" ]->weight( event ) );
-            double leptonIDWeightUp = reweighter[ "muonID" ]->weightUp( event ) * reweighter[ "electronID" ]->weightUp( event ) / ( reweighter[ "muonID" ]->weight( event ) * reweighter[ "electronID" ]->weight( event ) );
+            double leptonIDWeightDown = weightVariations.ratioDown( "muonID" ) * weightVariations.ratioDown( "electronID" );
+            double leptonIDWeightUp = weightVariations.ratioUp( "muonID" ) * weightVariations.ratioUp( "electronID" );
 
             //fill lepton id down histograms
             for( size_t dist = 0; dist < histInfoVector.size(); ++dist ){
@@ -423,6 +490,18 @@ void analyze( const std::string& modelName, const std::string& deltaM, const std
         }
     }
 
+    //print the timing and cut-flow of every sample if profiling was requested
+    profiler.printSummary();
+
+    //make the scale histograms
+    for( size_t dist = 0; dist < histInfoVector.size(); ++dist ){
+        for( size_t p = 0; p < sampleVec.size() + 1; ++p ){
+            std::string histName = histInfoVector[ dist ].name() + "_" + ( p < sampleVec.size() ? sampleVec[p].uniqueName() : "nonprompt" ) + "scale";
+            histogramsUncDown[ "scale" ][ dist ][ p ] = scaleHistograms[ dist ][ p ].makeVariationHistogram( 0, histName + "Down" );
+            histogramsUncUp[ "scale" ][ dist ][ p ] = scaleHistograms[ dist ][ p ].makeVariationHistogram( 1, histName + "Up" );
+        }
+    }
+
     //set negative contributions to zero
     for( size_t dist = 0; dist < histInfoVector.size(); ++dist ){
         
@@ -616,11 +695,13 @@ void analyze( const std::string& modelName, const std::string& deltaM, const std
 
 
 void analyzeAllMasses( const std::string& modelName, const std::string& year, const std::string& controlRegion, const std::string& sampleDirectoryPath ){
-    TreeReader treeReader( "sampleLists/samples_" + modelName + "_" + year + ".txt", sampleDirectoryPath );
+    const std::string sampleListPath = "sampleLists/samples_" + modelName + "_" + year + ".txt";
+    TreeReader treeReader( sampleListPath, sampleDirectoryPath );
+    SampleMetadataIndex metadataIndex( treeReader.sampleVector(), SampleMetadataIndex::defaultIndexPath( sampleListPath ) );
     SusyScan susyScan;
     for( const auto& sample : treeReader.sampleVector() ){
         if( sample.isNewPhysicsSignal() ){
-            susyScan.addScan( sample );
+            susyScan.addScan( sample, metadataIndex );
         }
     }
 
@@ -645,13 +726,14 @@ int main( int argc, char* argv[] ){
     const std::string sampleDirectoryPath = "/pnfs/iihe/cms/store/user/wverbeke/ntuples_ewkino/";
     std::vector< std::string > argvStr( &argv[0], &argv[0] + argc );
     
-    //run specific model and mass splitting and year
+    //run specific model and mass splitting and year, an additional argument 'profile' prints the timing of the event loop
     if( argc > 4 ){
         std::string model = argvStr[1];
         std::string deltaM = argvStr[2];
         std::string year = argvStr[3];
         std::string controlRegion = argvStr[4];
-        analyze( model, deltaM, year, controlRegion, sampleDirectoryPath );
+        bool profile = ( argc > 5 && argvStr[5] == "profile" );
+        analyze( model, deltaM, year, controlRegion, sampleDirectoryPath, profile );
 
     } else if( argc == 4 ){
         std::string model = argvStr[1];
@@ -6,11 +6,15 @@
 
 //include other parts of framework
 #include "../../Event/interface/Event.h"
+#include "../../weights/interface/transferFactors.h"
 
 namespace ewkino{
     void applyBaselineObjectSelection( Event& event, const bool allowUncertainties = false );
     bool passLowMllVeto( const Event& event, const double vetoValue = 12. );
     bool passBaselineSelection( Event& event, const bool allowUncertainties = false, const bool bVeto = true, const bool mllVeto = true );
+
+    //the event-level part of passBaselineSelection, for events on which applyBaselineObjectSelection was already called
+    bool passBaselineEventSelection( Event& event, const bool allowUncertainties = false, const bool bVeto = true, const bool mllVeto = true );
     JetCollection variedJetCollection( const Event& event, const std::string& uncertainty );
     JetCollection::size_type numberOfVariedBJets( const Event& event, const std::string& uncertainty );
     Met variedMet( const Event& event, const std::string& uncertainty );
@@ -24,6 +28,8 @@ namespace ewkino{
     bool leptonsArePrompt( const Event& event );
     bool leptonsAreTight( const Event& event );
     double fakeRateWeight( const Event& event, const std::shared_ptr< TH2 >& muonMap, const std::shared_ptr< TH2 >& electronMap );
+    double fakeRateWeight( const Event& event, const LookupTable2D& muonMap, const LookupTable2D& electronMap );
+    void fakeRateWeights( const Event& event, const LookupTable2D& muonMap, const LookupTable2D& electronMap, std::vector< double >& weights );
     bool passPhotonOverlapRemoval( const Event& event );
 }
 
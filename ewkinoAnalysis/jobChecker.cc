@@ -6,6 +6,7 @@
 #include "../Tools/interface/stringTools.h"
 #include "../Tools/interface/systemTools.h"
 #include "../Tools/interface/SusyScan.h"
+#include "../Tools/interface/SampleMetadataIndex.h"
 #include "../Tools/interface/analysisTools.h"
 #include "../Tools/interface/Sample.h"
 
@@ -48,10 +49,12 @@ std::vector< unsigned > getMassSplittings( const std::string& modelName, const s
     auto sampleList = readSampleList( sampleListFilePath, sampleDirectoryPath );
 
     //use sampleList to make a SusyScan containing all the available mass splittings 
+    //the mass points are taken from the metadata index, so only new or changed files are opened
+    SampleMetadataIndex metadataIndex( sampleList, SampleMetadataIndex::defaultIndexPath( sampleListFilePath ) );
     SusyScan susyScan;
     for( const auto& sample : sampleList ){
         if( sample.isNewPhysicsSignal() ){
-            susyScan.addScan( sample );
+            susyScan.addScan( sample, metadataIndex );
         }
     }
     return susyScan.massSplittings();
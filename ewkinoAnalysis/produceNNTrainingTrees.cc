@@ -1,48 +1,58 @@
 
 
 //include c++ library classes
+#include <algorithm>
 
-//include ROOT classes 
+//include ROOT classes
 #include "TTree.h"
 
 //include general parts of framework
 #include "../Tools/interface/analysisTools.h"
 #include "../Tools/interface/systemTools.h"
 #include "../Tools/interface/stringTools.h"
+#include "../Tools/interface/TrainingTreeWriter.h"
 
 //include ewkino specific code
 #include "interface/ewkinoSelection.h"
 #include "interface/ewkinoCategorization.h"
 
 
-void produceNNTrainingTrees( const std::string& year, const std::string& sampleDirectoryPath ){
+//each sample is split in shards of this many entries
+//the shard boundaries only depend on this number and the number of entries in the sample, so a rerun always produces the same shards
+const long unsigned entriesPerShard = 2000000;
 
-	analysisTools::checkYearString( year );
 
-    //map which will contain the training variables
-    std::map< std::string, float > trainingVariables = {
-        { "metPt", 0. },
-        { "mllBestZ", 0. },
-        { "mt", 0. },
-        { "LTPlusMET", 0. },
-        { "m3l", 0. },
-        { "mt3l", 0. },
-        { "HT", 0. },
-        { "eventWeight", 0. }
-    };
+unsigned numberOfShards( const long unsigned numberOfEntries ){
+    return std::max( static_cast< unsigned >( ( numberOfEntries + entriesPerShard - 1 ) / entriesPerShard ), 1u );
+}
 
-    //make output directory for training files
-    std::string outputDirectory = "trainingFiles_" + year;
-    systemTools::makeDirectory( outputDirectory );
 
-    //build TreeReader and loop over samples
-    TreeReader treeReader( "sampleLists/samples_NNTraining_" + year + ".txt", sampleDirectoryPath );
+std::string outputDirectoryName( const std::string& year ){
+    return "trainingFiles_" + year;
+}
+
+
+std::string shardFileName( const std::string& year, const std::string& sampleUniqueName, const unsigned shardIndex ){
+    return stringTools::formatDirectoryName( outputDirectoryName( year ) ) + "trainingFile_" + sampleUniqueName + "_shard" + std::to_string( shardIndex );
+}
+
+
+//the marker is only made after the shard's files are completely written, so an interrupted shard is redone
+std::string completionMarkerName( const std::string& year, const std::string& sampleUniqueName, const unsigned shardIndex ){
+    return shardFileName( year, sampleUniqueName, shardIndex ) + ".done";
+}
+
+
+bool shardIsComplete( const std::string& year, const std::string& sampleUniqueName, const unsigned shardIndex ){
+    return systemTools::fileExists( completionMarkerName( year, sampleUniqueName, shardIndex ) );
+}
 
 
-    //use several WZTo3LNu samples at the same time for more statistics
-    //to make sure the relative weights to other samples are correct, each sample must be weighted by its sum of weights divided by the total sum of weights of all 3 WZ samples
+//use several WZTo3LNu samples at the same time for more statistics
+//to make sure the relative weights to other samples are correct, each sample must be weighted by its sum of weights divided by the total sum of weights of all 3 WZ samples
+std::map< std::string, double > computeWZWeightModifier( TreeReader& treeReader, const std::string& sampleDirectoryPath ){
     std::map< std::string, double > WZWeightModifier;
-    double totalSumOfWeights = 0.; 
+    double totalSumOfWeights = 0.;
     for( unsigned sampleIndex = 0; sampleIndex < treeReader.numberOfSamples(); ++sampleIndex ){
         if( !stringTools::stringContains( treeReader.sampleVector()[sampleIndex].fileName(), "WZTo3LNu" ) ) continue;
         treeReader.initSampleFromFile( stringTools::formatDirectoryName( sampleDirectoryPath ) + treeReader.sampleVector()[sampleIndex].fileName() );
@@ -50,7 +60,7 @@ void produceNNTrainingTrees( const std::string& year, const std::string& sampleD
         //sum of weights
         double sumOfWeights = dynamic_cast< TH1D* >( treeReader.currentFilePtr()->Get("blackJackAndHookers/hCounter") )->GetSumOfWeights();
 
-        //determine weight scale 
+        //determine weight scale
         treeReader.GetEntry(0);
         double weightScale = fabs( treeReader._weight );
 
@@ -61,92 +71,163 @@ void produceNNTrainingTrees( const std::string& year, const std::string& sampleD
     for( const auto& entry : WZWeightModifier ){
         WZWeightModifier[ entry.first ] /= totalSumOfWeights;
     }
+    return WZWeightModifier;
+}
 
-    for( unsigned sampleIndex = 0; sampleIndex < treeReader.numberOfSamples(); ++sampleIndex ){
-        treeReader.initSample();
 
-        //skip data 
-        if( treeReader.isData() ) continue;
+bool passTrainingSelection( Event& event ){
 
-        std::string treeName;
+    //ignore taus
+    event.removeTaus();
 
-        //add parameter for signal
-        if( treeReader.isSusy() ){
-            trainingVariables["susyMassSplitting"] = 0.;
-            treeName = "signalTree";
-        } else {
-            treeName = "backgroundTree";
-        }
+    if( !ewkino::passBaselineSelection( event, false, true, false ) ) return false;
 
-        //make training tree for the current sample
-        std::cout << "Sample : treeReader.currentSample().uniqueName() = " << treeReader.currentSample().uniqueName() << std::endl;
-        TFile* trainingFile = TFile::Open( ( stringTools::formatDirectoryName( outputDirectory ) + "trainingFile_" + treeReader.currentSample().uniqueName()  + ".root" ).c_str(), "RECREATE" );
-        TTree* trainingTree = new TTree( treeName.c_str(), treeName.c_str() );
-        for( const auto& entry : trainingVariables ){
-            trainingTree->Branch( entry.first.c_str(), &trainingVariables[ entry.first ], ( entry.first + "/F" ).c_str() );
-        }
+    //met requirement
+    if( event.metPt() < 50 ) return false;
 
-        for( long unsigned entry = 0; entry < treeReader.numberOfEntries(); ++entry ){
-            Event event = treeReader.buildEvent( entry );
+    //lepton pT cuts
+    if( !ewkino::passPtCuts( event ) ) return false;
+
+    //veto fourth lepton
+    if( event.numberOfLightLeptons() != 3 ) return false;
+
+    //select tight leptons and require OSSF pair
+    event.selectTightLeptons();
+    if( event.numberOfLightLeptons() != 3 ) return false;
+    if( !event.hasOSSFLightLeptonPair() ) return false;
+
+    if( !ewkino::passPhotonOverlapRemoval( event ) ) return false;
+    return true;
+}
+
+
+//write the training tree for one shard of the sample that is currently initialized in the TreeReader
+void produceNNTrainingTreeShard( TreeReader& treeReader, const std::string& year, const unsigned shardIndex, const std::map< std::string, double >& WZWeightModifier ){
+    const std::string sampleName = treeReader.currentSample().uniqueName();
+    if( shardIndex >= numberOfShards( treeReader.numberOfEntries() ) ){
+        throw std::invalid_argument( "Shard " + std::to_string( shardIndex ) + " does not exist for sample " + sampleName + " with " + std::to_string( treeReader.numberOfEntries() ) + " entries." );
+    }
+    if( shardIsComplete( year, sampleName, shardIndex ) ){
+        std::cout << "Shard " << shardIndex << " of sample " << sampleName << " is already complete, skipping it." << std::endl;
+        return;
+    }
+
+    //training variables, the order of this list is the order of the buffer in TrainingTreeWriter
+    enum trainingVariable { metPt, mllBestZ, mtW, LTPlusMET, m3l, mt3l, HT, eventWeight, susyMassSplitting };
+    std::vector< std::string > variableNames = { "metPt", "mllBestZ", "mt", "LTPlusMET", "m3l", "mt3l", "HT", "eventWeight", "susyMassSplitting" };
 
-            //ignore taus
-            event.removeTaus();
+    //the mass splitting is only a parameter for signal
+    std::string treeName;
+    if( treeReader.isSusy() ){
+        treeName = "signalTree";
+    } else {
+        variableNames.pop_back();
+        treeName = "backgroundTree";
+    }
 
-            if( !ewkino::passBaselineSelection( event, false, true, false ) ) continue;
+    //modifier for WZ to combine samples
+    double weightModifier = 1.;
+    if( stringTools::stringContains( treeReader.currentSample().fileName(), "WZTo3LNu_" ) ){
+        auto modifierIt = WZWeightModifier.find( sampleName );
+        weightModifier = ( modifierIt == WZWeightModifier.cend() ) ? 0. : modifierIt->second;
+    }
 
-            //met requirement 
-            if( event.metPt() < 50 ) continue;
+    long unsigned firstEntry = shardIndex * entriesPerShard;
+    long unsigned lastEntry = std::min( firstEntry + entriesPerShard, treeReader.numberOfEntries() );
+    std::cout << "Sample : " << sampleName << ", shard " << shardIndex << " : entries " << firstEntry << " to " << lastEntry << std::endl;
 
-            //lepton pT cuts
-            if( !ewkino::passPtCuts( event ) ) continue;
+    //make training tree for the current shard, and a columnar copy for direct use in the training scripts
+    {
+        std::string trainingFileName = shardFileName( year, sampleName, shardIndex );
+        TrainingTreeWriter trainingTree( trainingFileName + ".root", treeName, variableNames, trainingFileName + ".columns" );
 
-            //veto fourth lepton
-            if( event.numberOfLightLeptons() != 3 ) continue;
-            
-            //select tight leptons and require OSSF pair
-            event.selectTightLeptons();
-            if( event.numberOfLightLeptons() != 3 ) continue;
-            if( !event.hasOSSFLightLeptonPair() ) continue;
+        for( long unsigned entry = firstEntry; entry < lastEntry; ++entry ){
+            Event event = treeReader.buildEvent( entry );
 
-            if( !ewkino::passPhotonOverlapRemoval( event ) ) continue;
+            if( !passTrainingSelection( event ) ) continue;
 
-            //veto b jets
-            trainingVariables.at("metPt") = event.metPt();
-            trainingVariables.at("mllBestZ") = event.bestZBosonCandidateMass();
-            trainingVariables.at("mt") = event.mtW();
-            trainingVariables.at("LTPlusMET") = ( event.LT() + event.metPt() );
+            trainingTree[ metPt ] = event.metPt();
+            trainingTree[ mllBestZ ] = event.bestZBosonCandidateMass();
+            trainingTree[ mtW ] = event.mtW();
+            trainingTree[ LTPlusMET ] = ( event.LT() + event.metPt() );
             PhysicsObject leptonSum = event.leptonCollection().objectSum();
-            trainingVariables.at("m3l") = leptonSum.mass();
-            trainingVariables.at("mt3l") = mt( leptonSum, event.met() );
-            trainingVariables.at("HT") = event.jetCollection().scalarPtSum();
-            
-            trainingVariables.at("eventWeight") = event.weight();
-
-            //modifier for WZ to combine samples
-            if( stringTools::stringContains( event.sample().fileName(), "WZTo3LNu_" ) ){
-                trainingVariables.at("eventWeight") *= WZWeightModifier[ event.sample().uniqueName() ];
-            }
+            trainingTree[ m3l ] = leptonSum.mass();
+            trainingTree[ mt3l ] = mt( leptonSum, event.met() );
+            trainingTree[ HT ] = event.jetCollection().scalarPtSum();
+            trainingTree[ eventWeight ] = event.weight() * weightModifier;
 
             if( treeReader.isSusy() ){
-                trainingVariables.at("susyMassSplitting") = ( event.susyMassInfo().massNLSP() - event.susyMassInfo().massLSP() );
+                trainingTree[ susyMassSplitting ] = ( event.susyMassInfo().massNLSP() - event.susyMassInfo().massLSP() );
+            }
+            trainingTree.fill();
+        }
+    }
+
+    //mark the shard as complete once its files are closed
+    systemTools::makeFile( completionMarkerName( year, sampleName, shardIndex ) );
+}
+
+
+//process the given shard of the given sample, or all unfinished shards of all samples if no sample index is given
+void produceNNTrainingTrees( const std::string& year, const std::string& sampleDirectoryPath, const int sampleIndexToProcess = -1, const int shardIndexToProcess = -1 ){
+
+	analysisTools::checkYearString( year );
+
+    //make output directory for training files
+    systemTools::makeDirectory( outputDirectoryName( year ) );
+
+    //build TreeReader and loop over samples
+    TreeReader treeReader( "sampleLists/samples_NNTraining_" + year + ".txt", sampleDirectoryPath );
+    std::map< std::string, double > WZWeightModifier = computeWZWeightModifier( treeReader, sampleDirectoryPath );
+
+    std::vector< Sample > sampleVector = treeReader.sampleVector();
+    for( unsigned sampleIndex = 0; sampleIndex < sampleVector.size(); ++sampleIndex ){
+        if( sampleIndexToProcess >= 0 && static_cast< unsigned >( sampleIndexToProcess ) != sampleIndex ) continue;
+
+        //skip data
+        if( sampleVector[ sampleIndex ].isData() ) continue;
+
+        treeReader.initSample( sampleVector[ sampleIndex ] );
+        if( shardIndexToProcess >= 0 ){
+            produceNNTrainingTreeShard( treeReader, year, static_cast< unsigned >( shardIndexToProcess ), WZWeightModifier );
+        } else {
+            for( unsigned shardIndex = 0; shardIndex < numberOfShards( treeReader.numberOfEntries() ); ++shardIndex ){
+                produceNNTrainingTreeShard( treeReader, year, shardIndex, WZWeightModifier );
             }
-            trainingTree->Fill();
         }
-        trainingFile->Write();
-        trainingFile->Close();
+    }
+}
+
+
+//submit one job for every shard that is not complete yet
+void submitNNTrainingTreeJobs( const std::string& year, const std::string& sampleDirectoryPath ){
+    TreeReader treeReader( "sampleLists/samples_NNTraining_" + year + ".txt", sampleDirectoryPath );
+    std::vector< Sample > sampleVector = treeReader.sampleVector();
+    for( unsigned sampleIndex = 0; sampleIndex < sampleVector.size(); ++sampleIndex ){
+        if( sampleVector[ sampleIndex ].isData() ) continue;
+        treeReader.initSample( sampleVector[ sampleIndex ] );
+        for( unsigned shardIndex = 0; shardIndex < numberOfShards( treeReader.numberOfEntries() ); ++shardIndex ){
+            if( shardIsComplete( year, treeReader.currentSample().uniqueName(), shardIndex ) ) continue;
+            std::string command = "./produceNNTrainingTrees " + year + " " + std::to_string( sampleIndex ) + " " + std::to_string( shardIndex );
+            std::string scriptName = "produceNNTrainingTrees_" + year + "_" + std::to_string( sampleIndex ) + "_" + std::to_string( shardIndex ) + ".sh";
+            systemTools::submitCommandAsJob( command, scriptName, "24:00:00" );
+        }
     }
 }
 
 
 int main( int argc, char* argv[] ){
     std::vector< std::string > argvStr( &argv[0], &argv[0] + argc );
+    const std::string sampleDirectoryPath = "/user/wverbeke/Work/ntuples_ewkino_new/";
     if( argc == 2 ){
         std::string year = argvStr[1];
-        produceNNTrainingTrees( year, "/user/wverbeke/Work/ntuples_ewkino_new/" );
+        produceNNTrainingTrees( year, sampleDirectoryPath );
+    } else if( argc == 4 ){
+        std::string year = argvStr[1];
+        produceNNTrainingTrees( year, sampleDirectoryPath, std::stoi( argvStr[2] ), std::stoi( argvStr[3] ) );
     } else {
         for( const auto& year : { "2016", "2017", "2018" } ){
-            std::string command = std::string( "./produceNNTrainingTrees " ) + year;
-            systemTools::submitCommandAsJob( command, std::string( "produceNNTrainingTrees_" ) + year + ".sh", "169:00:00" );
+            submitNNTrainingTreeJobs( year, sampleDirectoryPath );
         }
     }
     return 0;
@@ -45,8 +45,12 @@ bool ewkino::passLowMllVeto( const Event& event, const double vetoValue ){
 
 
 bool ewkino::passBaselineSelection( Event& event, const bool allowUncertainties, const bool bVeto, const bool mllVeto ){
-    
     applyBaselineObjectSelection( event, allowUncertainties );
+    return passBaselineEventSelection( event, allowUncertainties, bVeto, mllVeto );
+}
+
+
+bool ewkino::passBaselineEventSelection( Event& event, const bool allowUncertainties, const bool bVeto, const bool mllVeto ){
     if( event.numberOfLeptons() < 3 ) return false;
     if( mllVeto && !passLowMllVeto( event, 12 ) ) return false;
     event.selectFOLeptons();
@@ -279,15 +283,17 @@ bool ewkino::passPhotonOverlapRemoval( const Event& event ){
 }
 
 
-double ewkino::fakeRateWeight( const Event& event, const std::shared_ptr< TH2 >& muonMap, const std::shared_ptr< TH2 >& electronMap ){
-    static constexpr double maxPt = 44.;
+//leptons with a higher pt use the fake rate at 44 GeV
+static constexpr double fakeRateMaxPt = 44.;
+
 
+double ewkino::fakeRateWeight( const Event& event, const std::shared_ptr< TH2 >& muonMap, const std::shared_ptr< TH2 >& electronMap ){
     double weight = -1.;
     for( const auto& leptonPtr : event.leptonCollection() ){
         if( !leptonPtr->isFO() ) continue;
         if( leptonPtr->isTight() ) continue;
         double fr;
-        double pt = std::min( leptonPtr->pt(), maxPt );
+        double pt = std::min( leptonPtr->pt(), fakeRateMaxPt );
         if( leptonPtr->isMuon() ){
             fr = histogram::contentAtValues( muonMap.get(), pt, leptonPtr->absEta() );
         } else if( leptonPtr->isElectron() ){
@@ -299,3 +305,13 @@ double ewkino::fakeRateWeight( const Event& event, const std::shared_ptr< TH2 >&
     }
     return weight;
 }
+
+
+double ewkino::fakeRateWeight( const Event& event, const LookupTable2D& muonMap, const LookupTable2D& electronMap ){
+    return transferFactors::fakeRateWeight( event, muonMap, electronMap, fakeRateMaxPt );
+}
+
+
+void ewkino::fakeRateWeights( const Event& event, const LookupTable2D& muonMap, const LookupTable2D& electronMap, std::vector< double >& weights ){
+    transferFactors::fakeRateWeights( event, muonMap, electronMap, weights, fakeRateMaxPt );
+}
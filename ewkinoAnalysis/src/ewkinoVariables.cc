@@ -1,7 +1,6 @@
 #include "../interface/ewkinoVariables.h"
 
 //include c++ library classes
-#include <stdexcept>
 
 //include other parts of framework
 #include "../interface/ewkinoSelection.h"
@@ -12,10 +11,10 @@ std::map< std::string, double > ewkino::computeVariables( Event& event, const st
     JetCollection variedJetCollection = ewkino::variedJetCollection( event, unc );
     PhysicsObject leptonSum = event.leptonCollection().objectSum();
     double mll, mtW;
-    try{
+    if( event.hasZBosonCandidate() ){
         mll = event.bestZBosonCandidateMass();
         mtW = mt( event.WLepton(), variedMet ); 
-    } catch( std::domain_error& ){
+    } else {
         mll = ( event.lepton( 0 ) + event.lepton( 1 ) ).mass();
         mtW = mt( event.lepton( 2 ), variedMet );
     }
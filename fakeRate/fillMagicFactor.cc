@@ -51,6 +51,8 @@ void determineMagicFactor( const std::string& leptonFlavor, const std::string& y
     // make tree reader and set to correct sample
     std::cout << "creating TreeReader and setting to sample no. " << sampleIndex << std::endl;
     TreeReader treeReader( sampleList, sampleDirectory );
+    //no scale, pdf or parton shower variations are used here
+    treeReader.setReadGeneratorWeights( false );
     treeReader.initSample();
     for( unsigned i=1; i<=sampleIndex; ++i){
         treeReader.initSample();
@@ -73,6 +73,8 @@ void fillTuneFOSelection( const std::string& leptonFlavor, const std::string& ye
     // create TreeReader and set to right sample
     std::cout << "initializing TreeReader and setting to sample no. " << sampleIndex << std::endl;
     TreeReader treeReader( sampleList, sampleDirectory );
+    //no scale, pdf or parton shower variations are used here
+    treeReader.setReadGeneratorWeights( false );
     treeReader.initSample();
     for( unsigned i = 1; i <= sampleIndex; ++i ){
         treeReader.initSample();
@@ -1,6 +1,9 @@
 // include header
 #include "../interface/fakeRateMeasurementTools.h"
 
+// include other parts of framework
+#include "../../Tools/interface/histogramTools.h"
+
 // help function for creating a 2D histogram map
 RangedMap< RangedMap< std::shared_ptr< TH1D > > > build2DHistogramMap( 
     const std::vector< double >& ptBinBorders, const std::vector< double >& etaBinBorders, 
@@ -104,6 +107,8 @@ void fillFakeRateMeasurementHistograms(const std::string& leptonFlavor, const st
     // initialize TreeReader and set to correct sample
     std::cout<<"initializing TreeReader and setting to sample n. "<<sampleIndex<<std::endl;
     TreeReader treeReader( sampleList , sampleDirectory );
+    //no scale, pdf or parton shower variations are used here
+    treeReader.setReadGeneratorWeights( false );
     treeReader.initSample();
     for(unsigned idx=1; idx<=sampleIndex; ++idx){
         treeReader.initSample();
@@ -324,6 +329,8 @@ void fillMCFakeRateMeasurementHistograms( const std::string& flavor, const std::
     // make TreeReader and set to correct sample
     std::cout<<"making TreeReader and setting to sample no. "<<sampleIndex<<"."<<std::endl;
     TreeReader treeReader( sampleList, sampleDirectory );
+    //no scale, pdf or parton shower variations are used here
+    treeReader.setReadGeneratorWeights( false );
     treeReader.initSample();
     for( unsigned i = 1; i <= sampleIndex; ++i ){
         treeReader.initSample();
@@ -47,6 +47,8 @@ void fillPrescaleMeasurementHistograms( const std::string& year,
     // initialize TreeReader and select correct sample
     std::cout<<"creating TreeReader and set to sample n. "<<sampleIndex<<std::endl;
     TreeReader treeReader( sampleListPath, sampleDirectoryPath);
+    //no scale, pdf or parton shower variations are used here
+    treeReader.setReadGeneratorWeights( false );
     treeReader.initSample();
     for(unsigned idx=1; idx<=sampleIndex; ++idx){
         treeReader.initSample();
@@ -76,6 +78,12 @@ void fillPrescaleMeasurementHistograms( const std::string& year,
     CombinedReweighter reweighter = reweighterFactory->buildReweighter( "../weights/",
                                                         year, treeReader.sampleVector() );
     
+    // resolve the triggers once for this sample, so checking them in the event loop is a single bit test
+    std::vector< std::size_t > triggerIndices;
+    for( const auto& trigger : triggerVector ){
+        triggerIndices.push_back( treeReader.triggerIndex( trigger ) );
+    }
+
     //long unsigned numberOfEntries = 500000;
     long unsigned numberOfEntries = treeReader.numberOfEntries();
     std::cout<<"start event loop for "<<numberOfEntries<<" events"<<std::endl;
@@ -97,8 +105,9 @@ void fillPrescaleMeasurementHistograms( const std::string& year,
         if( !isData ) weight *= reweighter.totalWeight( event );
         else weight = 1;
 
-        for( const auto& trigger : triggerVector ){
-            if( !event.passTrigger( trigger ) ) continue;
+        for( std::size_t triggerNumber = 0; triggerNumber < triggerVector.size(); ++triggerNumber ){
+            const std::string& trigger = triggerVector[ triggerNumber ];
+            if( !event.passTrigger( triggerIndices[ triggerNumber ] ) ) continue;
             if( stringTools::stringContains( trigger, "Mu" ) ){
                     if( !lepton.isMuon() ) continue;
             } else if( stringTools::stringContains( trigger, "Ele" ) ){
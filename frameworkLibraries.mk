@@ -0,0 +1,9 @@
+#flags to link an executable against the shared libraries built with makeLibraries
+#set FRAMEWORK_DIR to the path of the framework's top directory before including this file
+#the libraries are found at run time through the rpath, so LD_LIBRARY_PATH does not have to be set
+#the executable is built in the configuration given by BUILD (see buildConfigurations.mk), for which the libraries must have been built as well
+
+include $(FRAMEWORK_DIR)/buildConfigurations.mk
+
+FRAMEWORK_LIBDIR=$(abspath $(FRAMEWORK_DIR)/lib$(BUILD_SUBDIRECTORY))
+FRAMEWORK_LIBS= $(BUILD_FLAGS) -L$(FRAMEWORK_LIBDIR) -lweights -lTreeReader -lEvent -lobjectSelection -lobjects -lplotting -lTools -Wl,-rpath,$(FRAMEWORK_LIBDIR)
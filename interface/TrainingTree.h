@@ -32,7 +32,8 @@ class TrainingTree{
     private:
         std::shared_ptr< Category > category;
         std::shared_ptr< Sample > sample;
-        std::map< std::string, float > variableMap;
+        std::vector< std::string > variableNames;
+        std::vector< float > variableValues;
         std::vector< TTree* > trainingTrees;
         TFile* treeFile;
         
@@ -41,9 +42,6 @@ class TrainingTree{
     
         //name of tree, depending on whether the category and whether it is signal
         std::string treeName(const size_t, const bool);
-
-        //fill tree entry in given category's tree
-        void fill(const size_t, const std::map<std::string, float>&);
 };
 
 //merge all training trees in given directory
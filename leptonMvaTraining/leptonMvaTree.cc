@@ -18,7 +18,7 @@
 //include other parts of the code
 #include "../interface/treeReader.h"
 #include "../interface/analysisTools.h"
-#include "../interface/TrainingTree.h"
+#include "../Tools/interface/TrainingTreeWriter.h"
 
 //TEMPORARY
 #include "TMVA/Reader.h"
@@ -70,34 +70,20 @@ void treeReader::Analyze(const std::string& sampleName){
 }
 
 void treeReader::Analyze(const Sample& samp){
-    std::map < std::string, float > trainingVariableMap =
-        {
-            {"pt", 0.},
-            {"eta", 0.},
-            {"trackMultClosestJet", 0.},
-            {"miniIsoCharged", 0.},
-            {"miniIsoNeutral", 0.},
-            {"pTRel", 0.},
-            {"ptRatio", 0.},
-            {"relIso", 0.},
-            {"relIso0p4", 0.},
-            {"csvV2ClosestJet", 0.},
-            {"deepCsvClosestJet", 0.},
-            {"sip3d", 0.},
-            {"dxy", 0.},
-            {"dz", 0.},
-            {"segmentCompatibility", 0.},
-            {"eventWeight", 0.}
-        };
+
+    //training variables, the order of this list is the order of the buffer in TrainingTreeWriter
+    enum trainingVariable { pt, eta, trackMultClosestJet, miniIsoCharged, miniIsoNeutral, pTRel, ptRatio, relIso, relIso0p4, csvV2ClosestJet, deepCsvClosestJet, sip3d, dxy, dz, segmentCompatibility, eventWeight, electronMva };
+    std::vector< std::string > variableNames = { "pt", "eta", "trackMultClosestJet", "miniIsoCharged", "miniIsoNeutral", "pTRel", "ptRatio", "relIso", "relIso0p4", "csvV2ClosestJet", "deepCsvClosestJet", "sip3d", "dxy", "dz", "segmentCompatibility", "eventWeight" };
     if(samp.is2017()){
-        trainingVariableMap["electronMvaFall17NoIso"] = 0.;
+        variableNames.push_back("electronMvaFall17NoIso");
     } else{
-        trainingVariableMap["electronMvaSpring16GP"] = 0.;
+        variableNames.push_back("electronMvaSpring16GP");
     }
 
     //TMVA::PyMethodBase::PyInitialize();
-    TrainingTree muonTree("leptonMvaTraining/muon_", samp, {{""}}, trainingVariableMap, samp.isSMSignal() );
-    TrainingTree electronTree("leptonMvaTraining/electron_", samp, {{""}}, trainingVariableMap, samp.isSMSignal() );
+    const std::string treeName = ( samp.isSMSignal() ? "signalTree" : "backgroundTree" );
+    TrainingTreeWriter muonTree("leptonMvaTraining/muon_" + samp.getUniqueName() + ".root", treeName, variableNames);
+    TrainingTreeWriter electronTree("leptonMvaTraining/electron_" + samp.getUniqueName() + ".root", treeName, variableNames);
 
     initSample(samp, 1);  //use 2017 lumi
 
@@ -124,45 +110,46 @@ void treeReader::Analyze(const Sample& samp){
                     && (_lProvenance[l] != 1)
                     && ( abs(_lMomPdgId[l]) != 15);
                 bool nonPrompt = !_lIsPrompt[l];
+
+                //only fill the tree of this lepton's flavor
+                TrainingTreeWriter* treePtr;
+                if(_lFlavor[l] == 0){
+                    treePtr = &electronTree;
+                } else if(_lFlavor[l] == 1){
+                    treePtr = &muonTree;
+                } else {
+                    continue;
+                }
+                if( !( ( isPrompt && samp.isSMSignal() ) || ( nonPrompt && !samp.isSMSignal() ) ) ) continue;
+                TrainingTreeWriter& tree = *treePtr;
                 
-                trainingVariableMap["pt"] = _lPt[l];
-                trainingVariableMap["eta"] = fabs(_lEta[l]);
-                trainingVariableMap["trackMultClosestJet"] = _selectedTrackMult[l];
-                trainingVariableMap["miniIsoCharged"] = _miniIsoCharged[l];
-                trainingVariableMap["miniIsoNeutral"] = _miniIso[l] - _miniIsoCharged[l];
-                trainingVariableMap["pTRel"] = _ptRel[l];
-                trainingVariableMap["ptRatio"] = std::min(_ptRatio[l], 1.5);
-                trainingVariableMap["relIso"] = _relIso[l];
-                trainingVariableMap["relIso0p4"] = _relIso0p4[l];
-                trainingVariableMap["csvV2ClosestJet"] = std::max(_closestJetCsvV2[l], 0.);
-                trainingVariableMap["deepCsvClosestJet"] = std::isnan(_closestJetDeepCsv_b[l] + _closestJetDeepCsv_bb[l]) ? 0. : std::max(_closestJetDeepCsv_b[l] + _closestJetDeepCsv_bb[l], 0.); 
-                trainingVariableMap["sip3d"] = _3dIPSig[l];
-                trainingVariableMap["dxy"] = log( fabs( _dxy[l] ) );
-                trainingVariableMap["dz"] = log( fabs( _dz[l] ) );
-                trainingVariableMap["segmentCompatibility"] = ( (_lFlavor[l] == 1) ? _lMuonSegComp[l] : 0.);
+                tree[pt] = _lPt[l];
+                tree[eta] = fabs(_lEta[l]);
+                tree[trackMultClosestJet] = _selectedTrackMult[l];
+                tree[miniIsoCharged] = _miniIsoCharged[l];
+                tree[miniIsoNeutral] = _miniIso[l] - _miniIsoCharged[l];
+                tree[pTRel] = _ptRel[l];
+                tree[ptRatio] = std::min(_ptRatio[l], 1.5);
+                tree[relIso] = _relIso[l];
+                tree[relIso0p4] = _relIso0p4[l];
+                tree[csvV2ClosestJet] = std::max(_closestJetCsvV2[l], 0.);
+                tree[deepCsvClosestJet] = std::isnan(_closestJetDeepCsv_b[l] + _closestJetDeepCsv_bb[l]) ? 0. : std::max(_closestJetDeepCsv_b[l] + _closestJetDeepCsv_bb[l], 0.); 
+                tree[sip3d] = _3dIPSig[l];
+                tree[dxy] = log( fabs( _dxy[l] ) );
+                tree[dz] = log( fabs( _dz[l] ) );
+                tree[segmentCompatibility] = ( (_lFlavor[l] == 1) ? _lMuonSegComp[l] : 0.);
                 if(samp.is2017()){
-                    trainingVariableMap["electronMvaFall17NoIso"] = ( (_lFlavor[l] == 0) ? _lElectronMvaFall17NoIso[l] : 0.); 
+                    tree[electronMva] = ( (_lFlavor[l] == 0) ? _lElectronMvaFall17NoIso[l] : 0.); 
                 } else{
-                    trainingVariableMap["electronMvaSpring16GP"] = ( (_lFlavor[l] == 0) ? _lElectronMva[l] : 0.);
-                }
-                trainingVariableMap["eventWeight"] = ( (_weight > 0) ? 1 : -1);
-
-                if(isPrompt && samp.isSMSignal() ){ 
-                    if(_lFlavor[l] == 0){
-                        electronTree.fill( std::vector<size_t>({0}), trainingVariableMap);    
-                    } else if(_lFlavor[l] == 1){
-                        muonTree.fill( std::vector<size_t>({0}), trainingVariableMap);
-                    }
-                } else if(nonPrompt && !samp.isSMSignal() ){
-                    if(_lFlavor[l] == 0){
-                        electronTree.fill(std::vector<size_t>({0}), trainingVariableMap);    
-                    } else if(_lFlavor[l] == 1){
-                        muonTree.fill(std::vector<size_t>({0}), trainingVariableMap);
-                    }
+                    tree[electronMva] = ( (_lFlavor[l] == 0) ? _lElectronMva[l] : 0.);
                 }
+                tree[eventWeight] = ( (_weight > 0) ? 1 : -1);
+                tree.fill();
             }
         }       
     }
+    muonTree.close();
+    electronTree.close();
 }
 
 int main(int argc, char* argv[]){
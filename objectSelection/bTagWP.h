@@ -31,4 +31,9 @@ namespace bTagWP{
     double mediumDeepFlavor2018();
     double tightDeepFlavor2018();
 }
+
+
+//interpolation between loose and medium working point of deep flavor as a function of lepton pT, used in the muon and electron selection
+double slidingDeepFlavorThreshold( const double looseWP, const double mediumWP, const double pt );
+
 #endif
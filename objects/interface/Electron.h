@@ -63,12 +63,12 @@ class Electron : public LightLepton{
         bool _passElectronMVAFall17NoIsoWP80;
 
         //pseudorapidity of the supercluster
-        double _etaSuperCluster = 0;
+        object_float_type _etaSuperCluster = 0;
 
         //cluster id values
-        double _hOverE = 0;
-        double _inverseEMinusInverseP = 0;
-        double _sigmaIEtaEta = 0;
+        object_float_type _hOverE = 0;
+        object_float_type _inverseEMinusInverseP = 0;
+        object_float_type _sigmaIEtaEta = 0;
 
         //cut based POG ID working points (include isolation) 
         bool _isVetoPOGElectron = false;
@@ -3,6 +3,7 @@
 
 //include other parts of code 
 #include "PhysicsObject.h"
+#include "objectPrecision.h"
 #include "../../TreeReader/interface/TreeReader.h"
 //#include "JetSelector.h"
 
@@ -42,6 +43,12 @@ class Jet : public PhysicsObject{
         bool isBTaggedMediumAnyVariation() const;
         bool isBTaggedTightAnyVariation() const;
 
+        //transverse momentum with JEC and JER varied within uncertainties
+        double ptJECDown() const{ return _pt_JECDown; }
+        double ptJECUp() const{ return _pt_JECUp; }
+        double ptJERDown() const{ return _pt_JERDown; }
+        double ptJERUp() const{ return _pt_JERUp; }
+
         //create new Jet with JEC varied within uncertainties
         Jet JetJECDown() const;
         Jet JetJECUp() const;
@@ -55,18 +62,18 @@ class Jet : public PhysicsObject{
         virtual std::ostream& print( std::ostream& ) const override;
 
     private:
-        double _deepCSV = 0;
-        double _deepFlavor = 0;
+        object_float_type _deepCSV = 0;
+        object_float_type _deepFlavor = 0;
         bool _isLoose = false;
         bool _isTight = false;
         bool _isTightLeptonVeto = false;
         unsigned _hadronFlavor = 0;
         
         //JEC uncertainties 
-        double _pt_JECDown = 0;
-        double _pt_JECUp = 0;
-        double _pt_JERDown = 0;
-        double _pt_JERUp = 0;
+        object_float_type _pt_JECDown = 0;
+        object_float_type _pt_JECUp = 0;
+        object_float_type _pt_JERDown = 0;
+        object_float_type _pt_JERUp = 0;
 
         //jet selector 
         JetSelector* selector;
@@ -7,6 +7,7 @@
 
 //include other parts of code 
 #include "PhysicsObject.h"
+#include "objectPrecision.h"
 #include "../../TreeReader/interface/TreeReader.h"
 #include "LeptonGeneratorInfo.h"
 #include "LeptonSelector.h"
@@ -72,9 +73,9 @@ class Lepton : public PhysicsObject {
         int _charge = 0;
     
         //lepton impact parameter variables 
-        double _dxy = 0;
-        double _dz = 0;
-        double _sip3d = 0;
+        object_float_type _dxy = 0;
+        object_float_type _dz = 0;
+        object_float_type _sip3d = 0;
 
         //lepton generator information
         LeptonGeneratorInfo* generatorInfo = nullptr;
@@ -99,7 +100,7 @@ class Lepton : public PhysicsObject {
     protected :
 
         //pT before cone correction
-        double _uncorrectedPt;
+        object_float_type _uncorrectedPt;
 
         Lepton( const Lepton&, LeptonSelector* );
         Lepton( Lepton&&, LeptonSelector* ) noexcept;
@@ -51,22 +51,22 @@ class LightLepton : public Lepton {
     private:
 
         //isolation variables 
-        double _relIso0p3 = 0;
-        double _relIso0p4 = 0;
-        double _miniIso = 0;
-        double _miniIsoCharged = 0;
+        object_float_type _relIso0p3 = 0;
+        object_float_type _relIso0p4 = 0;
+        object_float_type _miniIso = 0;
+        object_float_type _miniIsoCharged = 0;
 
         //properties of the jet closest to the lepton
-        double _ptRatio = 0;
-        double _ptRel = 0;
-        double _closestJetDeepCSV = 0;
-        double _closestJetDeepFlavor = 0;
+        object_float_type _ptRatio = 0;
+        object_float_type _ptRel = 0;
+        object_float_type _closestJetDeepCSV = 0;
+        object_float_type _closestJetDeepFlavor = 0;
         unsigned _closestJetTrackMultiplicity = 0;
 
         //lepton MVA output 
-        double _leptonMVAtZq = 0;
-        double _leptonMVAttH = 0;
-        double _leptonMVATOP = 0;
+        object_float_type _leptonMVAtZq = 0;
+        object_float_type _leptonMVAttH = 0;
+        object_float_type _leptonMVATOP = 0;
 
     protected: 
 
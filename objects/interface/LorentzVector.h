@@ -4,6 +4,19 @@
 //include c++ library classes 
 #include <iostream>
 #include <cmath>
+#include <cstdint>
+
+//include other parts of framework
+#include "objectPrecision.h"
+
+/*
+LorentzVector stores the representation it was built from: (pt, eta, phi, E) for constructed vectors and (px, py, pz, E) for sums.
+The other coordinates are only computed when they are first requested, and cached afterwards.
+Most objects are only used through pt, eta and phi, so the trigonometric and hyperbolic functions are rarely evaluated.
+The caches are filled in const member functions, so a LorentzVector should not be read from several threads at the same time.
+The polar coordinates are stored as object_float_type ( see objectPrecision.h ), while the energy and the cartesian coordinates, into which vectors are summed, are always stored as double.
+This way sums of many objects and the masses of boosted systems do not suffer from rounding in float precision builds.
+*/
 
 class LorentzVector{
 
@@ -21,30 +34,41 @@ class LorentzVector{
         LorentzVector() = default;
         LorentzVector( const double pt, const double eta, const double phi, const double energy );
         
-        double pt() const { return transverseMomentum; }
-        double eta() const { return pseudoRapidity; }
-        double absEta() const{ return std::abs( pseudoRapidity ); }
-        double phi() const { return azimuthalAngle; }
+        double pt() const { if( !isComputed( ptBit ) ) computeTransverseMomentum(); return transverseMomentum; }
+        double eta() const { if( !isComputed( etaBit ) ) computePseudoRapidity(); return pseudoRapidity; }
+        double absEta() const{ return std::abs( eta() ); }
+        double phi() const { if( !isComputed( phiBit ) ) computeAzimuthalAngle(); return azimuthalAngle; }
         double energy() const { return energyValue; }
         double mass() const;
         
-        double px() const { return xMomentum; }
-        double py() const { return yMomentum; }
-        double pz() const { return zMomentum; }
+        double px() const { if( !isComputed( transverseMomentaBit ) ) computeTransverseMomenta(); return xMomentum; }
+        double py() const { if( !isComputed( transverseMomentaBit ) ) computeTransverseMomenta(); return yMomentum; }
+        double pz() const { if( !isComputed( zMomentumBit ) ) computeZMomentum(); return zMomentum; }
 
         LorentzVector& operator+=( const LorentzVector& rhs );
         LorentzVector& operator-=( const LorentzVector& rhs );
         LorentzVector operator-() const;
 
     private:
-        double transverseMomentum = 0;
-        double pseudoRapidity = 0;
-        double azimuthalAngle = 0;
+
+        //bits flagging which coordinates are up to date, px and py are always computed together
+        enum ComputedBit : std::uint8_t { ptBit = 1, etaBit = 2, phiBit = 4, transverseMomentaBit = 8, zMomentumBit = 16 };
+        static constexpr std::uint8_t polarBits = ptBit | etaBit | phiBit;
+        static constexpr std::uint8_t cartesianBits = transverseMomentaBit | zMomentumBit;
+
+        mutable object_float_type transverseMomentum = 0;
+        mutable object_float_type pseudoRapidity = 0;
+        mutable object_float_type azimuthalAngle = 0;
         double energyValue = 0;
 
-        double xMomentum = 0;
-        double yMomentum = 0;
-        double zMomentum = 0;
+        mutable double xMomentum = 0;
+        mutable double yMomentum = 0;
+        mutable double zMomentum = 0;
+
+        //a default constructed vector is zero in both representations
+        mutable std::uint8_t computedBits = polarBits | cartesianBits;
+
+        bool isComputed( const ComputedBit bit ) const{ return ( computedBits & bit ); }
 
         //set default values for azimuthal angle and pseudorapidity when the momenta of the Lorentz vector are 0
         void setZeroValues();
@@ -52,11 +76,14 @@ class LorentzVector{
         //make sure phi is in the interval ]-pi, pi]
         void normalizePhi();
 
-        //compute pseudorapidity given px, py and pz
-        double computePseudoRapidity() const;
+        //compute the cartesian coordinates from pt, eta and phi
+        void computeTransverseMomenta() const;
+        void computeZMomentum() const;
 
-        //compute azimuthal angle given px and py
-        double computeAzimuthalAngle() const;
+        //compute pt, eta and phi from the cartesian coordinates
+        void computeTransverseMomentum() const;
+        void computePseudoRapidity() const;
+        void computeAzimuthalAngle() const;
 };
 
 LorentzVector operator+( const LorentzVector&, const LorentzVector& );
@@ -3,6 +3,7 @@
 
 //include other parts of code 
 #include "PhysicsObject.h"
+#include "objectPrecision.h"
 #include "../../TreeReader/interface/TreeReader.h"
 
 class Met : public PhysicsObject {
@@ -29,16 +30,16 @@ class Met : public PhysicsObject {
     private:
 
         //JEC uncertainties
-        double _pt_JECDown = 0;
-        double _phi_JECDown = 0;
-        double _pt_JECUp = 0;
-        double _phi_JECUp = 0;
+        object_float_type _pt_JECDown = 0;
+        object_float_type _phi_JECDown = 0;
+        object_float_type _pt_JECUp = 0;
+        object_float_type _phi_JECUp = 0;
 
         //unclustered energy uncertainties
-        double _pt_UnclDown = 0;
-        double _phi_UnclDown = 0;
-        double _pt_UnclUp = 0;
-        double _phi_UnclUp = 0;
+        object_float_type _pt_UnclDown = 0;
+        object_float_type _phi_UnclDown = 0;
+        object_float_type _pt_UnclUp = 0;
+        object_float_type _phi_UnclUp = 0;
 
         Met variedMet( const double pt, const double phi ) const;
 
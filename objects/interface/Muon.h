@@ -29,10 +29,10 @@ class Muon : public LightLepton {
         virtual std::ostream& print( std::ostream& os = std::cout ) const override;
 
     private:
-        double _segmentCompatibility = 0;
-        double _trackPt = 0;
-        double _trackPtError = 0;
-        double _relIso0p4DeltaBeta = 0;
+        object_float_type _segmentCompatibility = 0;
+        object_float_type _trackPt = 0;
+        object_float_type _trackPtError = 0;
+        object_float_type _relIso0p4DeltaBeta = 0;
 
         //cut based POG ID working points ( do not include isolation )
         bool _isLoosePOGMuon = false;
@@ -0,0 +1,17 @@
+/*
+Floating point type in which the kinematic and identification quantities of the physics objects are stored
+Building with PRECISION=float ( see buildConfigurations.mk ) stores them as float, halving the memory footprint of the object collections and doubling the SIMD width of the batched kinematics.
+The accessors always return double, and weights, sums of objects and masses are computed in double in either case.
+The energy and cartesian momenta of a LorentzVector, into which objects are summed, are stored in double in either case as well.
+*/
+
+#ifndef objectPrecision_H
+#define objectPrecision_H
+
+#ifdef FLOAT_PRECISION_OBJECTS
+using object_float_type = float;
+#else
+using object_float_type = double;
+#endif
+
+#endif
@@ -0,0 +1,47 @@
+/*
+Batched deltaR computations for overlap removal between two collections of objects
+The pseudorapidities and azimuthal angles are stored in contiguous arrays, so the compiler can vectorize the loops over all object pairs.
+They are stored with the precision of the physics objects ( see objectPrecision.h ), so float precision builds process twice as many objects per instruction.
+*/
+
+#ifndef overlapRemoval_H
+#define overlapRemoval_H
+
+//include c++ library classes
+#include <vector>
+#include <cstddef>
+
+//include other parts of framework
+#include "objectPrecision.h"
+
+
+namespace overlapRemoval{
+
+    class EtaPhiArrays {
+
+        public:
+            EtaPhiArrays() = default;
+
+            void reserve( const std::size_t size ){ _eta.reserve( size ); _phi.reserve( size ); }
+            void push_back( const double eta, const double phi ){ _eta.push_back( eta ); _phi.push_back( phi ); }
+
+            //add the direction of any object with eta() and phi() members, such as LorentzVector and PhysicsObject
+            template< typename ObjectType > void push_back( const ObjectType& object ){ push_back( object.eta(), object.phi() ); }
+
+            std::size_t size() const{ return _eta.size(); }
+            const object_float_type* eta() const{ return _eta.data(); }
+            const object_float_type* phi() const{ return _phi.data(); }
+
+        private:
+            std::vector< object_float_type > _eta;
+            std::vector< object_float_type > _phi;
+    };
+
+    //minimal deltaR^2 of every object to any of the reference objects, objects are infinitely far away when there are no reference objects
+    std::vector< object_float_type > minDeltaR2( const EtaPhiArrays& objects, const EtaPhiArrays& referenceObjects );
+
+    //mask with 1 for every object that is not within coneSize of any reference object, and 0 for the overlapping objects
+    std::vector< unsigned char > keepMask( const EtaPhiArrays& objects, const EtaPhiArrays& referenceObjects, const double coneSize );
+}
+
+#endif
@@ -12,7 +12,7 @@ void LorentzVector::setZeroValues(){
         azimuthalAngle = 0;
 
         //if there is no longitudinal, nor transverse momentum, the pseudorapidity is set to 0
-        if( zMomentum == 0 ){
+        if( pz() == 0 ){
             pseudoRapidity = 0;
         } 
     }
@@ -36,9 +36,7 @@ void LorentzVector::normalizePhi(){
 
 LorentzVector::LorentzVector(const double pt, const double eta, const double phi, const double energy):
     transverseMomentum(pt), pseudoRapidity(eta), azimuthalAngle(phi), energyValue( energy ),
-    xMomentum( transverseMomentum*std::cos( azimuthalAngle ) ),
-    yMomentum( transverseMomentum*std::sin( azimuthalAngle ) ),
-    zMomentum( transverseMomentum*std::sinh( pseudoRapidity ) )
+    computedBits( polarBits )
 {
     setZeroValues();    
     normalizePhi();
@@ -46,7 +44,17 @@ LorentzVector::LorentzVector(const double pt, const double eta, const double phi
 
 
 double LorentzVector::mass() const{
-    double m2 = energyValue*energyValue - transverseMomentum*transverseMomentum - zMomentum*zMomentum;
+
+    //sums are stored in cartesian coordinates, using them avoids the rounding of the stored pt
+    double transverse2;
+    if( isComputed( transverseMomentaBit ) ){
+        transverse2 = xMomentum*xMomentum + yMomentum*yMomentum;
+    } else {
+        double transverse = pt();
+        transverse2 = transverse*transverse;
+    }
+    double longitudinal = pz();
+    double m2 = energyValue*energyValue - transverse2 - longitudinal*longitudinal;
     if( m2 >= 0 ){
         return std::sqrt( m2 );
     } else {
@@ -55,9 +63,36 @@ double LorentzVector::mass() const{
 }
 
 
-double LorentzVector::computePseudoRapidity() const{
-	double momentumMagnitude = std::sqrt( transverseMomentum*transverseMomentum + zMomentum*zMomentum );
-	double longitudinalMomentumFraction = zMomentum/ momentumMagnitude;
+//a coordinate is only computed when it is missing, in which case the other representation is complete
+//the stored coordinates are converted to double first, so the float overloads of the math functions are never used
+
+void LorentzVector::computeTransverseMomenta() const{
+    double transverse = transverseMomentum;
+    double angle = azimuthalAngle;
+    xMomentum = transverse*std::cos( angle );
+    yMomentum = transverse*std::sin( angle );
+    computedBits |= transverseMomentaBit;
+}
+
+
+void LorentzVector::computeZMomentum() const{
+    double transverse = transverseMomentum;
+    zMomentum = transverse*std::sinh( static_cast< double >( pseudoRapidity ) );
+    computedBits |= zMomentumBit;
+}
+
+
+void LorentzVector::computeTransverseMomentum() const{
+    transverseMomentum = std::sqrt( xMomentum*xMomentum + yMomentum*yMomentum );
+    computedBits |= ptBit;
+}
+
+
+void LorentzVector::computePseudoRapidity() const{
+    double transverse = pt();
+    double longitudinal = zMomentum;
+	double momentumMagnitude = std::sqrt( transverse*transverse + longitudinal*longitudinal );
+	double longitudinalMomentumFraction = longitudinal/ momentumMagnitude;
 
 	//avoid infinite atanh when argument becomes 1
 	if( fabs(longitudinalMomentumFraction) == 1. ){
@@ -70,50 +105,46 @@ double LorentzVector::computePseudoRapidity() const{
 	}
 	
 	//avoid zero division
-	return ( zMomentum == 0 ) ? 0 : std::atanh( longitudinalMomentumFraction );
+	pseudoRapidity = ( zMomentum == 0 ) ? 0 : std::atanh( longitudinalMomentumFraction );
+    computedBits |= etaBit;
 }
 
 
-double LorentzVector::computeAzimuthalAngle() const{
+void LorentzVector::computeAzimuthalAngle() const{
 
 	//default value for azimuthal angle is 0 when the transverse momentum is 0
-    if( transverseMomentum == 0 ){
-        return 0;
+    if( pt() == 0 ){
+        azimuthalAngle = 0;
 
     //avoid division by zero when computing the azimuthal angle
     } else if( xMomentum == 0 ){
-        return ( yMomentum > 0 ) ? M_PI/2 : - M_PI/2;
+        azimuthalAngle = ( yMomentum > 0 ) ? M_PI/2 : - M_PI/2;
     } else {
         double angle = std::atan( yMomentum / xMomentum );
 
         //take into account that atan output always lies in the range ]-pi/2, pi/2]
         if( xMomentum < 0 && yMomentum > 0 ){
-            return angle + M_PI;
+            angle += M_PI;
         } else if( xMomentum < 0 && yMomentum < 0 ){
-            return angle - M_PI;
+            angle -= M_PI;
         }
-		return angle;
+        azimuthalAngle = angle;
     }
+    computedBits |= phiBit;
 }
 
 
 LorentzVector& LorentzVector::operator+=( const LorentzVector& rhs ){
 
-    //add the four-vectors 
-    xMomentum += rhs.xMomentum;
-    yMomentum += rhs.yMomentum;
-    zMomentum += rhs.zMomentum;
+    //add the four-vectors in cartesian coordinates, pt, eta and phi are only recomputed when they are requested
+    double rhsXMomentum = rhs.px();
+    double rhsYMomentum = rhs.py();
+    double rhsZMomentum = rhs.pz();
+    xMomentum = px() + rhsXMomentum;
+    yMomentum = py() + rhsYMomentum;
+    zMomentum = pz() + rhsZMomentum;
     energyValue += rhs.energyValue;
-
-    //compute the transverse momentum and total momentum
-    transverseMomentum = std::sqrt( xMomentum*xMomentum + yMomentum*yMomentum );
-
-	//Warning: xMomentum, yMomentum, zMomentum and transverseMomentum must be computed before computing pseudoRapidity and azimuthalAngle
-    //compute pseudorapidity
-    pseudoRapidity = computePseudoRapidity();
-        
-	//compute azimuthal angle
-	azimuthalAngle = computeAzimuthalAngle();
+    computedBits = cartesianBits;
 
     return *this;
 }
@@ -127,11 +158,13 @@ LorentzVector operator+( const LorentzVector& lhs, const LorentzVector& rhs){
 
 
 LorentzVector LorentzVector::operator-() const{
+
+    //coordinates that are not computed yet are negated as well, they stay flagged as missing in the copy
     LorentzVector neg = *this;
 
     neg.transverseMomentum = transverseMomentum;
     neg.pseudoRapidity = -pseudoRapidity;
-	neg.azimuthalAngle = -( azimuthalAngle < 0 ) ? azimuthalAngle + M_PI : azimuthalAngle - M_PI;
+	neg.azimuthalAngle = ( azimuthalAngle < 0 ) ? azimuthalAngle + M_PI : azimuthalAngle - M_PI;
     neg.energyValue = -energyValue;
     neg.xMomentum = -xMomentum;
     neg.yMomentum = -yMomentum;
@@ -155,18 +188,18 @@ LorentzVector operator-( const LorentzVector& lhs, const LorentzVector& rhs ){
 
 
 std::ostream& operator<<( std::ostream& os, const LorentzVector& rhs ){
-    os << "(pT = " << rhs.transverseMomentum << ", eta = " << rhs.pseudoRapidity << ", phi = " << rhs.azimuthalAngle << ", energy = " << rhs.energyValue << ")";
+    os << "(pT = " << rhs.pt() << ", eta = " << rhs.eta() << ", phi = " << rhs.phi() << ", energy = " << rhs.energy() << ")";
     return os;
 }
 
 
 double deltaEta( const LorentzVector& lhs, const LorentzVector& rhs ){
-    return fabs( lhs.pseudoRapidity - rhs.pseudoRapidity );
+    return fabs( lhs.eta() - rhs.eta() );
 }
 
 
 double deltaPhi( const LorentzVector& lhs, const LorentzVector& rhs ){
-    double dPhi = fabs( lhs.azimuthalAngle - rhs.azimuthalAngle );
+    double dPhi = fabs( lhs.phi() - rhs.phi() );
     return std::min( dPhi, 2*M_PI - dPhi );
 } 
 
@@ -0,0 +1,42 @@
+#include "../interface/overlapRemoval.h"
+
+//include c++ library classes
+#include <cmath>
+#include <algorithm>
+#include <limits>
+
+
+std::vector< object_float_type > overlapRemoval::minDeltaR2( const EtaPhiArrays& objects, const EtaPhiArrays& referenceObjects ){
+    const std::size_t numberOfObjects = objects.size();
+    std::vector< object_float_type > minimalValues( numberOfObjects, std::numeric_limits< object_float_type >::infinity() );
+    const object_float_type* eta = objects.eta();
+    const object_float_type* phi = objects.phi();
+    object_float_type* minimum = minimalValues.data();
+
+    //the inner loop runs over contiguous arrays without branches, so it is vectorized
+    //phi values are in ]-pi, pi], so the wrapped difference is the minimum of the difference and its complement, as in deltaPhi of LorentzVector
+    //all arithmetic is done in the storage precision, so no conversions interrupt the vectorized loop
+    const object_float_type twoPi = 2*M_PI;
+    for( std::size_t r = 0; r < referenceObjects.size(); ++r ){
+        const object_float_type referenceEta = referenceObjects.eta()[ r ];
+        const object_float_type referencePhi = referenceObjects.phi()[ r ];
+        for( std::size_t i = 0; i < numberOfObjects; ++i ){
+            object_float_type dEta = eta[ i ] - referenceEta;
+            object_float_type dPhi = std::fabs( phi[ i ] - referencePhi );
+            dPhi = std::min( dPhi, twoPi - dPhi );
+            minimum[ i ] = std::min( minimum[ i ], dEta*dEta + dPhi*dPhi );
+        }
+    }
+    return minimalValues;
+}
+
+
+std::vector< unsigned char > overlapRemoval::keepMask( const EtaPhiArrays& objects, const EtaPhiArrays& referenceObjects, const double coneSize ){
+    std::vector< object_float_type > minimalValues = minDeltaR2( objects, referenceObjects );
+    const object_float_type coneSize2 = coneSize*coneSize;
+    std::vector< unsigned char > mask( minimalValues.size() );
+    for( std::size_t i = 0; i < minimalValues.size(); ++i ){
+        mask[ i ] = !( minimalValues[ i ] < coneSize2 );
+    }
+    return mask;
+}
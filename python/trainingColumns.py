@@ -0,0 +1,64 @@
+import glob
+import os
+import re
+
+import numpy as np
+
+
+MAGIC = b'TRNCOL01'
+
+
+#memory-map a columnar training file written by TrainingTreeWriter
+#returns the list of variable names and an array of shape (number of entries, number of variables) that is read lazily from disk
+def loadTrainingColumns( file_name ):
+    with open( file_name, 'rb' ) as f:
+        if f.read( len( MAGIC ) ) != MAGIC:
+            raise IOError( '{} is not a columnar training file.'.format( file_name ) )
+        number_of_variables, number_of_entries, data_offset = np.frombuffer( f.read( 24 ), dtype = '<u8' )
+        header = f.read( int( data_offset ) - len( MAGIC ) - 24 )
+    variable_names = [ name.decode( 'ascii' ) for name in header.split( b'\x00' )[ : int( number_of_variables ) ] ]
+    if number_of_entries == 0:
+        return variable_names, np.zeros( ( 0, int( number_of_variables ) ), dtype = '<f4' )
+    columns = np.memmap( file_name, dtype = '<f4', mode = 'r', offset = int( data_offset ), shape = ( int( number_of_variables ), int( number_of_entries ) ) )
+    return variable_names, columns.T
+
+
+#return a single column by name without loading the other variables
+def loadTrainingColumn( file_name, variable_name ):
+    variable_names, columns = loadTrainingColumns( file_name )
+    return columns[ :, variable_names.index( variable_name ) ]
+
+
+#base names of the complete shards of a sample written by ewkinoAnalysis/produceNNTrainingTrees, ordered by shard index
+#a shard is only complete once its .done marker exists, shards without a marker are still being written or were interrupted and are skipped
+def completeShardNames( directory, sample_name ):
+    shard_pattern = os.path.join( directory, 'trainingFile_{}_shard*.columns'.format( glob.escape( sample_name ) ) )
+    shard_expression = re.compile( re.escape( 'trainingFile_{}_shard'.format( sample_name ) ) + r'(\d+)\.columns$' )
+    shards = []
+    for file_name in glob.glob( shard_pattern ):
+        match = shard_expression.search( os.path.basename( file_name ) )
+        if match is None:
+            continue
+        base_name = file_name[ : -len( '.columns' ) ]
+        if not os.path.isfile( base_name + '.done' ):
+            print( 'Warning : skipping incomplete shard {}.'.format( base_name ) )
+            continue
+        shards.append( ( int( match.group( 1 ) ), base_name ) )
+    return [ base_name for _, base_name in sorted( shards ) ]
+
+
+#load the columns of all complete shards of a sample as a single array
+def loadSampleColumns( directory, sample_name ):
+    shard_names = completeShardNames( directory, sample_name )
+    if not shard_names:
+        raise IOError( 'No complete training shards found for sample {} in {}.'.format( sample_name, directory ) )
+    variable_names = None
+    shard_columns = []
+    for shard_name in shard_names:
+        names, columns = loadTrainingColumns( shard_name + '.columns' )
+        if variable_names is None:
+            variable_names = names
+        elif names != variable_names:
+            raise IOError( 'Shard {} has variables {} instead of {}.'.format( shard_name, names, variable_names ) )
+        shard_columns.append( columns )
+    return variable_names, np.concatenate( shard_columns )
@@ -1,8 +1,12 @@
 #include "../interface/TrainingTree.h"
 
 TrainingTree::TrainingTree(const std::string& fileName, const std::shared_ptr< Sample >& sam, const std::shared_ptr< Category >& cat, const std::map < std::string, float >& varMap, const bool isSignal):
-    sample(sam), category(cat), variableMap(varMap)
+    sample(sam), category(cat)
 {
+    for(const auto& var : varMap){
+        variableNames.push_back(var.first);
+        variableValues.push_back(var.second);
+    }
     treeFile = TFile::Open( (const TString&) fileName + sam->getUniqueName() + ".root","RECREATE");
     setBranches(isSignal); 
 }
@@ -29,34 +33,27 @@ std::string TrainingTree::treeName(const size_t categoryIndex, const bool isSign
 //set up tree branches 
 void TrainingTree::setBranches(const bool isSignal){
     //set up tree with branches for every category
+    //the branches point into variableValues, which is never resized after construction
     for(size_t c = 0; c < category->size(); ++c){
         trainingTrees.push_back( new TTree( (const TString&) treeName(c, isSignal) ,(const TString&) treeName(c, isSignal)  ) );
-        for(auto mapIt = variableMap.begin(); mapIt != variableMap.end(); ++mapIt){
-            //Warning: do not use "&mapIt->second" for the middle argument since this will give the adress of a temporary!"
-            trainingTrees[c]->Branch( (const TString&) mapIt->first, &variableMap[mapIt->first], (const TString&) mapIt->first + "/F");
+        for(size_t v = 0; v < variableNames.size(); ++v){
+            trainingTrees[c]->Branch( (const TString&) variableNames[v], &variableValues[v], (const TString&) variableNames[v] + "/F");
         }
     }
 }
 
-//fill event to tree
-void TrainingTree::fill(const size_t categoryIndex, const std::map< std::string, float>& varMap){
-    /*
-    consider to replace map copy here with vector for efficiency!
-    */
-    if(variableMap.size() != varMap.size()){
+//the map is ordered alphabetically, just like the variable names, so its values can be copied directly into the buffer
+void TrainingTree::fill(const std::vector< size_t>& categoryIndices, const std::map< std::string, float>& varMap){   
+    if(variableValues.size() != varMap.size()){
         std::cerr << "Error: trying to set TrainingTree map equal to a map of different size! returning control" << std::endl;
         return;
     }
-    auto variableMapIt = variableMap.begin();
-    for(auto tempIt = varMap.cbegin(); tempIt != varMap.cend(); ++tempIt, ++variableMapIt){
-        variableMapIt->second = tempIt->second;
+    auto valueIt = variableValues.begin();
+    for(auto tempIt = varMap.cbegin(); tempIt != varMap.cend(); ++tempIt, ++valueIt){
+        *valueIt = tempIt->second;
     }
-    trainingTrees[categoryIndex]->Fill();
-}
-
-void TrainingTree::fill(const std::vector< size_t>& categoryIndices, const std::map< std::string, float>& varMap){   
     size_t categoryIndex = category->getIndex(categoryIndices);
-    fill(categoryIndex, varMap);
+    trainingTrees[categoryIndex]->Fill();
 }
 /*
 void trainingTree::write(const std::string& directory) const{
@@ -17,7 +17,7 @@ int main(){
 
     auto start = std::chrono::high_resolution_clock::now();
 
-    for(unsigned i = 0; i < treeReader.nEntries; ++i){
+    for(long unsigned i = 0; i < treeReader.numberOfEntries(); ++i){
 
         treeReader.GetEntry(i);
         EventTags eventTags( treeReader );
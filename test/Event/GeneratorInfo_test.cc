@@ -17,7 +17,7 @@ int main(){
 
     auto start = std::chrono::high_resolution_clock::now();
 
-    for(unsigned i = 0; i < treeReader.nEntries; ++i){
+    for(long unsigned i = 0; i < treeReader.numberOfEntries(); ++i){
 
         treeReader.GetEntry(i);
         
@@ -46,7 +46,7 @@ int main(){
 		}
         if( generatorInfo.numberOfPsWeights() == 14 ){
             generatorInfo.relativeWeight_ISR_InverseSqrt2();
-            generatorInfo.relativeWeight_FSR_InverseSqrt2_();
+            generatorInfo.relativeWeight_FSR_InverseSqrt2();
             generatorInfo.relativeWeight_ISR_Sqrt2();
             generatorInfo.relativeWeight_FSR_Sqrt2();
             generatorInfo.relativeWeight_ISR_0p5();
@@ -10,6 +10,7 @@
 #include <chrono>
 #include <utility>
 #include <vector>
+#include <stdexcept>
 
 
 int main(){
@@ -20,7 +21,7 @@ int main(){
 
     auto start = std::chrono::high_resolution_clock::now();
 
-    for(unsigned i = 0; i < treeReader.nEntries; ++i){
+    for(long unsigned i = 0; i < treeReader.numberOfEntries(); ++i){
 
         treeReader.GetEntry(i);
     
@@ -46,6 +47,19 @@ int main(){
         jetCollection.numberOfTightBTaggedJets();
         jetCollection.numberOfGoodJets();
 
+        //views must contain the same jets as the corresponding sub-collections
+        if( jetCollection.mediumBTagView().size() != jetCollection.numberOfMediumBTaggedJets() ){
+            throw std::runtime_error( "mediumBTagView does not contain all medium b-tagged jets." );
+        }
+        JetCollection tightBTagCollection = jetCollection.tightBTagCollection();
+        JetCollection::size_type index = 0;
+        for( const auto& jetPtr : jetCollection.tightBTagView() ){
+            if( index >= tightBTagCollection.size() || &tightBTagCollection[ index ] != jetPtr.get() ){
+                throw std::runtime_error( "tightBTagView and tightBTagCollection do not contain the same jets." );
+            }
+            ++index;
+        }
+
         copyMoveTest( jetCollection );
     }
 
@@ -7,12 +7,35 @@
 #include "../../Event/interface/TauCollection.h"
 #include "../../Event/interface/LightLeptonCollection.h"
 #include "../copyMoveTest.h"
+#include "../../constants/particleMasses.h"
 
 //include c++ library classes
 #include <iostream>
 #include <chrono>
 #include <utility>
 #include <vector>
+#include <stdexcept>
+#include <string>
+#include <cmath>
+#include <limits>
+
+
+//best Z boson candidate mass computed without the cached pair combinatorics
+double bruteForceZBosonCandidateMass( const LeptonCollection& leptonCollection ){
+    double minDiff = std::numeric_limits< double >::max();
+    double bestMass = 0;
+    for( const auto& leptonPair : leptonCollection.pairCollection() ){
+        const Lepton& l1 = *leptonPair.first;
+        const Lepton& l2 = *leptonPair.second;
+        if( !( l1.isLightLepton() && oppositeSignSameFlavor( l1, l2 ) ) ) continue;
+        double mass = ( l1 + l2 ).mass();
+        if( std::abs( mass - particle::mZ ) < minDiff ){
+            minDiff = std::abs( mass - particle::mZ );
+            bestMass = mass;
+        }
+    }
+    return bestMass;
+}
 
 
 int main(){
@@ -23,7 +46,7 @@ int main(){
 
     auto start = std::chrono::high_resolution_clock::now();
 
-    for(unsigned i = 0; i < treeReader.nEntries; ++i){
+    for(long unsigned i = 0; i < treeReader.numberOfEntries(); ++i){
 
         treeReader.GetEntry(i);
 
@@ -41,6 +64,18 @@ int main(){
         TauCollection tauCollection = leptonCollection.tauCollection();
         LightLeptonCollection lightLeptonCollection = leptonCollection.lightLeptonCollection();
 
+        //cached flavor indices must give the same leptons as the flavor collections
+        for( MuonCollection::size_type m = 0; m < muonColletion.size(); ++m ){
+            if( &leptonCollection.muon( m ) != &muonColletion[ m ] ){
+                throw std::runtime_error( "muon( " + std::to_string( m ) + " ) does not match the muon collection." );
+            }
+        }
+        for( LightLeptonCollection::size_type l = 0; l < lightLeptonCollection.size(); ++l ){
+            if( &leptonCollection.lightLepton( l ) != &lightLeptonCollection[ l ] ){
+                throw std::runtime_error( "lightLepton( " + std::to_string( l ) + " ) does not match the light lepton collection." );
+            }
+        }
+
         leptonCollection.sortByPt();
         
         leptonCollection.looseLeptonCollection();
@@ -67,9 +102,37 @@ int main(){
         leptonCollection.numberOfFOLeptons();
         leptonCollection.numberOfTightLeptons();
 
+        //views must contain the same leptons as the corresponding sub-collections
+        LeptonCollection FOLeptons = leptonCollection.FOLeptonCollection();
+        if( leptonCollection.FOLeptonView().size() != FOLeptons.size() ){
+            throw std::runtime_error( "FOLeptonView and FOLeptonCollection have a different size." );
+        }
+        LeptonCollection::size_type index = 0;
+        for( const auto& leptonPtr : leptonCollection.FOLeptonView() ){
+            if( &FOLeptons[ index ] != leptonPtr.get() ){
+                throw std::runtime_error( "FOLeptonView and FOLeptonCollection do not contain the same leptons." );
+            }
+            ++index;
+        }
+
         leptonCollection.numberOfUniqueOSSFPairs();
         leptonCollection.numberOfUniqueOSPairs();
 
+        //the cached pair combinatorics must follow reordering and cone correction of the leptons
+        if( leptonCollection.hasZBosonCandidate() ){
+            leptonCollection.sortByAttribute( []( const std::shared_ptr< Lepton >& lhs, const std::shared_ptr< Lepton >& rhs ){ return lhs->pt() < rhs->pt(); } );
+            leptonCollection.bestZBosonCandidateMass();
+            leptonCollection.sortByPt();
+            leptonCollection.applyConeCorrection();
+            std::pair< LeptonCollection::size_type, LeptonCollection::size_type > indices = leptonCollection.bestZBosonCandidateIndices();
+            double mass = leptonCollection.bestZBosonCandidateMass();
+            if( std::abs( mass - bruteForceZBosonCandidateMass( leptonCollection ) ) > 1e-9 || std::abs( ( leptonCollection[ indices.first ] + leptonCollection[ indices.second ] ).mass() - mass ) > 1e-9 ){
+                throw std::runtime_error( "Cached Z boson candidate does not match the current leptons." );
+            }
+        } else if( leptonCollection.hasLightOSSFPair() ){
+            throw std::runtime_error( "No Z boson candidate is found in a collection with a light OSSF pair." );
+        }
+
         copyMoveTest( leptonCollection );
     }
 
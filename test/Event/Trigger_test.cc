@@ -7,6 +7,14 @@
 //include c++ library classes
 #include <iostream>
 #include <chrono>
+#include <stdexcept>
+#include <string>
+
+
+//names of the decisions are the branch names without their leading '_'
+std::string decisionName( const std::string& branchName ){
+    return ( branchName.front() == '_' ? branchName.substr( 1 ) : branchName );
+}
 
 
 int main(){
@@ -17,7 +25,7 @@ int main(){
 
     auto start = std::chrono::high_resolution_clock::now();
 
-    for(unsigned i = 0; i < treeReader.nEntries; ++i){
+    for(long unsigned i = 0; i < treeReader.numberOfEntries(); ++i){
 
         treeReader.GetEntry(i);
         
@@ -35,9 +43,38 @@ int main(){
         triggerInfo.passTriggers_mmm();
         triggerInfo.passMetFilters();
 
+        //the packed decisions must match the branch buffers they were read from
+        for( const auto& trigger : treeReader._triggerMap ){
+            if( triggerInfo.passTrigger( decisionName( trigger.first ) ) != trigger.second ){
+                throw std::runtime_error( "Decision of trigger " + trigger.first + " does not match its branch." );
+            }
+        }
+        for( const auto& filter : treeReader._MetFilterMap ){
+            if( triggerInfo.passMetFilter( treeReader.metFilterIndex( decisionName( filter.first ) ) ) != filter.second ){
+                throw std::runtime_error( "Decision of MET filter " + filter.first + " does not match its branch." );
+            }
+        }
+
         if( i == 0 ){
             triggerInfo.printAvailableIndividualTriggers();
             triggerInfo.printAvailableMetFilters();
+
+            //decisions by index are checked against the table and the reading of the individual decisions
+            bool outOfRangeCaught = false;
+            try{
+                triggerInfo.passTrigger( treeReader._triggerMap.size() );
+            } catch( const std::out_of_range& ){
+                outOfRangeCaught = true;
+            }
+            bool notReadCaught = false;
+            try{
+                TriggerInfo( treeReader ).passMetFilter( std::size_t( 0 ) );
+            } catch( const std::invalid_argument& ){
+                notReadCaught = true;
+            }
+            if( !outOfRangeCaught || !notReadCaught ){
+                throw std::runtime_error( "Invalid access to an individual decision by index was not caught." );
+            }
         }
 
         copyMoveTest( triggerInfo );
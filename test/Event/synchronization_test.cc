@@ -3,6 +3,7 @@
 #include <fstream>
 #include <utility>
 #include <cmath>
+#include <set>
 
 //include analysis framework
 #include "../../Event/interface/Event.h"
@@ -25,7 +26,7 @@ void testCopyMove(){
     std::ofstream copyAssignment_dump("copyAssignment_dump.txt" );
     std::ofstream moveAssignment_dump( "moveAssignment_dump.txt" );
 
-    for(unsigned i = 0; i < treeReader.nEntries; ++i){
+    for(long unsigned i = 0; i < treeReader.numberOfEntries(); ++i){
 
         treeReader.GetEntry(i);
 
@@ -164,7 +165,7 @@ void makeDumpWithFrameWork(){
 
 	std::ofstream dump( "framework_dump.txt" );
 
-    for(unsigned i = 0; i < treeReader.nEntries; ++i){
+    for(long unsigned i = 0; i < treeReader.numberOfEntries(); ++i){
         treeReader.GetEntry(i);	
 		Event event( treeReader, true, true);
 
@@ -245,7 +246,7 @@ void makeDumpStandalone(){
     std::cout << treeReader.is2018() << std::endl;
 
 
-    for(unsigned i = 0; i < treeReader.nEntries; ++i){
+    for(long unsigned i = 0; i < treeReader.numberOfEntries(); ++i){
 	
         treeReader.GetEntry(i);
 
@@ -0,0 +1,125 @@
+#include "../../Tools/interface/MultiWeightHistogram.h"
+
+//include c++ library classes 
+#include <random>
+#include <string> 
+#include <vector>
+#include <cmath>
+#include <algorithm>
+
+//include other parts of framework
+#include "../../Tools/interface/histogramTools.h"
+
+
+void compareHistograms( const TH1D* lhs, const TH1D* rhs ){
+    for( int b = 1; b < lhs->GetNbinsX() + 1; ++b ){
+        double difference = std::abs( lhs->GetBinContent( b ) - rhs->GetBinContent( b ) );
+        double errorDifference = std::abs( lhs->GetBinError( b ) - rhs->GetBinError( b ) );
+        if( difference > 1e-6 || errorDifference > 1e-6 ){
+            throw std::runtime_error( "Bin " + std::to_string( b ) + " of " + lhs->GetName() + " differs from " + rhs->GetName() + "." );
+        }
+    }
+}
+
+
+int main(){
+
+    HistInfo histInfo( "met", "E_{T}^{miss} (GeV)", 10, 0, 200 );
+    const size_t numberOfVariations = 9;
+    const size_t numberOfFills = 100000;
+
+    MultiWeightHistogram multiWeightHistogram( histInfo, numberOfVariations );
+
+    //reference histograms filled one variation at a time
+    std::shared_ptr< TH1D > nominalReference = histInfo.makeHist( "reference_nominal" );
+    std::vector< std::shared_ptr< TH1D > > variationReferences;
+    for( size_t v = 0; v < numberOfVariations; ++v ){
+        variationReferences.push_back( histInfo.makeHist( "reference_var" + std::to_string( v ) ) );
+    }
+
+    //the second half of the events has scaled variations
+    std::vector< double > variationScales( numberOfVariations );
+    for( size_t v = 0; v < numberOfVariations; ++v ){
+        variationScales[ v ] = 0.9 + 0.02*v;
+    }
+
+    //fill random values, also outside of the histogram range
+    std::random_device seeder;
+    std::ranlux48 random_engine( seeder() );
+    std::uniform_real_distribution< double > value_distribution( -50., 300. );
+    std::uniform_real_distribution< double > weight_distribution( -0.5, 2. );
+    std::uniform_real_distribution< double > relativeWeight_distribution( 0.5, 1.5 );
+    for( size_t i = 0; i < numberOfFills; ++i ){
+        bool secondHalf = ( i >= numberOfFills/2 );
+        if( i == numberOfFills/2 ){
+            multiWeightHistogram.setVariationScales( variationScales );
+        }
+        double value = value_distribution( random_engine );
+        double weight = weight_distribution( random_engine );
+        std::vector< double > relativeWeights( numberOfVariations );
+        for( auto& relativeWeight : relativeWeights ){
+            relativeWeight = relativeWeight_distribution( random_engine );
+        }
+        multiWeightHistogram.fill( value, weight, relativeWeights );
+
+        histogram::fillValue( nominalReference.get(), value, weight );
+        for( size_t v = 0; v < numberOfVariations; ++v ){
+            double variedWeight = weight*relativeWeights[ v ]*( secondHalf ? variationScales[ v ] : 1. );
+            histogram::fillValue( variationReferences[ v ].get(), value, variedWeight );
+        }
+    }
+
+    compareHistograms( multiWeightHistogram.makeNominalHistogram( "nominal" ).get(), nominalReference.get() );
+    auto variationHistograms = multiWeightHistogram.makeVariationHistograms( "met" );
+    for( size_t v = 0; v < numberOfVariations; ++v ){
+        compareHistograms( variationHistograms[ v ].get(), variationReferences[ v ].get() );
+    }
+
+    //envelope and RMS of a subset of the variations
+    std::vector< size_t > indices = { 1, 4, 6 };
+    auto envelope = multiWeightHistogram.makeEnvelopeHistograms( "envelope", indices );
+    auto rms = multiWeightHistogram.makeRMSHistograms( "rms", indices );
+    for( int b = 1; b < nominalReference->GetNbinsX() + 1; ++b ){
+        double nominal = nominalReference->GetBinContent( b );
+        double minimum = nominal;
+        double maximum = nominal;
+        double sumOfSquaredDifferences = 0.;
+        for( auto v : indices ){
+            double content = variationReferences[ v ]->GetBinContent( b );
+            minimum = std::min( minimum, content );
+            maximum = std::max( maximum, content );
+            sumOfSquaredDifferences += ( content - nominal )*( content - nominal );
+        }
+        double rmsValue = std::sqrt( sumOfSquaredDifferences/indices.size() );
+        if( std::abs( envelope.first->GetBinContent( b ) - minimum ) > 1e-6 || std::abs( envelope.second->GetBinContent( b ) - maximum ) > 1e-6 ){
+            throw std::runtime_error( "Envelope in bin " + std::to_string( b ) + " differs from the reference." );
+        }
+        if( std::abs( rms.first->GetBinContent( b ) - ( nominal - rmsValue ) ) > 1e-6 || std::abs( rms.second->GetBinContent( b ) - ( nominal + rmsValue ) ) > 1e-6 ){
+            throw std::runtime_error( "RMS in bin " + std::to_string( b ) + " differs from the reference." );
+        }
+    }
+
+    //out of range variations should throw
+    bool caught = false;
+    try{
+        multiWeightHistogram.makeVariationHistogram( numberOfVariations, "outOfRange" );
+    } catch( std::out_of_range& ){
+        caught = true;
+    }
+    if( !caught ){
+        throw std::runtime_error( "Requesting a variation beyond the number of variations does not throw." );
+    }
+
+    //missing relative weights should throw instead of being filled with the nominal weight
+    caught = false;
+    try{
+        multiWeightHistogram.fill( 10., 1., std::vector< double >( numberOfVariations - 2, 1. ) );
+    } catch( std::invalid_argument& ){
+        caught = true;
+    }
+    if( !caught ){
+        throw std::runtime_error( "Filling fewer relative weights than variations does not throw." );
+    }
+
+    return 0;
+}
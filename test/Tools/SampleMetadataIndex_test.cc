@@ -0,0 +1,65 @@
+#include "../../Tools/interface/SampleMetadataIndex.h"
+
+//include c++ library classes
+#include <iostream>
+#include <exception>
+#include <cmath>
+
+//include other parts of framework
+#include "../../Tools/interface/Sample.h"
+#include "../../Tools/interface/SampleCrossSections.h"
+#include "../../Tools/interface/systemTools.h"
+
+
+int main(){
+
+    //read samples
+    std::vector< Sample > sampleVector = readSampleList( "../testData/samples_test.txt", "../testData/" );
+
+    //build the index from scratch
+    const std::string indexPath = "sampleMetadataIndex_test.metadata";
+    if( systemTools::fileExists( indexPath ) ){
+        systemTools::deleteFile( indexPath );
+    }
+    SampleMetadataIndex builtIndex( sampleVector, indexPath );
+    if( builtIndex.numberOfReadFiles() != builtIndex.size() ){
+        throw std::runtime_error( "A new SampleMetadataIndex should read every file." );
+    }
+
+    //a second index should take everything from the stored index, without opening the files
+    SampleMetadataIndex storedIndex( sampleVector, indexPath );
+    if( storedIndex.numberOfReadFiles() != 0 ){
+        throw std::runtime_error( "SampleMetadataIndex reads " + std::to_string( storedIndex.numberOfReadFiles() ) + " files while none of them changed." );
+    }
+
+    for( const auto& sample : sampleVector ){
+
+        //the stored metadata should be identical to the metadata read from the file
+        const SampleMetadata& stored = storedIndex.metadata( sample );
+        SampleMetadata read = SampleMetadataIndex::readMetadata( sample.filePath() );
+        if( stored.numberOfEntries != read.numberOfEntries || stored.sumOfSimulatedEventWeights != read.sumOfSimulatedEventWeights
+            || stored.lheSumsOfWeights != read.lheSumsOfWeights || stored.psSumsOfWeights != read.psSumsOfWeights
+            || stored.pileupBinEdges != read.pileupBinEdges || stored.pileupContents != read.pileupContents
+            || stored.susyCounterBins.size() != read.susyCounterBins.size() || stored.hasGeneratorInfo != read.hasGeneratorInfo
+            || stored.hasSusyMassInfo != read.hasSusyMassInfo || stored.hasIndividualTriggers != read.hasIndividualTriggers ){
+            throw std::runtime_error( "Stored metadata of " + sample.uniqueName() + " differs from the metadata in the file." );
+        }
+
+        //cross section ratios from the index should match those read from the file
+        if( sample.isData() ) continue;
+        SampleCrossSections fromFile( sample );
+        SampleCrossSections fromIndex( sample, storedIndex );
+        if( fromFile.numberOfLheVariations() != fromIndex.numberOfLheVariations() ){
+            throw std::runtime_error( "Number of lhe variations of " + sample.uniqueName() + " differs between the file and the index." );
+        }
+        for( size_t i = 0; i < 9 && i < fromFile.numberOfLheVariations(); ++i ){
+            if( std::abs( fromFile.crossSectionRatio_scaleVar( i ) - fromIndex.crossSectionRatio_scaleVar( i ) ) > 1e-12 ){
+                throw std::runtime_error( "Scale variation " + std::to_string( i ) + " of " + sample.uniqueName() + " differs between the file and the index." );
+            }
+        }
+    }
+    systemTools::deleteFile( indexPath );
+
+    std::cout << "SampleMetadataIndex test passed for " << storedIndex.size() << " files." << std::endl;
+    return 0;
+}
@@ -0,0 +1,89 @@
+#include "../../Tools/interface/SparseHistogramCollection.h"
+
+//include c++ library classes 
+#include <random>
+#include <string> 
+#include <vector>
+#include <cmath>
+
+//include other parts of framework
+#include "../../Tools/interface/histogramTools.h"
+
+//include test function
+#include "../copyMoveTest.h"
+
+
+int main(){
+
+    std::vector< HistInfo > histInfos = {
+        HistInfo( "met", "E_{T}^{miss} (GeV)", 10, 0, 200 ),
+        HistInfo( "mt", "M_{T}^{W} (GeV)", 7, 50, 120 )
+    };
+    std::vector< std::string > systematics = { "nominal", "pileupDown", "pileupUp" };
+    const size_t numberOfMassPoints = 500;
+    const size_t numberOfFills = 100000;
+
+    SparseHistogramCollection sparseHistograms( histInfos, systematics );
+
+    //reference histograms for the mass points that are filled 
+    const std::vector< size_t > filledMassPoints = { 3, 42, 499 };
+    std::vector< std::vector< std::shared_ptr< TH1D > > > referenceHistograms( filledMassPoints.size(), std::vector< std::shared_ptr< TH1D > >( histInfos.size() ) );
+    for( size_t m = 0; m < filledMassPoints.size(); ++m ){
+        for( size_t v = 0; v < histInfos.size(); ++v ){
+            referenceHistograms[ m ][ v ] = histInfos[ v ].makeHist( "reference_" + std::to_string( m ) + "_" + histInfos[ v ].name() );
+        }
+    }
+
+    //fill random values, also outside of the histogram ranges
+    std::random_device seeder;
+    std::ranlux48 random_engine( seeder() );
+    std::uniform_real_distribution< double > value_distribution( -50., 300. );
+    std::uniform_real_distribution< double > weight_distribution( -0.5, 2. );
+    std::uniform_int_distribution< size_t > massPoint_distribution( 0, filledMassPoints.size() - 1 );
+    size_t nominalIndex = sparseHistograms.systematicIndex( "nominal" );
+    for( size_t i = 0; i < numberOfFills; ++i ){
+        size_t m = massPoint_distribution( random_engine );
+        std::vector< double > values = { value_distribution( random_engine ), value_distribution( random_engine ) };
+        double weight = weight_distribution( random_engine );
+        sparseHistograms.fill( filledMassPoints[ m ], nominalIndex, values, weight );
+        for( size_t v = 0; v < histInfos.size(); ++v ){
+            histogram::fillValue( referenceHistograms[ m ][ v ].get(), values[ v ], weight );
+        }
+    }
+
+    //only the filled combinations should have allocated bins 
+    if( sparseHistograms.numberOfAllocatedHistograms() != filledMassPoints.size() * histInfos.size() ){
+        throw std::runtime_error( std::to_string( sparseHistograms.numberOfAllocatedHistograms() ) + " histograms are allocated while " + std::to_string( filledMassPoints.size() * histInfos.size() ) + " were filled." );
+    }
+    if( sparseHistograms.filledMassPoints() != filledMassPoints ){
+        throw std::runtime_error( "Filled mass points of SparseHistogramCollection do not match the mass points that were filled." );
+    }
+    if( sparseHistograms.isFilled( 0, nominalIndex, 0 ) || sparseHistograms.isFilled( filledMassPoints.front(), sparseHistograms.systematicIndex( "pileupUp" ), 0 ) ){
+        throw std::runtime_error( "SparseHistogramCollection reports combinations as filled that were never filled." );
+    }
+
+    //compare the converted histograms to the reference histograms 
+    for( size_t m = 0; m < filledMassPoints.size(); ++m ){
+        for( size_t v = 0; v < histInfos.size(); ++v ){
+            auto hist = sparseHistograms.makeHistogram( filledMassPoints[ m ], nominalIndex, v, "sparse_" + std::to_string( m ) + "_" + histInfos[ v ].name() );
+            for( int b = 0; b < hist->GetNbinsX() + 2; ++b ){
+                double difference = std::abs( hist->GetBinContent( b ) - referenceHistograms[ m ][ v ]->GetBinContent( b ) );
+                double errorDifference = std::abs( hist->GetBinError( b ) - referenceHistograms[ m ][ v ]->GetBinError( b ) );
+                if( difference > 1e-6 || errorDifference > 1e-6 ){
+                    throw std::runtime_error( "Bin " + std::to_string( b ) + " of " + histInfos[ v ].name() + " for mass point " + std::to_string( filledMassPoints[ m ] ) + " differs from the reference histogram." );
+                }
+            }
+        }
+    }
+
+    //unfilled combinations give empty histograms
+    auto emptyHist = sparseHistograms.makeHistogram( numberOfMassPoints - 2, nominalIndex, 0, "empty" );
+    if( emptyHist->GetSumOfWeights() != 0. ){
+        throw std::runtime_error( "Histogram of unfilled mass point is not empty." );
+    }
+
+    //test copy and move behavior for leaks
+    copyMoveTest( sparseHistograms );
+
+    return 0;
+}
@@ -50,6 +50,30 @@ int main(){
         }
     }
 
+    //check that the fast index lookup is consistent with the stored masses
+    for( size_t index = 0; index < susyScan.numberOfPoints(); ++index ){
+        auto massPair = susyScan.masses( index );
+        if( susyScan.indexOrInvalid( massPair.first, massPair.second ) != index ){
+            throw std::runtime_error( "Index lookup of mass point " + susyScan.massesString( index ) + " does not return index " + std::to_string( index ) + "." );
+        }
+    }
+
+    //points that are not part of the scan must not be found 
+    auto firstMassPair = susyScan.masses( 0 );
+    if( susyScan.containsMassPoint( firstMassPair.first + 1, firstMassPair.second ) || susyScan.containsMassPoint( 1e6, 0. ) ){
+        throw std::runtime_error( "SusyScan contains mass points that are not part of the scan." );
+    }
+
+    //check that the mass point index resolved when building the event matches the index of its masses
+    treeReader.setSusyScan( susyScan );
+    for( long unsigned entry = 0; entry < treeReader.numberOfEntries(); ++entry ){
+        Event event = treeReader.buildEvent( entry );
+        const SusyMassInfo& massInfo = event.susyMassInfo();
+        if( massInfo.massPointIndex() != susyScan.index( massInfo.massNLSP(), massInfo.massLSP() ) ){
+            throw std::runtime_error( "Mass point index of event does not match the index of its masses in the SusyScan." );
+        }
+    }
+
     //check if list of manual mass splittings corresponds to the list generated by the SusyScan class
     std::vector< unsigned > massSplittingVector = susyScan.massSplittings();
     std::set< unsigned > massSplittings( massSplittingVector.cbegin(), massSplittingVector.cend() );
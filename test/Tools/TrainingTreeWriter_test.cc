@@ -0,0 +1,76 @@
+#include "../../Tools/interface/TrainingTreeWriter.h"
+
+//include c++ library classes 
+#include <random>
+#include <string> 
+#include <vector>
+
+//include other parts of framework
+#include "../../Tools/interface/systemTools.h"
+
+//include ROOT classes
+#include "TTreeReader.h"
+#include "TTreeReaderValue.h"
+
+
+int main(){
+
+    const std::vector< std::string > variableNames = { "metPt", "mt", "eventWeight" };
+    const long unsigned numberOfEntries = 10000;
+    const std::string rootFileName = "trainingTreeWriterTest.root";
+    const std::string columnarFileName = "trainingTreeWriterTest.columns";
+
+    //fill the writer with random values and keep a copy of them
+    std::random_device seeder;
+    std::ranlux48 random_engine( seeder() );
+    std::uniform_real_distribution< float > value_distribution( -100., 1000. );
+    std::vector< std::vector< float > > expectedColumns( variableNames.size() );
+    {
+        TrainingTreeWriter trainingTree( rootFileName, "backgroundTree", variableNames, columnarFileName );
+        size_t mtIndex = trainingTree.variableIndex( "mt" );
+        for( long unsigned entry = 0; entry < numberOfEntries; ++entry ){
+            for( size_t v = 0; v < variableNames.size(); ++v ){
+                trainingTree[ v ] = value_distribution( random_engine );
+            }
+            trainingTree[ mtIndex ] *= 0.5;
+            for( size_t v = 0; v < variableNames.size(); ++v ){
+                expectedColumns[ v ].push_back( trainingTree[ v ] );
+            }
+            trainingTree.fill();
+        }
+    }
+
+    //check the columnar file
+    if( trainingColumns::readVariableNames( columnarFileName ) != variableNames ){
+        throw std::runtime_error( "Variable names in columnar training file do not match the names that were written." );
+    }
+    if( trainingColumns::readColumns( columnarFileName ) != expectedColumns ){
+        throw std::runtime_error( "Columns in columnar training file do not match the values that were written." );
+    }
+
+    //check the ROOT tree
+    TFile* rootFile = TFile::Open( rootFileName.c_str() );
+    TTreeReader reader( "backgroundTree", rootFile );
+    std::vector< std::shared_ptr< TTreeReaderValue< float > > > values;
+    for( const auto& name : variableNames ){
+        values.push_back( std::make_shared< TTreeReaderValue< float > >( reader, name.c_str() ) );
+    }
+    long unsigned entry = 0;
+    while( reader.Next() ){
+        for( size_t v = 0; v < variableNames.size(); ++v ){
+            if( **values[ v ] != expectedColumns[ v ][ entry ] ){
+                throw std::runtime_error( "Value of " + variableNames[ v ] + " in entry " + std::to_string( entry ) + " of the training tree does not match the value that was written." );
+            }
+        }
+        ++entry;
+    }
+    if( entry != numberOfEntries ){
+        throw std::runtime_error( "Training tree has " + std::to_string( entry ) + " entries while " + std::to_string( numberOfEntries ) + " were written." );
+    }
+    rootFile->Close();
+
+    systemTools::deleteFile( rootFileName );
+    systemTools::deleteFile( columnarFileName );
+
+    return 0;
+}
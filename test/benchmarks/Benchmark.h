@@ -0,0 +1,69 @@
+//helper to time benchmarks and write the results in a machine-readable format
+//every benchmark is repeated several times and the fastest repetition is reported, since it is least affected by other activity on the machine
+
+#ifndef Benchmark_H
+#define Benchmark_H
+
+//include c++ library classes
+#include <string>
+#include <vector>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <algorithm>
+#include <limits>
+
+
+//store benchmark results in a volatile variable so the compiler can not optimize the benchmarked code away
+inline void doNotOptimize( const double value ){
+    static volatile double sink = 0.;
+    sink = sink + value;
+}
+
+
+class BenchmarkRecorder {
+
+    public:
+        BenchmarkRecorder( const std::string& revision ) : _revision( revision ) {}
+
+        //the function is called once per repetition, and must process numberOfItems items (e.g. events or function calls)
+        //it returns a value that depends on the processed items, which is fed to doNotOptimize
+        template< typename Function > void run( const std::string& name, const long unsigned numberOfItems, Function function, const unsigned repetitions = 5 ){
+
+            //warm up caches and lazy initializations
+            doNotOptimize( function() );
+
+            double bestSeconds = std::numeric_limits< double >::max();
+            for( unsigned r = 0; r < repetitions; ++r ){
+                auto start = std::chrono::steady_clock::now();
+                doNotOptimize( function() );
+                auto finish = std::chrono::steady_clock::now();
+                bestSeconds = std::min( bestSeconds, std::chrono::duration< double >( finish - start ).count() );
+            }
+            _results.push_back( { name, numberOfItems, repetitions, bestSeconds } );
+            std::cout << name << " : " << ( bestSeconds / numberOfItems ) * 1e9 << " ns per item, " << numberOfItems / bestSeconds << " items per second" << std::endl;
+        }
+
+        //write one JSON object per line, so results of several revisions can simply be concatenated and compared
+        void write( const std::string& fileName ) const{
+            std::ofstream outputFile( fileName, std::ios::app );
+            for( const auto& result : _results ){
+                outputFile << "{\"revision\": \"" << _revision << "\", \"benchmark\": \"" << result.name << "\", \"items\": " << result.numberOfItems
+                    << ", \"repetitions\": " << result.repetitions << ", \"seconds\": " << result.seconds
+                    << ", \"nsPerItem\": " << ( result.seconds / result.numberOfItems ) * 1e9 << ", \"itemsPerSecond\": " << result.numberOfItems / result.seconds << "}\n";
+            }
+        }
+
+    private:
+        struct BenchmarkResult {
+            std::string name;
+            long unsigned numberOfItems;
+            unsigned repetitions;
+            double seconds;
+        };
+
+        std::string _revision;
+        std::vector< BenchmarkResult > _results;
+};
+
+#endif
@@ -0,0 +1,255 @@
+//benchmarks of the event-processing hot paths
+//usage : ./benchmarks <revision label> <output file>
+//results are appended to the output file as one JSON object per line, so revisions can be compared by running this executable for each of them
+
+//include c++ library classes
+#include <random>
+#include <vector>
+#include <string>
+#include <memory>
+#include <map>
+#include <stdexcept>
+
+//include ROOT classes
+#include "TH1D.h"
+
+//include other parts of framework
+#include "../../objects/interface/LorentzVector.h"
+#include "../../TreeReader/interface/TreeReader.h"
+#include "../../Event/interface/Event.h"
+#include "../../Tools/interface/histogramTools.h"
+#include "../../weights/bTagSFCode/BTagCalibrationStandalone.h"
+#include "../../weights/interface/CombinedReweighter.h"
+#include "../../weights/interface/ConcreteReweighterFactory.h"
+#include "Benchmark.h"
+
+
+//weight directory passed to the reweighter factory, the b-tag calibration is read from the same location
+const std::string weightDirectory = "../../weights/";
+
+
+std::vector< LorentzVector > randomLorentzVectors( const size_t numberOfVectors ){
+    std::mt19937 random_engine( 1234 );
+    std::uniform_real_distribution< double > pt_distribution( 10., 500. );
+    std::uniform_real_distribution< double > eta_distribution( -2.5, 2.5 );
+    std::uniform_real_distribution< double > phi_distribution( -3.14, 3.14 );
+    std::vector< LorentzVector > vectors;
+    vectors.reserve( numberOfVectors );
+    for( size_t i = 0; i < numberOfVectors; ++i ){
+        double pt = pt_distribution( random_engine );
+        double eta = eta_distribution( random_engine );
+        vectors.push_back( LorentzVector( pt, eta, phi_distribution( random_engine ), pt*std::cosh( eta ) + 1. ) );
+    }
+    return vectors;
+}
+
+
+//read the events of the first simulated test sample into memory so the micro-benchmarks do not measure I/O
+//events refer to the sample owned by the TreeReader, so only events of its current sample can be kept
+std::vector< Event > readEvents( TreeReader& treeReader ){
+    std::vector< Event > events;
+    for( unsigned sampleIndex = 0; sampleIndex < treeReader.numberOfSamples(); ++sampleIndex ){
+        treeReader.initSample();
+        if( treeReader.isData() ) continue;
+        for( long unsigned entry = 0; entry < treeReader.numberOfEntries(); ++entry ){
+            events.push_back( treeReader.buildEvent( entry ) );
+        }
+        break;
+    }
+    if( events.empty() ){
+        throw std::runtime_error( "No simulated events found to run the benchmarks on." );
+    }
+    return events;
+}
+
+
+void lorentzVectorBenchmarks( BenchmarkRecorder& recorder ){
+    const size_t numberOfVectors = 100000;
+    std::vector< LorentzVector > vectors = randomLorentzVectors( numberOfVectors );
+
+    recorder.run( "LorentzVector_sum", numberOfVectors, [&](){
+        LorentzVector sum;
+        for( const auto& vector : vectors ){
+            sum += vector;
+        }
+        return sum.mass();
+    } );
+
+    recorder.run( "LorentzVector_pairMass", numberOfVectors - 1, [&](){
+        double total = 0.;
+        for( size_t i = 0; i < numberOfVectors - 1; ++i ){
+            total += ( vectors[ i ] + vectors[ i + 1 ] ).mass();
+        }
+        return total;
+    } );
+
+    recorder.run( "deltaR", numberOfVectors - 1, [&](){
+        double total = 0.;
+        for( size_t i = 0; i < numberOfVectors - 1; ++i ){
+            total += deltaR( vectors[ i ], vectors[ i + 1 ] );
+        }
+        return total;
+    } );
+}
+
+
+void eventBenchmarks( BenchmarkRecorder& recorder, const std::vector< Event >& events ){
+
+    recorder.run( "cleanJetsFromLeptons", events.size(), [&](){
+        double total = 0.;
+        for( const auto& event : events ){
+            JetCollection jets( event.jetCollection() );
+            jets.cleanJetsFromFOLeptons( event.leptonCollection() );
+            total += jets.size();
+        }
+        return total;
+    } );
+
+    long unsigned numberOfLeptons = 0;
+    for( const auto& event : events ){
+        numberOfLeptons += event.leptonCollection().size();
+    }
+    recorder.run( "LeptonSelector", numberOfLeptons, [&](){
+        double total = 0.;
+        for( const auto& event : events ){
+            for( const auto& leptonPtr : event.leptonCollection() ){
+                total += leptonPtr->isLoose() + leptonPtr->isFO() + leptonPtr->isTight();
+            }
+        }
+        return total;
+    } );
+}
+
+
+void histogramBenchmarks( BenchmarkRecorder& recorder ){
+    const size_t numberOfValues = 100000;
+    TH1D hist( "benchmarkHist", "benchmarkHist", 50, 0, 500 );
+    std::mt19937 random_engine( 1234 );
+    std::uniform_real_distribution< double > value_distribution( -50., 550. );
+    std::vector< double > values;
+    for( size_t i = 0; i < numberOfValues; ++i ){
+        values.push_back( value_distribution( random_engine ) );
+        hist.Fill( values.back() );
+    }
+
+    recorder.run( "histogram_contentAtValue", numberOfValues, [&](){
+        double total = 0.;
+        for( auto value : values ){
+            total += histogram::contentAtValue( &hist, value );
+        }
+        return total;
+    } );
+}
+
+
+void bTagCalibrationBenchmarks( BenchmarkRecorder& recorder ){
+    BTagCalibration calibration( "", weightDirectory + "weightFiles/bTagSF/DeepCSV_2016LegacySF_WP_V1.csv" );
+    BTagCalibrationReader reader( BTagEntry::OP_MEDIUM, "central", { "up", "down" } );
+    reader.load( calibration, BTagEntry::FLAV_B, "comb" );
+
+    std::vector< LorentzVector > vectors = randomLorentzVectors( 100000 );
+    recorder.run( "BTagCalibrationReader_eval", vectors.size(), [&](){
+        double total = 0.;
+        for( const auto& vector : vectors ){
+            total += reader.eval( BTagEntry::FLAV_B, vector.eta(), vector.pt() );
+        }
+        return total;
+    } );
+}
+
+
+void reweighterBenchmarks( BenchmarkRecorder& recorder, const std::vector< Event >& events, const std::vector< Sample >& samples ){
+    EwkinoReweighterFactory reweighterFactory;
+    std::map< std::string, CombinedReweighter > reweighters;
+    for( const auto& year : { "2016", "2017", "2018" } ){
+        reweighters[ year ] = reweighterFactory.buildReweighter( weightDirectory, year, samples );
+    }
+
+    const Event& firstEvent = events.front();
+    const CombinedReweighter& reweighter = reweighters.at( firstEvent.is2016() ? "2016" : ( firstEvent.is2017() ? "2017" : "2018" ) );
+    recorder.run( "CombinedReweighter_totalWeight", events.size(), [&](){
+        double total = 0.;
+        for( const auto& event : events ){
+            total += reweighter.totalWeight( event );
+        }
+        return total;
+    } );
+}
+
+
+//events per second for building events, including reading them from disk
+void buildEventBenchmark( BenchmarkRecorder& recorder, const std::string& sampleList ){
+    TreeReader treeReader( sampleList, "../testData" );
+    long unsigned numberOfEvents = 0;
+    for( unsigned sampleIndex = 0; sampleIndex < treeReader.numberOfSamples(); ++sampleIndex ){
+        treeReader.initSample();
+        numberOfEvents += treeReader.numberOfEntries();
+    }
+    recorder.run( "buildEvent", numberOfEvents, [&](){
+        double total = 0.;
+        TreeReader reader( sampleList, "../testData" );
+        for( unsigned sampleIndex = 0; sampleIndex < reader.numberOfSamples(); ++sampleIndex ){
+            reader.initSample();
+            for( long unsigned entry = 0; entry < reader.numberOfEntries(); ++entry ){
+                Event event = reader.buildEvent( entry );
+                total += event.numberOfLeptons();
+            }
+        }
+        return total;
+    }, 3 );
+}
+
+
+//events per second of the event loop in test/Event/Event_loop_example.cc
+void eventLoopBenchmark( BenchmarkRecorder& recorder, const std::string& sampleList ){
+    TreeReader treeReader( sampleList, "../testData" );
+    long unsigned numberOfEvents = 0;
+    for( unsigned sampleIndex = 0; sampleIndex < treeReader.numberOfSamples(); ++sampleIndex ){
+        treeReader.initSample();
+        numberOfEvents += treeReader.numberOfEntries();
+    }
+    recorder.run( "Event_loop_example", numberOfEvents, [&](){
+        double total = 0.;
+        TreeReader reader( sampleList, "../testData" );
+        for( unsigned sampleIndex = 0; sampleIndex < reader.numberOfSamples(); ++sampleIndex ){
+            reader.initSample();
+            for( long unsigned entry = 0; entry < reader.numberOfEntries(); ++entry ){
+                Event event = reader.buildEvent( entry );
+                event.cleanElectronsFromLooseMuons();
+                event.cleanJetsFromFOLeptons();
+                event.selectTightLeptons();
+                if( event.numberOfLeptons() != 3 ) continue;
+                if( event.numberOfMediumBTaggedJets() != 2 ) continue;
+                ++total;
+            }
+        }
+        return total;
+    }, 3 );
+}
+
+
+int main( int argc, char* argv[] ){
+    std::vector< std::string > argvStr( &argv[0], &argv[0] + argc );
+    std::string revision = ( argc > 1 ) ? argvStr[1] : "unknown";
+    std::string outputFileName = ( argc > 2 ) ? argvStr[2] : "benchmarkResults.json";
+
+    BenchmarkRecorder recorder( revision );
+
+    //micro-benchmarks
+    lorentzVectorBenchmarks( recorder );
+    histogramBenchmarks( recorder );
+    bTagCalibrationBenchmarks( recorder );
+
+    TreeReader treeReader;
+    treeReader.readSamples( "../testData/samples_test.txt", "../testData" );
+    std::vector< Event > events = readEvents( treeReader );
+    eventBenchmarks( recorder, events );
+    reweighterBenchmarks( recorder, events, treeReader.sampleVector() );
+
+    //macro-benchmarks
+    buildEventBenchmark( recorder, "../testData/samples_test.txt" );
+    eventLoopBenchmark( recorder, "../testData/testsamplelist.txt" );
+
+    recorder.write( outputFileName );
+    return 0;
+}
@@ -0,0 +1,33 @@
+import json
+import sys
+
+
+#compare the benchmark results of two revisions stored in the JSON lines file written by the benchmarks executable
+#usage : python compareBenchmarks.py <results file> <reference revision> <new revision>
+def readResults( file_name ):
+    results = {}
+    with open( file_name ) as f:
+        for line in f:
+            if not line.strip():
+                continue
+            entry = json.loads( line )
+            results[ ( entry['revision'], entry['benchmark'] ) ] = entry
+    return results
+
+
+def compareRevisions( results, reference, new ):
+    benchmarks = sorted( set( benchmark for revision, benchmark in results if revision == reference ) )
+    print( '{:<35}{:>15}{:>15}{:>10}'.format( 'benchmark', reference[:14], new[:14], 'speedup' ) )
+    for benchmark in benchmarks:
+        if ( new, benchmark ) not in results:
+            continue
+        reference_time = results[ ( reference, benchmark ) ]['nsPerItem']
+        new_time = results[ ( new, benchmark ) ]['nsPerItem']
+        print( '{:<35}{:>15.1f}{:>15.1f}{:>10.2f}'.format( benchmark, reference_time, new_time, reference_time / new_time ) )
+
+
+if __name__ == '__main__':
+    if len( sys.argv ) != 4:
+        print( 'Usage : python compareBenchmarks.py <results file> <reference revision> <new revision>' )
+        sys.exit( 1 )
+    compareRevisions( readResults( sys.argv[1] ), sys.argv[2], sys.argv[3] )
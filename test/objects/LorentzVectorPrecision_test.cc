@@ -0,0 +1,54 @@
+//include class to test 
+#include "../../objects/interface/LorentzVector.h"
+
+//include c++ library classes
+#include <cmath>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+
+//invariant mass of a set of vectors, computed in long double from the same cartesian coordinates as in a double precision build
+long double referenceMass( const std::vector< std::vector< double > >& components ){
+    long double px = 0, py = 0, pz = 0, energy = 0;
+    for( const auto& vector : components ){
+        long double pt = vector[ 0 ];
+        px += pt*std::cos( static_cast< long double >( vector[ 2 ] ) );
+        py += pt*std::sin( static_cast< long double >( vector[ 2 ] ) );
+        pz += pt*std::sinh( static_cast< long double >( vector[ 1 ] ) );
+        energy += vector[ 3 ];
+    }
+    return std::sqrt( energy*energy - px*px - py*py - pz*pz );
+}
+
+
+//build with PRECISION=float ( see buildConfigurations.mk ) to check the float precision build against the double precision computation
+int main(){
+
+    //boosted pairs of light objects, where the mass results from a large cancellation between the energy and the momentum
+    //pt, eta and phi are exactly representable as float, so a float precision build stores the same directions as a double precision build
+    const double constituentMass = 0.1;
+    for( const double pt : { 250., 1000., 2500. } ){
+        for( const double deltaPhi : { 0.0078125, 0.001953125 } ){
+            std::vector< std::vector< double > > components;
+            for( const auto& direction : std::vector< std::pair< double, double > >( { { 0.5, 0.25 }, { 0.5, 0.25 + deltaPhi } } ) ){
+                double momentum = pt*std::cosh( direction.first );
+                components.push_back( { pt, direction.first, direction.second, std::sqrt( momentum*momentum + constituentMass*constituentMass ) } );
+            }
+
+            LorentzVector pair;
+            for( const auto& vector : components ){
+                pair += LorentzVector( vector[ 0 ], vector[ 1 ], vector[ 2 ], vector[ 3 ] );
+            }
+            long double expected = referenceMass( components );
+            if( std::fabs( pair.mass() - expected ) > 1e-6*expected ){
+                throw std::runtime_error( "Mass of a pair with pt " + std::to_string( pt ) + " and deltaPhi " + std::to_string( deltaPhi ) + " is " + std::to_string( pair.mass() )
+                    + " while " + std::to_string( static_cast< double >( expected ) ) + " is expected." );
+            }
+        }
+    }
+    std::cout << "Masses of boosted pairs agree with the double precision computation" << std::endl;
+
+    return 0;
+}
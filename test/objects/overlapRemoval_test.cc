@@ -0,0 +1,74 @@
+
+//include code to test 
+#include "../../objects/interface/overlapRemoval.h"
+#include "../../objects/interface/LorentzVector.h"
+
+//include c++ library classes
+#include <iostream>
+#include <random>
+#include <vector>
+#include <cmath>
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+
+
+std::vector< LorentzVector > randomVectors( std::mt19937& random_engine, const unsigned numberOfVectors ){
+    std::uniform_real_distribution< double > eta_distribution( -2.5, 2.5 );
+    std::uniform_real_distribution< double > phi_distribution( -M_PI, M_PI );
+    std::vector< LorentzVector > vectors;
+    for( unsigned i = 0; i < numberOfVectors; ++i ){
+        vectors.push_back( LorentzVector( 50., eta_distribution( random_engine ), phi_distribution( random_engine ), 100. ) );
+    }
+    return vectors;
+}
+
+
+int main(){
+    std::mt19937 random_engine( 42 );
+    std::uniform_int_distribution< unsigned > size_distribution( 0, 12 );
+    const double coneSize = 0.4;
+
+    //float precision builds store the directions as float, in which case agreement is only expected up to float rounding
+    const bool floatPrecision = std::is_same< object_float_type, float >::value;
+    const double tolerance = floatPrecision ? 1e-4 : 1e-9;
+
+    //compare the batched computation to pairwise deltaR computations for many random collections
+    unsigned numberOfRemoved = 0;
+    for( unsigned trial = 0; trial < 10000; ++trial ){
+        std::vector< LorentzVector > objects = randomVectors( random_engine, size_distribution( random_engine ) );
+        std::vector< LorentzVector > references = randomVectors( random_engine, size_distribution( random_engine ) );
+
+        overlapRemoval::EtaPhiArrays objectDirections;
+        for( const auto& object : objects ) objectDirections.push_back( object );
+        overlapRemoval::EtaPhiArrays referenceDirections;
+        for( const auto& reference : references ) referenceDirections.push_back( reference );
+
+        std::vector< unsigned char > mask = overlapRemoval::keepMask( objectDirections, referenceDirections, coneSize );
+        std::vector< object_float_type > minimalValues = overlapRemoval::minDeltaR2( objectDirections, referenceDirections );
+        if( mask.size() != objects.size() || minimalValues.size() != objects.size() ){
+            throw std::runtime_error( "overlapRemoval output has the wrong size." );
+        }
+        for( size_t i = 0; i < objects.size(); ++i ){
+            double minDeltaR = std::numeric_limits< double >::infinity();
+            for( const auto& reference : references ){
+                minDeltaR = std::min( minDeltaR, deltaR( objects[ i ], reference ) );
+            }
+            if( std::fabs( std::sqrt( minimalValues[ i ] ) - minDeltaR ) > tolerance && !std::isinf( minDeltaR ) ){
+                throw std::runtime_error( "overlapRemoval::minDeltaR2 gives " + std::to_string( std::sqrt( minimalValues[ i ] ) ) + " while the minimal deltaR is " + std::to_string( minDeltaR ) + "." );
+            }
+            bool keep = !( minDeltaR < coneSize );
+            if( floatPrecision && std::fabs( minDeltaR - coneSize ) < tolerance ) continue;
+            if( keep != static_cast< bool >( mask[ i ] ) ){
+                throw std::runtime_error( "overlapRemoval::keepMask does not agree with pairwise deltaR for minimal deltaR " + std::to_string( minDeltaR ) + "." );
+            }
+            numberOfRemoved += !keep;
+        }
+    }
+    if( numberOfRemoved == 0 ){
+        throw std::runtime_error( "no overlapping objects were generated, the test is not sensitive." );
+    }
+    std::cout << "overlapRemoval_test : " << numberOfRemoved << " overlapping objects found, all consistent with pairwise deltaR." << std::endl;
+    return 0;
+}
@@ -1,10 +1,13 @@
 
 #include "../../weights/interface/CombinedReweighter.h"
 #include "../../weights/interface/ConcreteReweighterFactory.h"
+#include "../../weights/interface/ReweighterBTag.h"
 
 //include c++ library classes
 #include <iostream>
 #include <memory>
+#include <stdexcept>
+#include <cmath>
 
 //include ROOT classes
 #include "TFile.h"
@@ -40,6 +43,37 @@ int main(){
         for( long unsigned entry = 0; entry < treeReader.numberOfEntries();  ++entry ){
             Event event = treeReader.buildEvent( entry );
 
+            //the single pass evaluation should reproduce the separately computed weights
+            const CombinedReweighter& reweighter = ( event.is2016() ? reweighter_2016 : ( event.is2017() ? reweighter_2017 : reweighter_2018 ) );
+            CombinedWeightVariations variations = reweighter.weightVariations( event );
+            if( std::fabs( variations.nominal() - reweighter.totalWeight( event ) ) > 1e-6 * std::fabs( reweighter.totalWeight( event ) ) ){
+                throw std::runtime_error( "Nominal weight computed in one pass differs from CombinedReweighter::totalWeight." );
+            }
+            for( const auto& name : { "muonID", "electronID", "pileup", "prefire", "bTag_heavy", "bTag_light" } ){
+                const WeightVariations& single = variations.variations( name );
+                const Reweighter* singleReweighter = reweighter[ name ];
+                if( std::fabs( single.nominal - singleReweighter->weight( event ) ) > 1e-6 * std::fabs( singleReweighter->weight( event ) )
+                    || std::fabs( single.down - singleReweighter->weightDown( event ) ) > 1e-6 * std::fabs( singleReweighter->weightDown( event ) )
+                    || std::fabs( single.up - singleReweighter->weightUp( event ) ) > 1e-6 * std::fabs( singleReweighter->weightUp( event ) ) ){
+                    throw std::runtime_error( std::string( "Variations of Reweighter '" ) + name + "' computed in one pass differ from the separate computation." );
+                }
+            }
+
+            //weights for the nominal jets computed together with the jet variations should be identical
+            CombinedWeightVariations jetVariations = reweighter.weightVariations( event, true );
+            if( jetVariations.nominal() != variations.nominal() || jetVariations.ratioDown( "bTag_heavy" ) != variations.ratioDown( "bTag_heavy" ) ){
+                throw std::runtime_error( "Weights computed together with the jet variations differ from the nominal weights." );
+            }
+
+            //the b-tag weight of the JEC down variation should match the weight of the varied jet collection
+            double bTagJECDown = 1.;
+            for( const auto& jetPtr : event.jetCollection().JECDownCollection() ){
+                bTagJECDown *= dynamic_cast< const ReweighterBTag* >( reweighter[ "bTag_light" ] )->weight( *jetPtr );
+            }
+            if( std::fabs( jetVariations.variations( "bTag_light", JECDownJets ).nominal - bTagJECDown ) > 1e-6 * std::fabs( bTagJECDown ) ){
+                throw std::runtime_error( "b-tag weight for JEC down varied jets is " + std::to_string( jetVariations.variations( "bTag_light", JECDownJets ).nominal ) + ", while the varied jet collection gives " + std::to_string( bTagJECDown ) );
+            }
+
             if( event.is2016() ){
                 std::cout << "~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~" << std::endl;
                 std::cout << reweighter_2016.totalWeight( event ) << std::endl;
@@ -49,7 +83,8 @@ int main(){
                 std::cout << "reweighter_2016[ electronReco_pTAbove20 ].weight( event ) = " << reweighter_2016[ "electronReco_pTAbove20" ]->weight( event ) << std::endl;
                 std::cout << "reweighter_2016[ pileup ].weight( event ) = " << reweighter_2016[ "pileup" ]->weight( event ) << std::endl;
                 std::cout << "reweighter_2016[ prefire ].weight( event ) = " << reweighter_2016[ "prefire" ]->weight( event ) << std::endl;
-                std::cout << "reweighter_2016[ bTag ].weight( event ) = " << reweighter_2016[ "bTag" ]->weight( event ) << std::endl;
+                std::cout << "reweighter_2016[ bTag_heavy ].weight( event ) = " << reweighter_2016[ "bTag_heavy" ]->weight( event ) << std::endl;
+                std::cout << "reweighter_2016[ bTag_light ].weight( event ) = " << reweighter_2016[ "bTag_light" ]->weight( event ) << std::endl;
             } 
         }
     }
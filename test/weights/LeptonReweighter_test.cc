@@ -104,6 +104,11 @@ int main(){
                 if( ! doubleEqual( weightUp, weightUpManual ) ){
                     throw std::runtime_error( "Up varied muon weight given by Reweighter is " + std::to_string( weightUp ) + ", while manual computation gives " + std::to_string( weightUpManual ) );
                 }
+
+                WeightVariations variations = muonReweighter.weightVariations( *muonPtr );
+                if( ! ( doubleEqual( variations.nominal, nominalWeight ) && doubleEqual( variations.down, weightDown ) && doubleEqual( variations.up, weightUp ) ) ){
+                    throw std::runtime_error( "Muon weight variations computed in one pass differ from the separately computed weights." );
+                }
                     
             }
             for( const auto& electronPtr : event.electronCollection() ){
@@ -126,6 +131,11 @@ int main(){
                     throw std::runtime_error( "Up varied electron weight given by Reweighter is " + std::to_string( weightUp ) + ", while manual computation gives " + std::to_string( weightUpManual ) );
                 }
 
+                WeightVariations variations = electronReweighter.weightVariations( *electronPtr );
+                if( ! ( doubleEqual( variations.nominal, nominalWeight ) && doubleEqual( variations.down, weightDown ) && doubleEqual( variations.up, weightUp ) ) ){
+                    throw std::runtime_error( "Electron weight variations computed in one pass differ from the separately computed weights." );
+                }
+
             }
         }
     }
@@ -3,6 +3,9 @@
 //include c++ library classes
 #include <iostream>
 #include <memory>
+#include <cmath>
+#include <stdexcept>
+#include <string>
 
 //include ROOT classes
 #include "TFile.h"
@@ -28,13 +31,34 @@ int main(){
 
         //load next sample
         treeReader.initSample();
+        if( treeReader.isData() ) continue;
+
+        //read the central weights of this sample to compare to
+        const Sample& sample = treeReader.currentSample();
+        const std::string yearSuffix = ( sample.is2016() ? "2016" : ( sample.is2017() ? "2017" : "2018" ) );
+        TFile* weightFilePtr = TFile::Open( ( "../../weights/weightFiles/pileupWeights/pileupWeights_" + sample.fileName() ).c_str() );
+        std::shared_ptr< TH1 > centralWeights( dynamic_cast< TH1* >( weightFilePtr->Get( ( "pileupWeights_" + yearSuffix + "_central" ).c_str() ) ) );
+        centralWeights->SetDirectory( gROOT );
+        weightFilePtr->Close();
 
         //loop over events in sample
         for( long unsigned entry = 0; entry < treeReader.numberOfEntries(); ++entry ){
             Event event = treeReader.buildEvent( entry );
-            reweighterPileup.weight( event);
-            reweighterPileup.weightDown( event);
-            reweighterPileup.weightUp( event);
+            double weight = reweighterPileup.weight( event);
+            double weightDown = reweighterPileup.weightDown( event);
+            double weightUp = reweighterPileup.weightUp( event);
+
+            //all variations come from the same table entry
+            WeightVariations variations = reweighterPileup.weightVariations( event );
+            if( variations.nominal != weight || variations.down != weightDown || variations.up != weightUp ){
+                throw std::runtime_error( "Pileup weight variations differ from the separately retrieved weights." );
+            }
+
+            //the table lookup should agree with the weight histogram at the number of true interactions
+            double histogramWeight = histogram::contentAtValue( centralWeights.get(), event.generatorInfo().numberOfTrueInteractions() );
+            if( std::fabs( histogramWeight - weight ) > 1e-6 * std::fabs( histogramWeight ) ){
+                throw std::runtime_error( "Pileup weight from the table is " + std::to_string( weight ) + ", while the histogram gives " + std::to_string( histogramWeight ) );
+            }
         }
     }
 
@@ -0,0 +1,100 @@
+#include "../../weights/interface/ScaleFactorBundle.h"
+
+//include c++ library classes
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+//include ROOT classes
+#include "TH2D.h"
+
+//include other parts of framework
+#include "../../Tools/interface/LookupTable2D.h"
+#include "../../Tools/interface/histogramTools.h"
+
+
+void compareToHistogram( const LookupTable2D& table, TH2* hist ){
+    std::random_device seeder;
+    std::ranlux48 random_engine( seeder() );
+
+    //also probe values outside of the histogram range
+    std::uniform_real_distribution< double > x_distribution( 0., 800. );
+    std::uniform_real_distribution< double > y_distribution( -1., 3. );
+    for( unsigned i = 0; i < 100000; ++i ){
+        double x = x_distribution( random_engine );
+        double y = y_distribution( random_engine );
+        LookupTable2D::size_type bin = table.findBin( x, y );
+        if( table.content( bin ) != histogram::contentAtValues( hist, x, y )
+            || table.contentDown( bin ) != histogram::contentDownAtValues( hist, x, y )
+            || table.contentUp( bin ) != histogram::contentUpAtValues( hist, x, y ) ){
+            throw std::runtime_error( "LookupTable2D gives a different value than the histogram at ( " + std::to_string( x ) + ", " + std::to_string( y ) + " )." );
+        }
+    }
+}
+
+
+int main(){
+
+    //histogram with variable binning as used for b-tagging efficiencies
+    const std::vector< double > ptBins = { 20, 25, 30, 35, 40, 45, 50, 60, 70, 80, 90, 100, 120, 150, 200, 300, 400, 600 };
+    const std::vector< double > etaBins = { 0, 0.4, 0.8, 1.2, 1.6, 2.0, 2.4 };
+    TH2D hist( "efficiency", "efficiency", ptBins.size() - 1, &ptBins[0], etaBins.size() - 1, &etaBins[0] );
+    for( int x = 1; x <= hist.GetNbinsX(); ++x ){
+        for( int y = 1; y <= hist.GetNbinsY(); ++y ){
+            hist.SetBinContent( x, y, 0.5 + 0.01 * x - 0.02 * y );
+            hist.SetBinError( x, y, 0.001 * ( x + y ) );
+        }
+    }
+
+    LookupTable2D table( &hist );
+    compareToHistogram( table, &hist );
+
+    //write a bundle and check that the memory-mapped tables are identical
+    //the text entry is stamped with a source file to check that changes to it are recognized
+    const std::string bundlePath = "scaleFactorBundle_test.bin";
+    const std::string sourcePath = "scaleFactorBundle_test.csv";
+    std::ofstream( sourcePath ) << "OperatingPoint, measurementType\n";
+    ScaleFactorBundleWriter writer;
+    writer.addLookupTable( "bTagEff.root:efficiency", table, scaleFactorBundle::SourceStamp() );
+    writer.addPileupTable( "pileupWeights_sample.root:pileupWeights_2016", 2, { 1., 0.9, 1.1, 2., 1.8, 2.2 }, scaleFactorBundle::SourceStamp() );
+    writer.addText( "bTagSF.csv", "OperatingPoint, measurementType\n", scaleFactorBundle::sourceStamp( sourcePath ) );
+    writer.write( bundlePath );
+
+    LookupTable2D mappedTable;
+    {
+        std::shared_ptr< const ScaleFactorBundle > bundle = ScaleFactorBundle::open( bundlePath );
+        mappedTable = bundle->lookupTable( "bTagEff.root:efficiency" );
+
+        int minimumNumberOfTrueInteractions;
+        ScaleFactorBundle::size_type numberOfEntries;
+        const double* pileupWeights = bundle->pileupTable( "pileupWeights_sample.root:pileupWeights_2016", minimumNumberOfTrueInteractions, numberOfEntries );
+        if( minimumNumberOfTrueInteractions != 2 || numberOfEntries != 2 || pileupWeights[ 5 ] != 2.2 ){
+            throw std::runtime_error( "Pileup table read from the bundle differs from the one written." );
+        }
+        if( bundle->text( "bTagSF.csv" ) != "OperatingPoint, measurementType\n" ){
+            throw std::runtime_error( "Text read from the bundle differs from the one written." );
+        }
+
+        if( !bundle->isUpToDate( "bTagSF.csv", sourcePath ) ){
+            throw std::runtime_error( "Bundle entry is out of date although its source file did not change." );
+        }
+        if( bundle->isUpToDate( "bTagEff.root:efficiency", sourcePath ) || bundle->isUpToDate( "bTagSF.csv", "missing.csv" ) ){
+            throw std::runtime_error( "Bundle entry is up to date for a different or missing source file." );
+        }
+        std::ofstream( sourcePath, std::ios_base::app ) << "1, comb\n";
+        if( bundle->isUpToDate( "bTagSF.csv", sourcePath ) ){
+            throw std::runtime_error( "Bundle entry is up to date although its source file changed." );
+        }
+    }
+
+    //the table keeps the mapping alive after the bundle went out of scope
+    compareToHistogram( mappedTable, &hist );
+    std::remove( bundlePath.c_str() );
+    std::remove( sourcePath.c_str() );
+
+    return 0;
+}
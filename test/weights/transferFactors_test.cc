@@ -0,0 +1,130 @@
+#include "../../weights/interface/transferFactors.h"
+
+//include c++ library classes
+#include <cmath>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+//include ROOT classes
+#include "TH2D.h"
+
+//include other parts of framework
+#include "../../Tools/interface/histogramTools.h"
+#include "../../TreeReader/interface/TreeReader.h"
+
+
+void fillMap( TH2D& hist, const double offset ){
+    for( int x = 1; x <= hist.GetNbinsX(); ++x ){
+        for( int y = 1; y <= hist.GetNbinsY(); ++y ){
+            hist.SetBinContent( x, y, offset + 0.02 * x + 0.01 * y );
+            hist.SetBinError( x, y, 0.001 * ( x + y ) );
+        }
+    }
+}
+
+
+void compareWeight( const double weight, const double expected, const std::string& weightName ){
+    if( std::fabs( weight - expected ) > 1e-12 * std::fabs( expected ) ){
+        throw std::runtime_error( weightName + " computed in one pass is " + std::to_string( weight ) + " while the single map gives " + std::to_string( expected ) + "." );
+    }
+}
+
+
+int main(){
+
+    //binning as used for the fake-rate maps
+    const std::vector< double > ptBins = { 10, 15, 20, 25, 35, 45 };
+    const std::vector< double > etaBins = { 0, 0.8, 1.479, 2.5 };
+    TH2D central( "fakeRate", "fakeRate", ptBins.size() - 1, &ptBins[0], etaBins.size() - 1, &etaBins[0] );
+    TH2D down( "fakeRate_down", "fakeRate_down", ptBins.size() - 1, &ptBins[0], etaBins.size() - 1, &etaBins[0] );
+    TH2D up( "fakeRate_up", "fakeRate_up", ptBins.size() - 1, &ptBins[0], etaBins.size() - 1, &etaBins[0] );
+    fillMap( central, 0.1 );
+    fillMap( down, 0.05 );
+    fillMap( up, 0.15 );
+
+    LookupTable2D variedMap( &central, { &down, &up } );
+    LookupTable2D uncertaintyMap( &central );
+    if( variedMap.numberOfVariations() != 2 || uncertaintyMap.numberOfVariations() != 2 ){
+        throw std::runtime_error( "LookupTable2D has the wrong number of variations." );
+    }
+
+    std::random_device seeder;
+    std::ranlux48 random_engine( seeder() );
+
+    //also probe values outside of the map range
+    std::uniform_real_distribution< double > x_distribution( 0., 100. );
+    std::uniform_real_distribution< double > y_distribution( -0.5, 3. );
+    for( unsigned i = 0; i < 100000; ++i ){
+        double x = x_distribution( random_engine );
+        double y = y_distribution( random_engine );
+        const double* rates = variedMap.valuesAtValues( x, y );
+        if( rates[ 0 ] != histogram::contentAtValues( &central, x, y )
+            || rates[ 1 ] != histogram::contentAtValues( &down, x, y )
+            || rates[ 2 ] != histogram::contentAtValues( &up, x, y ) ){
+            throw std::runtime_error( "LookupTable2D gives a different value than the varied histograms at ( " + std::to_string( x ) + ", " + std::to_string( y ) + " )." );
+        }
+        LookupTable2D::size_type bin = uncertaintyMap.findBin( x, y );
+        if( uncertaintyMap.value( bin, 0 ) != histogram::contentAtValues( &central, x, y )
+            || uncertaintyMap.value( bin, 1 ) != histogram::contentDownAtValues( &central, x, y )
+            || uncertaintyMap.value( bin, 2 ) != histogram::contentUpAtValues( &central, x, y ) ){
+            throw std::runtime_error( "LookupTable2D with uncertainty variations gives a different value than the histogram at ( " + std::to_string( x ) + ", " + std::to_string( y ) + " )." );
+        }
+    }
+
+    //every weight computed in one pass must equal the weight of the corresponding single map
+    //the muon and electron maps are made different so a mixup of the flavors is noticed
+    TH2D electronDown( "electronFakeRate_down", "electronFakeRate_down", ptBins.size() - 1, &ptBins[0], etaBins.size() - 1, &etaBins[0] );
+    fillMap( electronDown, 0.02 );
+    LookupTable2D electronMap( &central, { &electronDown } );
+    const std::vector< LookupTable2D > muonSingleMaps = { LookupTable2D( &central, {} ), LookupTable2D( &down, {} ), LookupTable2D( &up, {} ) };
+    const std::vector< LookupTable2D > electronSingleMaps = { LookupTable2D( &central, {} ), LookupTable2D( &electronDown, {} ) };
+    const double maxPt = 35.;
+
+    TreeReader treeReader;
+    treeReader.readSamples( "../testData/samples_test.txt", "../testData" );
+    std::vector< double > fakeRateWeights;
+    std::vector< double > chargeFlipWeights;
+    for( unsigned sampleIndex = 0; sampleIndex < treeReader.numberOfSamples(); ++sampleIndex ){
+        treeReader.initSample();
+        for( long unsigned entry = 0; entry < treeReader.numberOfEntries(); ++entry ){
+            Event event = treeReader.buildEvent( entry );
+
+            //the weights are ordered as the nominal weight, the muon variations and the electron variations
+            transferFactors::fakeRateWeights( event, variedMap, electronMap, fakeRateWeights, maxPt );
+            if( fakeRateWeights.size() != 4 ){
+                throw std::runtime_error( "transferFactors::fakeRateWeights gives " + std::to_string( fakeRateWeights.size() ) + " weights instead of 4." );
+            }
+            compareWeight( fakeRateWeights[ 0 ], transferFactors::fakeRateWeight( event, muonSingleMaps[ 0 ], electronSingleMaps[ 0 ], maxPt ), "Nominal fake-rate weight" );
+            for( unsigned v = 1; v < muonSingleMaps.size(); ++v ){
+                compareWeight( fakeRateWeights[ v ], transferFactors::fakeRateWeight( event, muonSingleMaps[ v ], electronSingleMaps[ 0 ], maxPt ), "Fake-rate weight of muon variation " + std::to_string( v ) );
+            }
+            for( unsigned v = 1; v < electronSingleMaps.size(); ++v ){
+                compareWeight( fakeRateWeights[ muonSingleMaps.size() + v - 1 ], transferFactors::fakeRateWeight( event, muonSingleMaps[ 0 ], electronSingleMaps[ v ], maxPt ), "Fake-rate weight of electron variation " + std::to_string( v ) );
+            }
+
+            transferFactors::chargeFlipWeights( event, variedMap, chargeFlipWeights );
+            if( chargeFlipWeights.size() != muonSingleMaps.size() ){
+                throw std::runtime_error( "transferFactors::chargeFlipWeights gives " + std::to_string( chargeFlipWeights.size() ) + " weights instead of " + std::to_string( muonSingleMaps.size() ) + "." );
+            }
+            for( unsigned v = 0; v < muonSingleMaps.size(); ++v ){
+                compareWeight( chargeFlipWeights[ v ], transferFactors::chargeFlipWeight( event, muonSingleMaps[ v ] ), "Charge-flip weight of variation " + std::to_string( v ) );
+            }
+        }
+    }
+
+    //maps with a different binning can not be combined
+    TH2D otherBinning( "otherBinning", "otherBinning", 5, 10, 45, 3, 0, 2.5 );
+    bool binningMismatchCaught = false;
+    try{
+        LookupTable2D mismatchedMap( &central, { &otherBinning } );
+    } catch( const std::invalid_argument& ){
+        binningMismatchCaught = true;
+    }
+    if( !binningMismatchCaught ){
+        throw std::runtime_error( "LookupTable2D accepted a varied map with a different binning." );
+    }
+
+    return 0;
+}
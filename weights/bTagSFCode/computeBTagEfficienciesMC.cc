@@ -1,40 +1,50 @@
 
 //include c++ library classes
+#include <algorithm>
+#include <atomic>
 #include <fstream>
 #include <memory>
 #include <stdexcept>
+#include <thread>
+#include <utility>
+
+//include ROOT classes
+#include "TROOT.h"
+#include "TH2D.h"
 
 //include other parts of framework
 #include "../../TreeReader/interface/TreeReader.h"
-#include "../../Event/interface/Event.h"
-#include "../../Tools/interface/analysisTools.h"
+#include "../../Event/interface/LeptonCollection.h"
+#include "../../Event/interface/JetCollection.h"
 #include "../../Tools/interface/histogramTools.h"
 #include "../../Tools/interface/systemTools.h"
 #include "../../Tools/interface/stringTools.h"
 
 
-void computeBTagEff( const std::string& year, const std::string& sampleDirectory, const bool cleanJetsFromLooseLeptons, const bool cleanJetsFromFOLeptons ){ //, const bool deepCSV ){
+const std::vector< std::string > years = { "2016", "2017", "2018" };
+const std::vector< std::string > cleaningNames = { "uncleaned", "looseLeptonCleaned", "FOLeptonCleaned" };
+const std::vector< std::string > numeratorOrDenominator = { "numerator", "denominator" };
+const std::vector< std::string > quarkFlavors = { "udsg", "charm", "beauty" };
+const std::vector< std::string > workingPointNames = { "loose", "medium", "tight" };
+
+//only the lepton and jet branches used in the selection and cleaning, the jet flavors and the event weight are read
+const std::vector< std::string > branchPrefixes = { "_nL", "_nMu", "_nEle", "_nLight", "_nTau", "_l", "_dxy", "_dz", "_3dIP", "_relIso", "_miniIso", "_ptRel", "_ptRatio", "_closestJet", "_selectedTrackMult", "_tau", "_decayMode", "_nJets", "_jet", "_weight" };
+
+//numerator and denominator maps for every jet flavor and working point
+using EfficiencyMaps = std::vector< std::vector< std::vector< std::shared_ptr< TH2D > > > >;
+
+//efficiency maps for every year and cleaning scheme
+using EfficiencyMapSet = std::vector< std::vector< EfficiencyMaps > >;
 
-    analysisTools::checkYearString( year ); 
 
-    //make 2D b-tagging efficiency histograms for all jet flavors, and for numerator and denominator
+EfficiencyMaps makeEfficiencyMaps(){
 
     //assume jets below 20 GeV in pT will not be used for b-tagging
     const std::vector< double > ptBins = { 20, 25, 30, 35, 40, 45, 50, 60, 70, 80, 90, 100, 120, 150, 200, 300, 400, 600 };
     const std::vector< double > etaBins = { 0, 0.4, 0.8, 1.2, 1.6, 2.0, 2.4 };
 
-    const std::vector< std::string > numeratorOrDenominator = { "numerator", "denominator" };
-    const std::vector< std::string > quarkFlavors = { "udsg", "charm", "beauty" };
-    const std::vector< std::string > workingPointNames = { "loose", "medium", "tight" };
-
-    //map working points to specific jet selectors
-    typedef bool ( Jet::*passBTag )() const;
-    const std::vector< passBTag > workingPointFunctions = { &Jet::isBTaggedLoose, &Jet::isBTaggedMedium, &Jet::isBTaggedTight };
-
-    std::vector< std::vector< std::vector< std::shared_ptr< TH2D > > > > bTagEfficiencyMaps(
+    EfficiencyMaps bTagEfficiencyMaps(
         numeratorOrDenominator.size(), std::vector< std::vector< std::shared_ptr< TH2D > > >( quarkFlavors.size(), std::vector< std::shared_ptr< TH2D > >( workingPointNames.size() ) ) );
-
-    //initialize histograms
     for( std::vector< std::string >::size_type term = 0; term < numeratorOrDenominator.size(); ++term ){
         for( std::vector< std::string >::size_type flavor = 0; flavor < quarkFlavors.size(); ++flavor ){
             for( std::vector< std::string >::size_type wp = 0; wp < workingPointNames.size(); ++wp ){
@@ -44,20 +54,71 @@ void computeBTagEff( const std::string& year, const std::string& sampleDirectory
             }
         }
     }
+    return bTagEfficiencyMaps;
+}
+
+
+EfficiencyMapSet makeEfficiencyMapSet(){
+    EfficiencyMapSet mapSet( years.size() );
+    for( auto& yearMaps : mapSet ){
+        for( std::vector< std::string >::size_type cleaning = 0; cleaning < cleaningNames.size(); ++cleaning ){
+            yearMaps.push_back( makeEfficiencyMaps() );
+        }
+    }
+    return mapSet;
+}
+
+
+void fillEfficiencyMaps( EfficiencyMaps& bTagEfficiencyMaps, const JetCollection& jetCollection, const double weight ){
+
+    //map working points to specific jet selectors
+    typedef bool ( Jet::*passBTag )() const;
+    static const std::vector< passBTag > workingPointFunctions = { &Jet::isBTaggedLoose, &Jet::isBTaggedMedium, &Jet::isBTaggedTight };
+
+    for( const auto& jetPtr : jetCollection ){
+
+        const Jet& jet = *jetPtr;
+
+        //jet must pass additional requirements for b tagging
+        if( ! jet.inBTagAcceptance() ) continue;
+
+        size_t flavorIndex = ( 0 + ( jet.hadronFlavor() == 4 ) + 2 * ( jet.hadronFlavor() == 5 ) );
+        for( size_t wp = 0; wp < workingPointNames.size(); ++wp ){
+
+            //check that jet passes specified working point for numerator
+            if( ( jet.*workingPointFunctions[wp] )() ){
+                histogram::fillValues( bTagEfficiencyMaps[ 0 ][ flavorIndex ][ wp ].get(), jet.pt(), jet.absEta(), weight );
+            }
+
+            //denominator
+            histogram::fillValues( bTagEfficiencyMaps[ 1 ][ flavorIndex ][ wp ].get(), jet.pt(), jet.absEta(), weight );
+        }
+    }
+}
 
-    //initialize the TreeReader
-    TreeReader treeReader( "sampleLists/samples_bTagEff_" + year + ".txt", sampleDirectory );
 
-    //loop over all samples 
-    for( unsigned i = 0; i < treeReader.numberOfSamples(); ++i ){
-        treeReader.initSample();
+//process ( year, sample ) jobs until none are left, filling the maps of every cleaning scheme in one pass over each sample
+void fillBTagEff( const std::string& sampleDirectory, const std::vector< std::pair< size_t, size_t > >& jobs, std::atomic< size_t >& nextJob, EfficiencyMapSet& mapSet ){
+
+    //every thread has its own reader for each year
+    std::vector< std::shared_ptr< TreeReader > > treeReaders;
+    for( const auto& year : years ){
+        treeReaders.push_back( std::make_shared< TreeReader >( "sampleLists/samples_bTagEff_" + year + ".txt", sampleDirectory ) );
+        treeReaders.back()->setReadGeneratorWeights( false );
+        treeReaders.back()->setReadBranchPrefixes( branchPrefixes );
+    }
+
+    for( size_t job = nextJob++; job < jobs.size(); job = nextJob++ ){
+        size_t yearIndex = jobs[ job ].first;
+        TreeReader& treeReader = *treeReaders[ yearIndex ];
+        treeReader.initSample( treeReader.sampleVector()[ jobs[ job ].second ] );
 
         //loop over events in sample
         for( long unsigned entry = 0; entry < treeReader.numberOfEntries(); ++entry ){
-            Event event = treeReader.buildEvent( entry );
+            treeReader.GetEntry( entry );
 
             //ignore weight differences between samples for better statistics
-            double weight = event.weight();
+            double weight = treeReader._scaledWeight;
             if( weight > 0. ){
                 weight = 1.;
             } else if( weight < 0. ){
@@ -66,40 +127,69 @@ void computeBTagEff( const std::string& year, const std::string& sampleDirectory
                 throw std::runtime_error( "Weight of event is zero." );
             }
 
-            //apply selection to jets 
-            event.selectLooseLeptons();
-            event.cleanElectronsFromLooseMuons();
-            event.cleanTausFromLooseLightLeptons();
-            event.selectGoodJets();
-            if( cleanJetsFromLooseLeptons && !cleanJetsFromFOLeptons ){
-                event.cleanJetsFromLooseLeptons();
-            } else if( !cleanJetsFromLooseLeptons && cleanJetsFromFOLeptons ){
-                event.cleanJetsFromFOLeptons();
-            } else if( !( cleanJetsFromLooseLeptons || cleanJetsFromFOLeptons ) ){
-
-                //no cleaning to do
-            } else {
-                throw std::invalid_argument( "Arguments 'cleanJetsFromLooseLeptons' and 'cleanJetsFromFOLeptons' should not both be true." );
-            }
-            
-            //loop over jets 
-            for( const auto& jetPtr : event.jetCollection() ){
+            //only the leptons and jets are built, instead of complete events
+            LeptonCollection leptonCollection( treeReader );
+            leptonCollection.selectLooseLeptons();
+            leptonCollection.cleanElectronsFromLooseMuons();
+            leptonCollection.cleanTausFromLooseLightLeptons();
 
-                const Jet& jet = *jetPtr;
+            JetCollection jetCollection( treeReader );
+            jetCollection.selectGoodJets();
+            fillEfficiencyMaps( mapSet[ yearIndex ][ 0 ], jetCollection, weight );
 
-                //jet must pass additional requirements for b tagging
-                if( ! jet.inBTagAcceptance() ) continue;
-                    
-                size_t flavorIndex = ( 0 + ( jet.hadronFlavor() == 4 ) + 2 * ( jet.hadronFlavor() == 5 ) );
-                for( size_t wp = 0; wp < workingPointNames.size(); ++wp ){
+            //the cleaned collections share the jets of the uncleaned one
+            JetCollection looseLeptonCleanedJets( jetCollection );
+            looseLeptonCleanedJets.cleanJetsFromLooseLeptons( leptonCollection );
+            fillEfficiencyMaps( mapSet[ yearIndex ][ 1 ], looseLeptonCleanedJets, weight );
+
+            JetCollection FOLeptonCleanedJets( jetCollection );
+            FOLeptonCleanedJets.cleanJetsFromFOLeptons( leptonCollection );
+            fillEfficiencyMaps( mapSet[ yearIndex ][ 2 ], FOLeptonCleanedJets, weight );
+        }
+    }
+}
 
-                    //check that jet passes specified working point for numerator
-                    if( ( jet.*workingPointFunctions[wp] )() ){
-                        histogram::fillValues( bTagEfficiencyMaps[ 0 ][ flavorIndex ][ wp ].get(), jet.pt(), jet.absEta(), weight );
-                    }
 
-                    //denominator
-                    histogram::fillValues( bTagEfficiencyMaps[ 1 ][ flavorIndex ][ wp ].get(), jet.pt(), jet.absEta(), weight );
+void computeBTagEff( const std::string& sampleDirectory, const unsigned numberOfThreads ){
+
+    //the samples of all years are processed as independent jobs
+    std::vector< std::pair< size_t, size_t > > jobs;
+    for( size_t yearIndex = 0; yearIndex < years.size(); ++yearIndex ){
+        TreeReader treeReader( "sampleLists/samples_bTagEff_" + years[ yearIndex ] + ".txt", sampleDirectory );
+        for( size_t sampleIndex = 0; sampleIndex < treeReader.numberOfSamples(); ++sampleIndex ){
+            jobs.push_back( { yearIndex, sampleIndex } );
+        }
+    }
+
+    //every thread fills its own maps, which are summed afterwards
+    //the histograms are not attached to a directory, so the threads do not share any ROOT state
+    TH1::AddDirectory( false );
+    size_t numberOfWorkers = std::max( size_t( 1 ), std::min( size_t( numberOfThreads ), jobs.size() ) );
+    std::vector< EfficiencyMapSet > threadMapSets;
+    for( size_t t = 0; t < numberOfWorkers; ++t ){
+        threadMapSets.push_back( makeEfficiencyMapSet() );
+    }
+
+    std::atomic< size_t > nextJob( 0 );
+    std::vector< std::thread > threadVector;
+    threadVector.reserve( numberOfWorkers );
+    for( size_t t = 0; t < numberOfWorkers; ++t ){
+        threadVector.emplace_back( fillBTagEff, std::cref( sampleDirectory ), std::cref( jobs ), std::ref( nextJob ), std::ref( threadMapSets[ t ] ) );
+    }
+    for( auto& t : threadVector ){
+        t.join();
+    }
+
+    EfficiencyMapSet& mapSet = threadMapSets.front();
+    for( size_t t = 1; t < numberOfWorkers; ++t ){
+        for( size_t yearIndex = 0; yearIndex < years.size(); ++yearIndex ){
+            for( size_t cleaning = 0; cleaning < cleaningNames.size(); ++cleaning ){
+                for( size_t term = 0; term < numeratorOrDenominator.size(); ++term ){
+                    for( size_t flavor = 0; flavor < quarkFlavors.size(); ++flavor ){
+                        for( size_t wp = 0; wp < workingPointNames.size(); ++wp ){
+                            mapSet[ yearIndex ][ cleaning ][ term ][ flavor ][ wp ]->Add( threadMapSets[ t ][ yearIndex ][ cleaning ][ term ][ flavor ][ wp ].get() );
+                        }
+                    }
                 }
             }
         }
@@ -109,27 +199,24 @@ void computeBTagEff( const std::string& year, const std::string& sampleDirectory
     const std::string outputDirectory = "../weightFiles/bTagEff";
     systemTools::makeDirectory( outputDirectory );
 
-    std::string cleaningName;
-    if( cleanJetsFromLooseLeptons ){
-        cleaningName = "looseLeptonCleaned";
-    } else if( cleanJetsFromFOLeptons ){
-        cleaningName = "FOLeptonCleaned";
-    } else {
-        cleaningName = "uncleaned";
-    }
-    const std::string fileName = ( "bTagEff_" + cleaningName + "_" + year + ".root" );
-    std::string outputPath = stringTools::formatDirectoryName( outputDirectory ) + fileName;
-    
-    TFile* outputFilePtr = TFile::Open( outputPath.c_str(), "RECREATE" );
-    for( std::vector< std::string >::size_type flavor = 0; flavor < quarkFlavors.size(); ++flavor ){
-        for( std::vector< std::string >::size_type wp = 0; wp < workingPointNames.size(); ++wp ){
-
-            //divide numerator and denominator and write to file
-            bTagEfficiencyMaps[ 0 ][ flavor ][ wp ]->Divide( bTagEfficiencyMaps[ 1 ][ flavor ][ wp ].get() );
-            bTagEfficiencyMaps[ 0 ][ flavor ][ wp ]->Write( ( "bTagEff_" + workingPointNames[wp] + "_" + quarkFlavors[ flavor ] ).c_str() );
+    for( size_t yearIndex = 0; yearIndex < years.size(); ++yearIndex ){
+        for( size_t cleaning = 0; cleaning < cleaningNames.size(); ++cleaning ){
+            EfficiencyMaps& bTagEfficiencyMaps = mapSet[ yearIndex ][ cleaning ];
+            const std::string fileName = ( "bTagEff_" + cleaningNames[ cleaning ] + "_" + years[ yearIndex ] + ".root" );
+            std::string outputPath = stringTools::formatDirectoryName( outputDirectory ) + fileName;
+
+            TFile* outputFilePtr = TFile::Open( outputPath.c_str(), "RECREATE" );
+            for( std::vector< std::string >::size_type flavor = 0; flavor < quarkFlavors.size(); ++flavor ){
+                for( std::vector< std::string >::size_type wp = 0; wp < workingPointNames.size(); ++wp ){
+
+                    //divide numerator and denominator and write to file
+                    bTagEfficiencyMaps[ 0 ][ flavor ][ wp ]->Divide( bTagEfficiencyMaps[ 1 ][ flavor ][ wp ].get() );
+                    bTagEfficiencyMaps[ 0 ][ flavor ][ wp ]->Write( ( "bTagEff_" + workingPointNames[wp] + "_" + quarkFlavors[ flavor ] ).c_str() );
+                }
+            }
+            outputFilePtr->Close();
         }
     }
-    outputFilePtr->Close();
 }
 
 
@@ -138,35 +225,17 @@ int main(int argc, char* argv[]){
     //convert all input to std::string format for easier handling
     std::vector< std::string > argvStr( &argv[0], &argv[0] + argc );
 
-    //either take 3 command line arguments ( sampleDirectory, year, cleaning ) or 1 ( sampleDirectory ) in which case everything will be run
-    if( !( argvStr.size() == 4 || argvStr.size() == 2 ) ){
-        std::cerr << argc - 1 << " command line arguments given, while 3 or 1 are expected." << std::endl;
-        std::cerr << "Usage ( to determine the efficiencies for all years and cleaning options ): ./computeBTagEfficienciesMC sampleDirectory" << std::endl;
-        std::cerr << "Or ( to determine the efficiencies for one year and cleaning option ): ./computeBTagEfficienciesMC sampleDirectory year cleaningSchem ( = looseLeptons, FOLeptons, uncleaned )" << std::endl;
+    //take the sample directory, and optionally the number of threads
+    if( !( argvStr.size() == 2 || argvStr.size() == 3 ) ){
+        std::cerr << argc - 1 << " command line arguments given, while 1 or 2 are expected." << std::endl;
+        std::cerr << "Usage ( to determine the efficiencies for all years and cleaning options in one pass ): ./computeBTagEfficienciesMC sampleDirectory [numberOfThreads]" << std::endl;
         return 1;
-    } else if( argvStr.size() == 2 ){
-        std::string sampleDirectory = argvStr[1];
-
-		//submit job for each configuration
-       	for( const auto & year : { "2016", "2017", "2018" } ){
-            for( const auto& cleaning : { "looseLeptons", "FOLeptons", "uncleaned" } ){
-	
-                std::string command = ( "./computeBTagEfficienciesMC " + sampleDirectory + " " + year + " " + cleaning );
-                std::string scriptName = ( std::string( "bTagEff_" ) + year + "_" + cleaning + ".sh" );
-                systemTools::submitCommandAsJob( command, scriptName, "169:00:00" );
-            }
-        }
-    } else {
-        std::string sampleDirectory = argvStr[1];
-        std::string year = argvStr[2];
-        std::string cleaningOption = argvStr[3];
-        analysisTools::checkYearString( year );
-        if( ! ( cleaningOption == "looseLeptons" || cleaningOption == "FOLeptons" || cleaningOption == "uncleaned" ) ){
-            throw std::invalid_argument( "cleaningOption should be either 'looseLeptons', 'FOLeptons' or 'uncleaned'." );
-        }
-        bool cleanJetsFromLooseLeptons = ( cleaningOption == "looseLeptons" );
-        bool cleanJetsFromFOLeptons = ( cleaningOption == "FOLeptons" );
-        computeBTagEff( year, sampleDirectory, cleanJetsFromLooseLeptons, cleanJetsFromFOLeptons );
     }
-	return 0;
+    std::string sampleDirectory = argvStr[1];
+    unsigned numberOfThreads = ( argvStr.size() == 3 ? std::stoul( argvStr[2] ) : std::thread::hardware_concurrency() );
+
+    //make sure ROOT behaves itself when running multithreaded
+    ROOT::EnableThreadSafety();
+    computeBTagEff( sampleDirectory, numberOfThreads );
+    return 0;
 }
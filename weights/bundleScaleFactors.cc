@@ -0,0 +1,41 @@
+/*
+Compile all inputs of the reweighters of one year into a single preprocessed scale factor bundle.
+The reweighters are built once from the ROOT and csv files in the weight directory, and every input that is read is written to weightFiles/bundles/scaleFactors_<year>.bin.
+EwkinoReweighterFactory picks up this bundle automatically. Inputs whose weight file changed since the bundle was made are read from the file again with a warning, until the bundle is remade.
+The pileup weights are included for all samples in the given sample list.
+*/
+
+//include c++ library classes
+#include <iostream>
+#include <string>
+#include <vector>
+
+//include other parts of framework
+#include "interface/ConcreteReweighterFactory.h"
+#include "interface/ScaleFactorSource.h"
+#include "../Tools/interface/Sample.h"
+#include "../Tools/interface/analysisTools.h"
+
+
+int main( int argc, char* argv[] ){
+
+    std::vector< std::string > argvStr( &argv[0], &argv[0] + argc );
+    if( argvStr.size() != 5 ){
+        std::cerr << argc - 1 << " command line arguments given, while 4 are expected." << std::endl;
+        std::cerr << "Usage: ./bundleScaleFactors weightDirectory year sampleList sampleDirectory" << std::endl;
+        return 1;
+    }
+    const std::string& weightDirectory = argvStr[1];
+    const std::string& year = argvStr[2];
+    analysisTools::checkYearString( year );
+    std::vector< Sample > samples = readSampleList( argvStr[3], argvStr[4] );
+
+    //read everything from the files, recording all inputs
+    ScaleFactorSource source( weightDirectory );
+    EwkinoReweighterFactory().buildReweighter( source, year, samples );
+
+    std::string bundlePath = ScaleFactorSource::bundlePath( weightDirectory, year );
+    source.writeBundle( bundlePath );
+    std::cout << "Wrote scale factor bundle " << bundlePath << std::endl;
+    return 0;
+}
@@ -2,15 +2,53 @@
 #define CombinedReweighter_H
 
 //include c++ library classes
+#include <array>
 #include <map>
 #include <memory>
 #include <string>
+#include <vector>
 
 //include other parts of framework
 #include "Reweighter.h"
 
 
 
+//nominal total weight and the variations of every single Reweighter, produced by CombinedReweighter::weightVariations
+//when requested, the weights are also given for every variation of the jet momenta
+//the names are owned by the CombinedReweighter, which should outlive this object
+class CombinedWeightVariations{
+
+    public:
+        double nominal() const{ return _nominal[ nominalJets ]; }
+
+        //variations of the Reweighter with the given name
+        const WeightVariations& variations( const std::string& name ) const{ return _variations[ index( name ) ][ nominalJets ]; }
+
+        //ratio of the varied to the nominal weight of a single source, to be multiplied with the nominal total weight
+        double ratioDown( const std::string& name ) const{ return variations( name ).ratioDown(); }
+        double ratioUp( const std::string& name ) const{ return variations( name ).ratioUp(); }
+
+        //total weight and single source variations for varied jet momenta
+        bool hasJetVariations() const{ return _hasJetVariations; }
+        double nominal( const JetVariation ) const;
+        const WeightVariations& variations( const std::string&, const JetVariation ) const;
+
+        //ratio of the total weight for varied jet momenta to the nominal total weight
+        double jetVariationRatio( const JetVariation variation ) const{ return nominal( variation ) / nominal(); }
+
+    private:
+        friend class CombinedReweighter;
+
+        std::array< double, numberOfJetVariations > _nominal = {{ 1., 1., 1., 1., 1. }};
+        bool _hasJetVariations = false;
+        const std::vector< std::string >* _namesPtr = nullptr;
+        std::vector< JetVariationWeights > _variations;
+
+        std::vector< std::string >::size_type index( const std::string& ) const;
+        void checkJetVariations() const;
+};
+
+
 class CombinedReweighter{
 
     public:
@@ -22,9 +60,14 @@ class CombinedReweighter{
         const Reweighter* operator[]( const std::string& ) const;
         double totalWeight( const Event& ) const;
 
+        //nominal total weight and all single source variations in one pass over the Reweighters
+        //with jetVariations, the weights for all variations of the jet momenta are computed in the same pass
+        CombinedWeightVariations weightVariations( const Event&, const bool jetVariations = false ) const;
+
     private:
         std::map< std::string, std::shared_ptr< Reweighter > > reweighterMap;
         std::vector< std::shared_ptr< Reweighter > > reweighterVector;
+        std::vector< std::string > nameVector;
 };
 
 
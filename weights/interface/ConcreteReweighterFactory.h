@@ -6,11 +6,15 @@ New user specified ReweighterFactory derivates should be listed here
 #define ConcreteReweighterFactory_H
 
 #include "ReweighterFactory.h"
+#include "ScaleFactorSource.h"
 
 class EwkinoReweighterFactory : public ReweighterFactory {
 
     public:
+
+        //uses the preprocessed scale factor bundle of the year when it is present in the weight directory
         virtual CombinedReweighter buildReweighter( const std::string&, const std::string&, const std::vector< Sample >& ) const override;
+        CombinedReweighter buildReweighter( ScaleFactorSource&, const std::string&, const std::vector< Sample >& ) const;
 };
 
 #endif
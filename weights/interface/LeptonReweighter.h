@@ -9,37 +9,47 @@
 
 //include other parts of framework
 #include "LeptonSelectionHelper.h"
-#include "../../Tools/interface/histogramTools.h"
+#include "Reweighter.h"
+#include "../../Tools/interface/LookupTable2D.h"
 
 
 template < typename LeptonType > class LeptonReweighter{
 
     public:
         LeptonReweighter( const std::shared_ptr< TH2 >&, LeptonSelectionHelper* );
+        LeptonReweighter( const LookupTable2D&, LeptonSelectionHelper* );
 
         double weight( const LeptonType& ) const;
         double weightDown( const LeptonType& ) const;
         double weightUp( const LeptonType& ) const;
 
+        //nominal, down and up weights from a single selection and bin lookup
+        WeightVariations weightVariations( const LeptonType& ) const;
+
         virtual double ptVariable( const LeptonType& lepton ) const{ return lepton.uncorrectedPt(); }
         virtual double etaVariable( const LeptonType& lepton ) const{ return lepton.absEta(); }
 
     private:
-        std::shared_ptr< TH2 > weightMap;
+        LookupTable2D weightMap;
         std::shared_ptr< LeptonSelectionHelper > selector;
         bool ptOnXAxis;
 
-        double weight( const LeptonType& lepton, double (&retrieveValue)( TH2*, const double, const double ) ) const;
+        LookupTable2D::size_type findBin( const LeptonType& ) const;
 };
 
 
 template < typename LeptonType > LeptonReweighter< LeptonType >::LeptonReweighter( const std::shared_ptr< TH2 >& scaleFactorMap, LeptonSelectionHelper* selectionHelper ) :
+    LeptonReweighter( LookupTable2D( scaleFactorMap.get() ), selectionHelper )
+{}
+
+
+template < typename LeptonType > LeptonReweighter< LeptonType >::LeptonReweighter( const LookupTable2D& scaleFactorMap, LeptonSelectionHelper* selectionHelper ) :
     weightMap( scaleFactorMap ),
     selector( selectionHelper )
 {
 
     //use the range of the weight histogram to determine whether the X or Y axis represents the pT 
-    if( histogram::maxXValue( scaleFactorMap.get() ) > 3. ){
+    if( scaleFactorMap.maxXValue() > 3. ){
         ptOnXAxis = true;
     } else {
         ptOnXAxis = false;
@@ -47,30 +57,36 @@ template < typename LeptonType > LeptonReweighter< LeptonType >::LeptonReweighte
 }
 
 
-template < typename LeptonType > double LeptonReweighter< LeptonType >::weight( const LeptonType& lepton, double (&retrieveValue)( TH2*, const double, const double ) ) const{
-    if( selector->passSelection( lepton ) ){
-        if( ptOnXAxis ){
-            return retrieveValue( weightMap.get(), ptVariable( lepton ), etaVariable( lepton ) );
-        } else {
-            return retrieveValue( weightMap.get(), etaVariable( lepton ), ptVariable( lepton ) );
-        }
+template < typename LeptonType > LookupTable2D::size_type LeptonReweighter< LeptonType >::findBin( const LeptonType& lepton ) const{
+    if( ptOnXAxis ){
+        return weightMap.findBin( ptVariable( lepton ), etaVariable( lepton ) );
     } else {
-        return 1.;
+        return weightMap.findBin( etaVariable( lepton ), ptVariable( lepton ) );
     }
 }
 
 
 template < typename LeptonType > double LeptonReweighter< LeptonType >::weight( const LeptonType& lepton ) const{
-    return weight( lepton, histogram::contentAtValues );
+    if( !selector->passSelection( lepton ) ) return 1.;
+    return weightMap.content( findBin( lepton ) );
 }
 
 
 template < typename LeptonType > double LeptonReweighter< LeptonType >::weightDown( const LeptonType& lepton ) const{
-    return weight( lepton, histogram::contentDownAtValues );
+    if( !selector->passSelection( lepton ) ) return 1.;
+    return weightMap.contentDown( findBin( lepton ) );
 }
 
 
 template< typename LeptonType > double LeptonReweighter< LeptonType >::weightUp( const LeptonType& lepton ) const{
-    return weight( lepton, histogram::contentUpAtValues );
+    if( !selector->passSelection( lepton ) ) return 1.;
+    return weightMap.contentUp( findBin( lepton ) );
+}
+
+
+template< typename LeptonType > WeightVariations LeptonReweighter< LeptonType >::weightVariations( const LeptonType& lepton ) const{
+    if( !selector->passSelection( lepton ) ) return WeightVariations();
+    LookupTable2D::size_type bin = findBin( lepton );
+    return { weightMap.content( bin ), weightMap.contentDown( bin ), weightMap.contentUp( bin ) };
 }
 #endif 
@@ -5,10 +5,36 @@ Virtual class to compute the reweighting of an event. This should be overridden
 #ifndef Reweighter_H
 #define Reweighter_H
 
+//include c++ library classes
+#include <array>
+
 //include other parts of framework
 #include "../../Event/interface/Event.h"
 
 
+//nominal weight together with its down and up variations
+struct WeightVariations{
+    double nominal = 1.;
+    double down = 1.;
+    double up = 1.;
+
+    WeightVariations& operator*=( const WeightVariations& rhs ){
+        nominal *= rhs.nominal;
+        down *= rhs.down;
+        up *= rhs.up;
+        return *this;
+    }
+
+    double ratioDown() const{ return down / nominal; }
+    double ratioUp() const{ return up / nominal; }
+};
+
+
+//variations of the jet momenta, for which weights depending on the jets have to be recomputed
+enum JetVariation : unsigned { nominalJets = 0, JECDownJets, JECUpJets, JERDownJets, JERUpJets, numberOfJetVariations };
+using JetVariationWeights = std::array< WeightVariations, numberOfJetVariations >;
+
+
 class Reweighter{
 
     public:
@@ -16,5 +42,19 @@ class Reweighter{
         virtual double weightDown( const Event& ) const = 0;
         virtual double weightUp( const Event& ) const = 0;
 
+        //nominal, down and up weights in a single traversal of the event
+        //the default falls back to three separate evaluations, derived classes should override this when the traversal can be shared
+        virtual WeightVariations weightVariations( const Event& event ) const{
+            return { weight( event ), weightDown( event ), weightUp( event ) };
+        }
+
+        //weight variations for the nominal jets and for each variation of the jet momenta
+        //weights that do not depend on the jets are the same for all of them
+        virtual JetVariationWeights jetVariationWeights( const Event& event ) const{
+            JetVariationWeights ret;
+            ret.fill( weightVariations( event ) );
+            return ret;
+        }
+
 };
 #endif
@@ -15,13 +15,19 @@ class ReweighterBTag : public Reweighter {
     public:
         ReweighterBTag( const std::string& weightDirectory, const std::string& sfFilePath, const std::string& workingPoint, const bool heavyFlavor );
 
+        //use an already parsed calibration, which can be shared between the heavy and light flavor reweighters
+        ReweighterBTag( const std::shared_ptr< BTagCalibration >& calibration, const std::string& workingPoint, const bool heavyFlavor );
+
         virtual double weight( const Event& ) const override;
         virtual double weightDown( const Event& ) const override;
         virtual double weightUp( const Event& ) const override;
+        virtual WeightVariations weightVariations( const Event& ) const override;
+        virtual JetVariationWeights jetVariationWeights( const Event& ) const override;
 
         double weight( const Jet& ) const;
         double weightDown( const Jet& ) const;
         double weightUp( const Jet& ) const;
+        WeightVariations weightVariations( const Jet& ) const;
     private:
         std::shared_ptr< BTagCalibration > bTagSFCalibration;
         std::shared_ptr< BTagCalibrationReader > bTagSFReader;
@@ -32,6 +38,8 @@ class ReweighterBTag : public Reweighter {
         virtual double CSVValue( const Jet& ) const = 0;
         virtual double efficiencyMC( const Jet& ) const = 0;
         double weight( const Jet&, const std::string& ) const; 
+        bool hasReweightedFlavor( const Jet& ) const;
+        bool isReweighted( const Jet& ) const;
         double weight( const Event&, double (ReweighterBTag::*jetWeight)( const Jet& ) const ) const;
     
 
@@ -3,6 +3,9 @@
 
 #include "ReweighterBTag.h"
 
+//include other parts of framework
+#include "../../Tools/interface/LookupTable2D.h"
+
 //include ROOT classes
 #include "TH2.h"
 
@@ -11,10 +14,11 @@ class ReweighterBTagHeavyFlavor : public ReweighterBTag {
 
     public:
         ReweighterBTagHeavyFlavor(const std::string& weightDirectory, const std::string& sfFilePath, const std::string& workingPoint, const std::shared_ptr< TH2 >& efficiencyC, const std::shared_ptr< TH2 >& efficiencyB );
+        ReweighterBTagHeavyFlavor( const std::shared_ptr< BTagCalibration >& calibration, const std::string& workingPoint, const LookupTable2D& efficiencyC, const LookupTable2D& efficiencyB );
 
     private:
-        std::shared_ptr< TH2 > bTagEfficiencyC;
-        std::shared_ptr< TH2 > bTagEfficiencyB; 
+        LookupTable2D bTagEfficiencyC;
+        LookupTable2D bTagEfficiencyB;
         virtual double efficiencyMC( const Jet& ) const override;
 };
 
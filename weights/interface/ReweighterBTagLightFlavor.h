@@ -1,15 +1,24 @@
 #ifndef ReweighterBTagLightFlavor_H
 #define ReweighterBTagLightFlavor_H
 
+#include "ReweighterBTag.h"
+
+//include other parts of framework
+#include "../../Tools/interface/LookupTable2D.h"
+
+//include ROOT classes
+#include "TH2.h"
+
 
 class ReweighterBTagLightFlavor : public ReweighterBTag {
 
     public:
         ReweighterBTagLightFlavor(const std::string& weightDirectory, const std::string& sfFilePath, const std::string& workingPoint, const std::shared_ptr< TH2 >& efficiencyUDSG );
+        ReweighterBTagLightFlavor( const std::shared_ptr< BTagCalibration >& calibration, const std::string& workingPoint, const LookupTable2D& efficiencyUDSG );
 
 
     private:
-        std::shared_ptr< TH2 > bTagEfficiencyUDSG;
+        LookupTable2D bTagEfficiencyUDSG;
         virtual double efficiencyMC( const Jet& ) const override;
 };
 
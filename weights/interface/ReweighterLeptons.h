@@ -19,6 +19,7 @@ template < typename LeptonType, typename CollectionType, typename ReweighterType
         virtual double weight( const Event& event ) const override;
         virtual double weightDown( const Event& event ) const override;
         virtual double weightUp( const Event& event ) const override;
+        virtual WeightVariations weightVariations( const Event& event ) const override;
 
     private:
         double weight( const Event& event, double (ReweighterType::*weightFunction)( const LeptonType& ) const ) const;
@@ -59,4 +60,16 @@ template< typename LeptonType, typename CollectionType, typename ReweighterType
     return weight( event, &ReweighterType::weightUp );
 }
 
+
+
+template< typename LeptonType, typename CollectionType, typename ReweighterType >
+    WeightVariations ReweighterLeptons< LeptonType, CollectionType, ReweighterType >::weightVariations( const Event& event ) const
+{
+    WeightVariations ret;
+    for( const auto& leptonPtr : leptonCollection( event ) ){
+        ret *= leptonReweighter->weightVariations( *leptonPtr );
+    }
+    return ret;
+}
+
 #endif
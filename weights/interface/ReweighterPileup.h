@@ -4,26 +4,58 @@
 #include "Reweighter.h"
 
 //include c++ library classes
+#include <cstdint>
 #include <map>
 #include <memory>
+#include <string>
+#include <vector>
 
 //include ROOT classes
 #include "TH1.h"
 
+class ScaleFactorSource;
+class SampleMetadataIndex;
+
 class ReweighterPileup : public Reweighter {
 
     public:
-        ReweighterPileup( const std::vector< Sample >& sampleList, const std::string& weightDirectory );
+        ReweighterPileup( const std::vector< Sample >& sampleList, const std::string& weightDirectory, const SampleMetadataIndex* metadataIndexPtr = nullptr );
+        ReweighterPileup( const std::vector< Sample >& sampleList, ScaleFactorSource& );
+
+        //the cached table of each thread refers to the tables of one reweighter, so it can not be copied
+        ReweighterPileup( const ReweighterPileup& ) = delete;
+        ReweighterPileup& operator=( const ReweighterPileup& ) = delete;
 
         virtual double weight( const Event& ) const override;
         virtual double weightDown( const Event& ) const override;
         virtual double weightUp( const Event& ) const override;
+        virtual WeightVariations weightVariations( const Event& ) const override;
+
+        //central, down and up weights for every integer number of true interactions, interleaved in a single array
+        //the array is owned by the table or, when it comes from a ScaleFactorBundle, by the memory-mapped bundle
+        struct WeightTable{
+            int minimumNumberOfTrueInteractions = 0;
+            std::size_t numberOfEntries = 0;
+            const double* weights = nullptr;
+            std::shared_ptr< const void > owner;
+        };
+
+        //weight table of a sample from the per-sample weight file in the weight directory, which is produced if it is not present yet
+        //the pileup distribution needed to produce it is taken from the metadata index if one is given, and otherwise read from the sample file
+        static WeightTable readWeightTable( const Sample&, const std::string& weightDirectory, const SampleMetadataIndex* metadataIndexPtr = nullptr );
+
+        //name of the weight file and histogram of a sample, relative to the weight directory
+        static std::string weightFilePath( const Sample& );
+        static std::string weightHistogramName( const Sample& );
 
     private: 
-        std::map< std::string, std::shared_ptr< TH1 > > puWeightsCentral;
-        std::map< std::string, std::shared_ptr< TH1 > > puWeightsDown;
-        std::map< std::string, std::shared_ptr< TH1 > > puWeightsUp;
-        double weight( const Event&, const std::map< std::string, std::shared_ptr< TH1 > >& ) const;
+        std::map< std::string, WeightTable > puWeightTables;
+
+        //identifies the reweighter in the per-thread cache of the table of the sample that was last reweighted
+        //the cache is per thread, so one reweighter can be shared by all threads of an event loop
+        std::uint64_t _reweighterId;
+
+        const double* weightsAtNumberOfTrueInteractions( const Event& ) const;
 };
 
 
@@ -9,6 +9,7 @@ class ReweighterPrefire : public Reweighter {
         virtual double weight( const Event& ) const override;
         virtual double weightDown( const Event& ) const override;
         virtual double weightUp( const Event& ) const override;
+        virtual WeightVariations weightVariations( const Event& ) const override;
 };
 
 #endif 
@@ -0,0 +1,107 @@
+/*
+Preprocessed binary bundle with all inputs needed to build the reweighters of one year.
+The bundle holds named entries of three kinds: flat lookup tables of two-dimensional scale factor or efficiency maps, 
+dense pileup weight tables of each sample, and text such as the b-tag calibration csv files.
+The file is memory-mapped read-only, so the tables are used in place and the pages are shared between all processes reading the same bundle.
+The bundle is written by ScaleFactorBundleWriter, and is produced with weights/bundleScaleFactors.cc.
+Every entry stores the size and modification time of the file it was read from, so entries of files that changed since the bundle was made can be recognized.
+*/
+
+#ifndef ScaleFactorBundle_H
+#define ScaleFactorBundle_H
+
+//include c++ library classes
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+//include other parts of framework
+#include "../../Tools/interface/LookupTable2D.h"
+
+
+namespace scaleFactorBundle{
+    enum EntryType : std::uint64_t { lookupTable = 1, pileupTable = 2, text = 3 };
+
+    //size and modification time of the file an entry was read from
+    struct SourceStamp{
+        long long fileSize = 0;
+        long long modificationTime = 0;
+    };
+
+    //stamp of an existing file
+    SourceStamp sourceStamp( const std::string& filePath );
+}
+
+
+class ScaleFactorBundle : public std::enable_shared_from_this< ScaleFactorBundle > {
+
+    public:
+        using size_type = std::size_t;
+
+        //the bundle has to be owned by a shared_ptr, since the tables it hands out keep the mapping alive
+        static std::shared_ptr< const ScaleFactorBundle > open( const std::string& path );
+
+        ~ScaleFactorBundle();
+        ScaleFactorBundle( const ScaleFactorBundle& ) = delete;
+        ScaleFactorBundle& operator=( const ScaleFactorBundle& ) = delete;
+
+        bool contains( const std::string& name ) const{ return _entries.find( name ) != _entries.cend(); }
+
+        LookupTable2D lookupTable( const std::string& name ) const;
+
+        //pileup weights for every integer number of true interactions starting at the given minimum, with central, down and up weights interleaved
+        const double* pileupTable( const std::string& name, int& minimumNumberOfTrueInteractions, size_type& numberOfEntries ) const;
+
+        std::string text( const std::string& name ) const;
+
+        //check whether the file an entry was read from still has the same size and modification time
+        bool isUpToDate( const std::string& name, const std::string& sourcePath ) const;
+
+        const std::string& path() const{ return _path; }
+
+    private:
+        ScaleFactorBundle( const std::string& path );
+
+        struct Entry{
+            std::uint64_t type;
+            const char* data;
+            size_type size;
+            scaleFactorBundle::SourceStamp source;
+        };
+
+        std::string _path;
+        void* _mapping = nullptr;
+        size_type _mappingSize = 0;
+        std::map< std::string, Entry > _entries;
+
+        const Entry& entry( const std::string& name, const scaleFactorBundle::EntryType ) const;
+};
+
+
+class ScaleFactorBundleWriter{
+
+    public:
+        void addLookupTable( const std::string& name, const LookupTable2D&, const scaleFactorBundle::SourceStamp& );
+        void addPileupTable( const std::string& name, const int minimumNumberOfTrueInteractions, const std::vector< double >& weights, const scaleFactorBundle::SourceStamp& );
+        void addText( const std::string& name, const std::string&, const scaleFactorBundle::SourceStamp& );
+
+        bool contains( const std::string& name ) const{ return _entries.find( name ) != _entries.cend(); }
+
+        void write( const std::string& path ) const;
+
+    private:
+
+        struct Entry{
+            scaleFactorBundle::EntryType type;
+            std::string payload;
+            scaleFactorBundle::SourceStamp source;
+        };
+        std::map< std::string, Entry > _entries;
+
+        void addEntry( const std::string& name, const scaleFactorBundle::EntryType, const std::string& payload, const scaleFactorBundle::SourceStamp& );
+};
+
+#endif
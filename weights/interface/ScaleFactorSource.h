@@ -0,0 +1,62 @@
+/*
+Source of the inputs from which the reweighters are built: scale factor and efficiency maps, pileup weights and b-tag calibrations.
+Inputs are taken from a preprocessed ScaleFactorBundle when one is given, and are otherwise read from the ROOT and csv files in the weight directory.
+Bundle entries whose file changed size or modification time since the bundle was made are out of date, and are read from the file instead with a warning.
+Every input read from the files is recorded, so that a new bundle can be written once all reweighters are built.
+*/
+
+#ifndef ScaleFactorSource_H
+#define ScaleFactorSource_H
+
+//include c++ library classes
+#include <memory>
+#include <string>
+
+//include other parts of framework
+#include "ScaleFactorBundle.h"
+#include "ReweighterPileup.h"
+#include "../../Tools/interface/LookupTable2D.h"
+#include "../../Tools/interface/Sample.h"
+#include "../bTagSFCode/BTagCalibrationStandalone.h"
+
+class SampleMetadataIndex;
+
+
+class ScaleFactorSource{
+
+    public:
+
+        //read all inputs from the files in the weight directory
+        ScaleFactorSource( const std::string& weightDirectory );
+
+        //read the inputs from the bundle, inputs it does not contain or that are out of date are read from the weight directory
+        ScaleFactorSource( const std::string& weightDirectory, const std::shared_ptr< const ScaleFactorBundle >& );
+
+        //use the bundle of the given year in the weight directory if it exists, and the files otherwise
+        static ScaleFactorSource forYear( const std::string& weightDirectory, const std::string& year );
+        static std::string bundlePath( const std::string& weightDirectory, const std::string& year );
+
+        const std::string& weightDirectory() const{ return _weightDirectory; }
+        bool usesBundle() const{ return _bundle != nullptr; }
+
+        //file paths are relative to the weight directory
+        LookupTable2D lookupTable( const std::string& filePath, const std::string& histogramName );
+        std::shared_ptr< BTagCalibration > bTagCalibration( const std::string& filePath );
+        ReweighterPileup::WeightTable pileupWeightTable( const Sample& );
+
+        //pileup distributions needed to produce missing pileup weight files are taken from the index instead of the sample files
+        void setSampleMetadataIndex( const std::shared_ptr< const SampleMetadataIndex >& metadataIndexPtr ){ _metadataIndexPtr = metadataIndexPtr; }
+
+        //write all inputs that were read from files to a bundle
+        void writeBundle( const std::string& path ) const;
+
+    private:
+        std::string _weightDirectory;
+        std::shared_ptr< const ScaleFactorBundle > _bundle;
+        std::shared_ptr< const SampleMetadataIndex > _metadataIndexPtr;
+        ScaleFactorBundleWriter _recordedInputs;
+
+        bool useBundleEntry( const std::string& entryName, const std::string& filePath ) const;
+};
+
+#endif
@@ -0,0 +1,32 @@
+/*
+Fake-rate and charge-flip weights of an event, computed from the lookup tables of the fake-rate and charge-flip maps.
+A lepton's bin is found once, after which the nominal and all varied weights of an event are computed in a single pass.
+*/
+
+#ifndef transferFactors_H
+#define transferFactors_H
+
+//include c++ library classes
+#include <vector>
+#include <limits>
+
+//include other parts of framework
+#include "../../Event/interface/Event.h"
+#include "../../Tools/interface/LookupTable2D.h"
+
+
+namespace transferFactors{
+
+    //fake-rate weights of the FO leptons failing the tight selection, as a function of pt and |eta|, with pt clamped to maxPt
+    //the weights are ordered as the nominal weight, the muon map variations and then the electron map variations
+    void fakeRateWeights( const Event&, const LookupTable2D& muonMap, const LookupTable2D& electronMap, std::vector< double >& weights,
+        const double maxPt = std::numeric_limits< double >::max() );
+    double fakeRateWeight( const Event&, const LookupTable2D& muonMap, const LookupTable2D& electronMap,
+        const double maxPt = std::numeric_limits< double >::max() );
+
+    //charge-flip weights of the electrons as a function of pt and |eta|, ordered as the nominal weight followed by the map variations
+    void chargeFlipWeights( const Event&, const LookupTable2D& chargeFlipMap, std::vector< double >& weights );
+    double chargeFlipWeight( const Event&, const LookupTable2D& chargeFlipMap );
+}
+
+#endif
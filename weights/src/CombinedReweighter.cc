@@ -7,6 +7,7 @@
 void CombinedReweighter::addReweighter( const std::string& name, const std::shared_ptr< Reweighter >& reweighter ){
     reweighterMap[ name ] = reweighter;
     reweighterVector.push_back( reweighter );
+    nameVector.push_back( name );
 }
 
 
@@ -31,6 +32,7 @@ void CombinedReweighter::eraseReweighter( const std::string& name ){
     //remove from vector
     for( auto vecIt = reweighterVector.begin(); vecIt != reweighterVector.end(); ++vecIt ){
         if( vecIt->get() == address ){
+            nameVector.erase( nameVector.begin() + ( vecIt - reweighterVector.begin() ) );
             reweighterVector.erase( vecIt );
 
             //break is needed to avoid problems with invalid iterators after calling erase
@@ -53,3 +55,56 @@ double CombinedReweighter::totalWeight( const Event& event ) const{
     }
     return weight;
 }
+
+
+CombinedWeightVariations CombinedReweighter::weightVariations( const Event& event, const bool jetVariations ) const{
+    CombinedWeightVariations ret;
+    ret._namesPtr = &nameVector;
+    ret._hasJetVariations = jetVariations;
+    ret._variations.resize( reweighterVector.size() );
+    for( std::vector< std::shared_ptr< Reweighter > >::size_type r = 0; r < reweighterVector.size(); ++r ){
+        if( jetVariations ){
+            ret._variations[ r ] = reweighterVector[ r ]->jetVariationWeights( event );
+            for( unsigned v = 0; v < numberOfJetVariations; ++v ){
+                ret._nominal[ v ] *= ret._variations[ r ][ v ].nominal;
+            }
+        } else {
+            ret._variations[ r ][ nominalJets ] = reweighterVector[ r ]->weightVariations( event );
+            ret._nominal[ nominalJets ] *= ret._variations[ r ][ nominalJets ].nominal;
+        }
+    }
+    return ret;
+}
+
+
+std::vector< std::string >::size_type CombinedWeightVariations::index( const std::string& name ) const{
+    if( _namesPtr != nullptr ){
+
+        //search from the back so a Reweighter added later under the same name takes precedence, like in the map
+        for( auto i = _namesPtr->size(); i > 0; --i ){
+            if( ( *_namesPtr )[ i - 1 ] == name ){
+                return i - 1;
+            }
+        }
+    }
+    throw std::invalid_argument( "Requested variations of Reweighter '" + name + "', but no Reweighter of that name is present." );
+}
+
+
+void CombinedWeightVariations::checkJetVariations() const{
+    if( !_hasJetVariations ){
+        throw std::domain_error( "Weights for varied jet momenta are requested, but they were not computed by CombinedReweighter::weightVariations." );
+    }
+}
+
+
+double CombinedWeightVariations::nominal( const JetVariation variation ) const{
+    if( variation != nominalJets ) checkJetVariations();
+    return _nominal[ variation ];
+}
+
+
+const WeightVariations& CombinedWeightVariations::variations( const std::string& name, const JetVariation variation ) const{
+    if( variation != nominalJets ) checkJetVariations();
+    return _variations[ index( name ) ][ variation ];
+}
@@ -1,9 +1,5 @@
 #include "../interface/ConcreteReweighterFactory.h"
 
-//include ROOT classes
-#include "TFile.h"
-#include "TH2.h"
-
 //include other parts of framework
 #include "../../Tools/interface/analysisTools.h"
 #include "../../Tools/interface/stringTools.h"
@@ -17,6 +13,12 @@
 
 
 CombinedReweighter EwkinoReweighterFactory::buildReweighter( const std::string& weightDirectory, const std::string& year, const std::vector< Sample >& samples ) const{
+    ScaleFactorSource source = ScaleFactorSource::forYear( weightDirectory, year );
+    return buildReweighter( source, year, samples );
+}
+
+
+CombinedReweighter EwkinoReweighterFactory::buildReweighter( ScaleFactorSource& source, const std::string& year, const std::vector< Sample >& samples ) const{
 
     analysisTools::checkYearString( year );
 
@@ -24,73 +26,44 @@ CombinedReweighter EwkinoReweighterFactory::buildReweighter( const std::string&
     CombinedReweighter combinedReweighter;
 
     //make muon ID Reweighter
-    TFile* muonSFFile = TFile::Open( ( stringTools::formatDirectoryName( weightDirectory ) + "weightFiles/leptonSF/leptonSF_m_" + year + "_3lTight.root" ).c_str() );
-    std::shared_ptr< TH2 > muonSFHist( dynamic_cast< TH2* >( muonSFFile->Get( "SFglobal" ) ) );
-    muonSFHist->SetDirectory( gROOT );
-    muonSFFile->Close();
-
-    MuonReweighter muonReweighter( muonSFHist, new TightSelector );
+    MuonReweighter muonReweighter( source.lookupTable( "weightFiles/leptonSF/leptonSF_m_" + year + "_3lTight.root", "SFglobal" ), new TightSelector );
     combinedReweighter.addReweighter( "muonID", std::make_shared< ReweighterMuons >( muonReweighter ) );
 
     //make electron ID Reweighter
-    TFile* eleSFFile = TFile::Open( ( stringTools::formatDirectoryName( weightDirectory ) + "weightFiles/leptonSF/leptonSF_e_" + year + "_3lTight.root" ).c_str() );
-    std::shared_ptr< TH2 > electronSFHist( dynamic_cast< TH2* >( eleSFFile->Get( "SFglobal" ) ) );
-    electronSFHist->SetDirectory( gROOT );
-    eleSFFile->Close();
-
-    ElectronIDReweighter electronIDReweighter( electronSFHist, new TightSelector );
+    ElectronIDReweighter electronIDReweighter( source.lookupTable( "weightFiles/leptonSF/leptonSF_e_" + year + "_3lTight.root", "SFglobal" ), new TightSelector );
     combinedReweighter.addReweighter( "electronID", std::make_shared< ReweighterElectronsID >( electronIDReweighter ) );
 
     //make electron Reconstruction Reweighter
     if( year == "2016" || year == "2017" ){
 
         //pT below 20 GeV
-        TFile* eleRecoSFFile_pTBelow20 = TFile::Open( ( stringTools::formatDirectoryName( weightDirectory ) + "weightFiles/leptonSF/egamma_recoEff_" + year + "_pTBelow20.root" ).c_str() );
-        std::shared_ptr< TH2 > electronRecoSFHist_pTBelow20( dynamic_cast< TH2* >( eleRecoSFFile_pTBelow20->Get( "EGamma_SF2D" ) ) );
-        electronRecoSFHist_pTBelow20->SetDirectory( gROOT );
-        eleRecoSFFile_pTBelow20->Close();
-
-        ElectronIDReweighter electronRecoReweighter_pTBelow20( electronRecoSFHist_pTBelow20, new LooseMaxPtSelector< 20 > );
+        ElectronIDReweighter electronRecoReweighter_pTBelow20( source.lookupTable( "weightFiles/leptonSF/egamma_recoEff_" + year + "_pTBelow20.root", "EGamma_SF2D" ), new LooseMaxPtSelector< 20 > );
         combinedReweighter.addReweighter( "electronReco_pTBelow20", std::make_shared< ReweighterElectronsID >( electronRecoReweighter_pTBelow20 ) );
 
         //pT above 20 GeV
-        TFile* eleRecoSFFile_pTAbove20 = TFile::Open( ( stringTools::formatDirectoryName( weightDirectory ) + "weightFiles/leptonSF/egamma_recoEff_" + year + "_pTAbove20.root" ).c_str() );
-        std::shared_ptr< TH2 > electronRecoSFHist_pTAbove20( dynamic_cast< TH2* >( eleRecoSFFile_pTAbove20->Get( "EGamma_SF2D" ) ) );
-        electronRecoSFHist_pTAbove20->SetDirectory( gROOT );
-        eleRecoSFFile_pTAbove20->Close();
-
-        ElectronIDReweighter electronRecoReweighter_pTAbove20( electronRecoSFHist_pTAbove20, new LooseMinPtSelector< 20 > );
+        ElectronIDReweighter electronRecoReweighter_pTAbove20( source.lookupTable( "weightFiles/leptonSF/egamma_recoEff_" + year + "_pTAbove20.root", "EGamma_SF2D" ), new LooseMinPtSelector< 20 > );
         combinedReweighter.addReweighter( "electronReco_pTAbove20", std::make_shared< ReweighterElectronsID >( electronRecoReweighter_pTAbove20 ) );
 
     } else if( year == "2018" ){
 
         //inclusive pT 
-        TFile* eleRecoSFFile = TFile::Open( ( stringTools::formatDirectoryName( weightDirectory ) + "weightFiles/leptonSF/egamma_recoEff_" + year + ".root" ).c_str() );
-        std::shared_ptr< TH2 > electronRecoSFHist ( dynamic_cast< TH2* >( eleRecoSFFile->Get( "EGamma_SF2D" ) ) );
-        electronRecoSFHist->SetDirectory( gROOT );
-        eleRecoSFFile->Close();
-
-        ElectronIDReweighter electronRecoReweighter( electronRecoSFHist, new LooseSelector );
+        ElectronIDReweighter electronRecoReweighter( source.lookupTable( "weightFiles/leptonSF/egamma_recoEff_" + year + ".root", "EGamma_SF2D" ), new LooseSelector );
         combinedReweighter.addReweighter( "electronReco", std::make_shared< ReweighterElectronsID >( electronRecoReweighter ) );
 
     }
     
     //make pileup Reweighter
-    combinedReweighter.addReweighter( "pileup", std::make_shared< ReweighterPileup >( samples, weightDirectory ) );
+    combinedReweighter.addReweighter( "pileup", std::make_shared< ReweighterPileup >( samples, source ) );
     
     //make b-tagging Reweighter 
     const std::string& bTagWP = "tight";
 
     //read MC b-tagging efficiency histograms
     const std::string& leptonCleaning = "looseLeptonCleaned";
-    TFile* bTagEffMCFile = TFile::Open( ( stringTools::formatDirectoryName( weightDirectory ) + "weightFiles/bTagEff/bTagEff_" + leptonCleaning + "_" + year + ".root" ).c_str() );
-    std::shared_ptr< TH2 > bTagEffMCHist_udsg( dynamic_cast< TH2* >( bTagEffMCFile->Get( ( "bTagEff_" + bTagWP + "_udsg" ).c_str() ) ) );
-    bTagEffMCHist_udsg->SetDirectory( gROOT );
-    std::shared_ptr< TH2 > bTagEffMCHist_c( dynamic_cast< TH2* >( bTagEffMCFile->Get( ( "bTagEff_" + bTagWP + "_charm" ).c_str() ) ) );
-    bTagEffMCHist_c->SetDirectory( gROOT );
-    std::shared_ptr< TH2 > bTagEffMCHist_b( dynamic_cast< TH2* >( bTagEffMCFile->Get( ( "bTagEff_" + bTagWP + "_beauty" ).c_str() ) ) );
-    bTagEffMCHist_b->SetDirectory( gROOT );
-    bTagEffMCFile->Close();
+    const std::string bTagEffMCPath = "weightFiles/bTagEff/bTagEff_" + leptonCleaning + "_" + year + ".root";
+    LookupTable2D bTagEffMC_udsg = source.lookupTable( bTagEffMCPath, "bTagEff_" + bTagWP + "_udsg" );
+    LookupTable2D bTagEffMC_c = source.lookupTable( bTagEffMCPath, "bTagEff_" + bTagWP + "_charm" );
+    LookupTable2D bTagEffMC_b = source.lookupTable( bTagEffMCPath, "bTagEff_" + bTagWP + "_beauty" );
 
     //path of b-tagging SF 
     std::string bTagSFFileName;
@@ -103,8 +76,10 @@ CombinedReweighter EwkinoReweighterFactory::buildReweighter( const std::string&
     }
     std::string bTagSFPath = "weightFiles/bTagSF/" + bTagSFFileName;
 
-    combinedReweighter.addReweighter( "bTag_heavy", std::make_shared< ReweighterBTagHeavyFlavorDeepCSV >( weightDirectory, bTagSFPath, bTagWP, bTagEffMCHist_c, bTagEffMCHist_b ) );
-    combinedReweighter.addReweighter( "bTag_light", std::make_shared< ReweighterBTagLightFlavorDeepCSV >( weightDirectory, bTagSFPath, bTagWP, bTagEffMCHist_udsg ) );
+    //the calibration is parsed once and shared by the heavy and light flavor Reweighters
+    std::shared_ptr< BTagCalibration > bTagCalibration = source.bTagCalibration( bTagSFPath );
+    combinedReweighter.addReweighter( "bTag_heavy", std::make_shared< ReweighterBTagHeavyFlavorDeepCSV >( bTagCalibration, bTagWP, bTagEffMC_c, bTagEffMC_b ) );
+    combinedReweighter.addReweighter( "bTag_light", std::make_shared< ReweighterBTagLightFlavorDeepCSV >( bTagCalibration, bTagWP, bTagEffMC_udsg ) );
 
     //make prefire Reweighter
     combinedReweighter.addReweighter( "prefire", std::make_shared< ReweighterPrefire >() );
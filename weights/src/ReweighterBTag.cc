@@ -1,6 +1,7 @@
 #include "../interface/ReweighterBTag.h"
 
 //include c++ library classes
+#include <array>
 #include <stdexcept>
 
 //include other parts of framework
@@ -9,6 +10,12 @@
 
 
 ReweighterBTag::ReweighterBTag( const std::string& weightDirectory, const std::string& sfFilePath, const std::string& workingPoint, const bool heavyFlavor ):
+    ReweighterBTag( std::make_shared< BTagCalibration >( "", stringTools::formatDirectoryName( weightDirectory ) + sfFilePath ), workingPoint, heavyFlavor )
+{}
+
+
+ReweighterBTag::ReweighterBTag( const std::shared_ptr< BTagCalibration >& calibration, const std::string& workingPoint, const bool heavyFlavor ):
+    bTagSFCalibration( calibration ),
     _heavyFlavor( heavyFlavor )
 {
 
@@ -44,7 +51,6 @@ ReweighterBTag::ReweighterBTag( const std::string& weightDirectory, const std::s
     }
 
     //calibrate the reader
-    bTagSFCalibration = std::shared_ptr< BTagCalibration >( new BTagCalibration( "", stringTools::formatDirectoryName( weightDirectory ) + sfFilePath ) );
     if( heavyFlavor ){
         bTagSFReader->load( *bTagSFCalibration, BTagEntry::FLAV_B, fitMethod );
         bTagSFReader->load( *bTagSFCalibration, BTagEntry::FLAV_C, fitMethod );
@@ -67,18 +73,35 @@ BTagEntry::JetFlavor jetFlavorEntry( const Jet& jet ){
 }
 
 
-double ReweighterBTag::weight( const Jet& jet, const std::string& uncertainty ) const{
-
+bool ReweighterBTag::hasReweightedFlavor( const Jet& jet ) const{
     if( _heavyFlavor ){
-        if( !( jet.hadronFlavor() == 4 || jet.hadronFlavor() == 5 ) ) return 1.;
+        return ( jet.hadronFlavor() == 4 || jet.hadronFlavor() == 5 );
     } else {
-        if( !( jet.hadronFlavor() == 0 ) ) return 1.;
+        return ( jet.hadronFlavor() == 0 );
     }
+}
+
+
+bool ReweighterBTag::isReweighted( const Jet& jet ) const{
+    if( !hasReweightedFlavor( jet ) ) return false;
 
     //make sure jet passes b-tag selection
-    if( ! jet.inBTagAcceptance() ){
-        return 1.;
+    return jet.inBTagAcceptance();
+}
+
+
+//weight of a jet given its scale factor, for failing jets the MC efficiency enters
+double jetWeightFromScaleFactor( const bool passWorkingPoint, const double efficiency, const double scaleFactor ){
+    if( passWorkingPoint ){
+        return scaleFactor;
+    } else {
+        return ( 1. - efficiency * scaleFactor ) / ( 1. - efficiency );
     }
+}
+
+
+double ReweighterBTag::weight( const Jet& jet, const std::string& uncertainty ) const{
+    if( !isReweighted( jet ) ) return 1.;
 
     double scaleFactor = bTagSFReader->eval_auto_bounds( uncertainty, jetFlavorEntry( jet ), jet.eta(), jet.pt(), CSVValue( jet ) );
     
@@ -87,8 +110,7 @@ double ReweighterBTag::weight( const Jet& jet, const std::string& uncertainty )
     if( ( passBTag == nullptr ) || ( jet.* passBTag )() ){
         return scaleFactor;
     } else {
-        double efficiency = efficiencyMC( jet );
-        return ( 1. - efficiency * scaleFactor ) / ( 1. - efficiency );
+        return jetWeightFromScaleFactor( false, efficiencyMC( jet ), scaleFactor );
     }
 }
 
@@ -108,6 +130,25 @@ double ReweighterBTag::weightUp( const Jet& jet ) const{
 }
 
 
+WeightVariations ReweighterBTag::weightVariations( const Jet& jet ) const{
+    if( !isReweighted( jet ) ) return WeightVariations();
+
+    //the flavor, discriminator value, working point decision and efficiency are shared by the three scale factors
+    BTagEntry::JetFlavor flavor = jetFlavorEntry( jet );
+    double discriminator = CSVValue( jet );
+    double scaleFactor = bTagSFReader->eval_auto_bounds( "central", flavor, jet.eta(), jet.pt(), discriminator );
+    double scaleFactorDown = bTagSFReader->eval_auto_bounds( "down", flavor, jet.eta(), jet.pt(), discriminator );
+    double scaleFactorUp = bTagSFReader->eval_auto_bounds( "up", flavor, jet.eta(), jet.pt(), discriminator );
+
+    //in case of reweighting of the full shape, no selection is required
+    bool passWorkingPoint = ( ( passBTag == nullptr ) || ( jet.* passBTag )() );
+    double efficiency = ( passWorkingPoint ? 1. : efficiencyMC( jet ) );
+    return { jetWeightFromScaleFactor( passWorkingPoint, efficiency, scaleFactor ),
+        jetWeightFromScaleFactor( passWorkingPoint, efficiency, scaleFactorDown ),
+        jetWeightFromScaleFactor( passWorkingPoint, efficiency, scaleFactorUp ) };
+}
+
+
 double ReweighterBTag::weight( const Event& event, double ( ReweighterBTag::*jetWeight )( const Jet& ) const ) const{
     double weight = 1.;
     for( const auto& jetPtr : event.jetCollection() ){
@@ -130,3 +171,40 @@ double ReweighterBTag::weightDown( const Event& event ) const{
 double ReweighterBTag::weightUp( const Event& event ) const{
     return weight( event, &ReweighterBTag::weightUp );
 }
+
+
+WeightVariations ReweighterBTag::weightVariations( const Event& event ) const{
+    WeightVariations ret;
+    for( const auto& jetPtr : event.jetCollection() ){
+        ret *= weightVariations( *jetPtr );
+    }
+    return ret;
+}
+
+
+JetVariationWeights ReweighterBTag::jetVariationWeights( const Event& event ) const{
+    static const std::array< Jet (Jet::*)() const, numberOfJetVariations > variedJet = { nullptr, &Jet::JetJECDown, &Jet::JetJECUp, &Jet::JetJERDown, &Jet::JetJERUp };
+
+    JetVariationWeights ret;
+    for( const auto& jetPtr : event.jetCollection() ){
+        const Jet& jet = *jetPtr;
+        if( !hasReweightedFlavor( jet ) ) continue;
+
+        //only the momentum differs between the jet variations, so variations with the same momentum share their weights
+        const std::array< double, numberOfJetVariations > pt = { jet.pt(), jet.ptJECDown(), jet.ptJECUp(), jet.ptJERDown(), jet.ptJERUp() };
+        std::array< WeightVariations, numberOfJetVariations > jetWeights;
+        for( unsigned v = 0; v < numberOfJetVariations; ++v ){
+            unsigned previous = 0;
+            while( previous < v && pt[ previous ] != pt[ v ] ) ++previous;
+            if( previous < v ){
+                jetWeights[ v ] = jetWeights[ previous ];
+            } else if( v == nominalJets ){
+                jetWeights[ v ] = weightVariations( jet );
+            } else {
+                jetWeights[ v ] = weightVariations( ( jet.*variedJet[ v ] )() );
+            }
+            ret[ v ] *= jetWeights[ v ];
+        }
+    }
+    return ret;
+}
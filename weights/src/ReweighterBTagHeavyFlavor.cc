@@ -2,10 +2,18 @@
 
 
 //include c++ library classes
+#include <stdexcept>
 
 
 ReweighterBTagHeavyFlavor::ReweighterBTagHeavyFlavor(const std::string& weightDirectory, const std::string& sfFilePath, const std::string& workingPoint, const std::shared_ptr< TH2 >& efficiencyC, const std::shared_ptr< TH2 >& efficiencyB ):
     ReweighterBTag( weightDirectory, sfFilePath, workingPoint, true ),
+    bTagEfficiencyC( efficiencyC.get() ),
+    bTagEfficiencyB( efficiencyB.get() )
+{}
+
+
+ReweighterBTagHeavyFlavor::ReweighterBTagHeavyFlavor( const std::shared_ptr< BTagCalibration >& calibration, const std::string& workingPoint, const LookupTable2D& efficiencyC, const LookupTable2D& efficiencyB ):
+    ReweighterBTag( calibration, workingPoint, true ),
     bTagEfficiencyC( efficiencyC ),
     bTagEfficiencyB( efficiencyB )
 {}
@@ -13,9 +21,9 @@ ReweighterBTagHeavyFlavor::ReweighterBTagHeavyFlavor(const std::string& weightDi
 
 double ReweighterBTagHeavyFlavor::efficiencyMC( const Jet& jet ) const{
     if( jet.hadronFlavor() == 4 ){
-        return histogram::contentAtValues( bTagEfficiencyC.get(), jet.pt(), jet.absEta() );
+        return bTagEfficiencyC.contentAtValues( jet.pt(), jet.absEta() );
     } else if( jet.hadronFlavor() == 5 ){
-        return histogram::contentAtValues( bTagEfficiencyB.get(), jet.pt(), jet.absEta() );
+        return bTagEfficiencyB.contentAtValues( jet.pt(), jet.absEta() );
     } else {
         throw std::invalid_argument( "hadronFlavor of jet is " + std::to_string( jet.hadronFlavor() ) + " while it should be 4 or 5." );
     }
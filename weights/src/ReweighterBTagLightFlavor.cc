@@ -1,15 +1,24 @@
 #include "../interface/ReweighterBTagLightFlavor.h"
 
+//include c++ library classes
+#include <stdexcept>
+
 
 ReweighterBTagLightFlavor::ReweighterBTagLightFlavor(const std::string& weightDirectory, const std::string& sfFilePath, const std::string& workingPoint, const std::shared_ptr< TH2 >& efficiencyUDSG):
     ReweighterBTag( weightDirectory, sfFilePath, workingPoint, false ),
+    bTagEfficiencyUDSG( efficiencyUDSG.get() )
+{}
+
+
+ReweighterBTagLightFlavor::ReweighterBTagLightFlavor( const std::shared_ptr< BTagCalibration >& calibration, const std::string& workingPoint, const LookupTable2D& efficiencyUDSG ):
+    ReweighterBTag( calibration, workingPoint, false ),
     bTagEfficiencyUDSG( efficiencyUDSG )
 {}
 
 
 double ReweighterBTagLightFlavor::efficiencyMC( const Jet& jet ) const{
     if( jet.hadronFlavor() == 0 ){
-        return histogram::contentAtValues( bTagEfficiencyUDSG.get(), jet.pt(), jet.absEta() );
+        return bTagEfficiencyUDSG.contentAtValues( jet.pt(), jet.absEta() );
     } else {
         throw std::invalid_argument( "hadronFlavor of jet is " + std::to_string( jet.hadronFlavor() ) + " while it should be 0." );
     }
@@ -1,6 +1,10 @@
 #include "../interface/ReweighterPileup.h"
 
 //include c++ library classes
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <stdexcept>
 #include <vector>
 
 //include ROOT classes
@@ -10,124 +14,231 @@
 #include "../../Tools/interface/stringTools.h"
 #include "../../Tools/interface/systemTools.h"
 #include "../../Tools/interface/histogramTools.h"
+#include "../../Tools/interface/SampleMetadataIndex.h"
+#include "../interface/ScaleFactorSource.h"
 
 
-//helper function to produce files with pileup weights for each MC sample
-void computeAndWritePileupWeights( const Sample& sample, const std::string& weightDirectory ){
-    if( sample.isData() ) return;
+namespace{
 
-    //open sample and extract pileup distribution
-    std::shared_ptr< TFile > sampleFilePtr = sample.filePtr();
-    std::shared_ptr< TH1 > pileupMC( dynamic_cast< TH1* >( sampleFilePtr->Get( "blackJackAndHookers/nTrueInteractions" ) ) );
-    if( pileupMC == nullptr ){
-        throw std::runtime_error( "File " + sample.fileName() + " does not contain 'blackJackAndHookers/nTrueInteractions'." );
-    }
+    //helper function to produce files with pileup weights for each MC sample
+    //the pileup distribution of the sample is taken from the metadata index when one is given
+    void computeAndWritePileupWeights( const Sample& sample, const std::string& weightDirectory, const SampleMetadataIndex* metadataIndexPtr ){
+        if( sample.isData() ) return;
+
+        std::shared_ptr< TH1 > pileupMC;
+        if( metadataIndexPtr != nullptr ){
+            pileupMC = metadataIndexPtr->metadata( sample ).pileupProfile( "nTrueInteractions_" + sample.uniqueName() );
+        } else {
+
+            //open sample and extract pileup distribution
+            std::shared_ptr< TFile > sampleFilePtr = sample.filePtr();
+            pileupMC = std::shared_ptr< TH1 >( dynamic_cast< TH1* >( sampleFilePtr->Get( "blackJackAndHookers/nTrueInteractions" ) ) );
+            if( pileupMC == nullptr ){
+                throw std::runtime_error( "File " + sample.fileName() + " does not contain 'blackJackAndHookers/nTrueInteractions'." );
+            }
+        }
 
-    //make sure the pileup distribution is normalized to unity
-    pileupMC->Scale( 1. / pileupMC->GetSumOfWeights() );
+        //make sure the pileup distribution is normalized to unity
+        pileupMC->Scale( 1. / pileupMC->GetSumOfWeights() );
 
-    //store all pileup weights in a map
-    std::map< std::string, std::map< std::string, std::shared_ptr< TH1 > > > pileupWeights;
+        //store all pileup weights in a map
+        std::map< std::string, std::map< std::string, std::shared_ptr< TH1 > > > pileupWeights;
 
-    for( const auto& year : { "2016", "2017", "2018" } ){
-        for( const auto& var : { "central", "down", "up" } ){
+        for( const auto& year : { "2016", "2017", "2018" } ){
+            for( const auto& var : { "central", "down", "up" } ){
 
-            //read data pileup distribution from given file
-            std::string dataPuFilePath = ( stringTools::formatDirectoryName( weightDirectory ) + "weightFiles/pileupData/" + "dataPuHist_" + year + "Inclusive_" + var + ".root" );
-            if( !systemTools::fileExists( dataPuFilePath ) ){
-                throw std::runtime_error( "File " + dataPuFilePath + " with data pileup weights, necessary for reweighting, is not present." );
-            }
+                //read data pileup distribution from given file
+                std::string dataPuFilePath = ( stringTools::formatDirectoryName( weightDirectory ) + "weightFiles/pileupData/" + "dataPuHist_" + year + "Inclusive_" + var + ".root" );
+                if( !systemTools::fileExists( dataPuFilePath ) ){
+                    throw std::runtime_error( "File " + dataPuFilePath + " with data pileup weights, necessary for reweighting, is not present." );
+                }
 
-            TFile* dataPileupFilePtr = TFile::Open( dataPuFilePath.c_str() );
-            std::shared_ptr< TH1 > pileupData( dynamic_cast< TH1* >( dataPileupFilePtr->Get( "pileup" ) ) );
-            pileupData->SetDirectory( gROOT );
+                TFile* dataPileupFilePtr = TFile::Open( dataPuFilePath.c_str() );
+                std::shared_ptr< TH1 > pileupData( dynamic_cast< TH1* >( dataPileupFilePtr->Get( "pileup" ) ) );
+                pileupData->SetDirectory( gROOT );
 
-            //make sure the pileup distribution is normalized to unity
-            pileupData->Scale( 1. / pileupData->GetSumOfWeights() );
+                //make sure the pileup distribution is normalized to unity
+                pileupData->Scale( 1. / pileupData->GetSumOfWeights() );
 
-            //divide data and MC histograms to get the weights
-            pileupData->Divide( pileupMC.get() );
+                //divide data and MC histograms to get the weights
+                pileupData->Divide( pileupMC.get() );
 
-            pileupWeights[ year ][ var ] = std::shared_ptr< TH1 >( dynamic_cast< TH1* >( pileupData->Clone() ) );
+                pileupWeights[ year ][ var ] = std::shared_ptr< TH1 >( dynamic_cast< TH1* >( pileupData->Clone() ) );
 
-            //close the file and make sure the histogram persists
-            pileupWeights[ year ][ var ]->SetDirectory( gROOT );
-            dataPileupFilePtr->Close();
+                //close the file and make sure the histogram persists
+                pileupWeights[ year ][ var ]->SetDirectory( gROOT );
+                dataPileupFilePtr->Close();
+            }
+        }
+
+        //write pileup weights to a new ROOT file 
+        std::string outputFilePath = stringTools::formatDirectoryName( weightDirectory ) + "weightFiles/pileupWeights/pileupWeights_" + sample.fileName();
+
+        //make output directory if needed
+        systemTools::makeDirectory( stringTools::directoryNameFromPath( outputFilePath ) );
+        TFile* outputFilePtr = TFile::Open( outputFilePath.c_str(), "RECREATE" );
+        for( const auto& year : { "2016", "2017", "2018" } ){
+            for( const auto& var : { "central", "down", "up" } ){
+                pileupWeights[ year ][ var ]->Write( ( std::string( "pileupWeights_" ) + year + "_" + var ).c_str() );
+            }
         }
+        outputFilePtr->Close();
     }
 
-    //write pileup weights to a new ROOT file 
-    std::string outputFilePath = stringTools::formatDirectoryName( weightDirectory ) + "weightFiles/pileupWeights/pileupWeights_" + sample.fileName();
 
-    //make output directory if needed
-    systemTools::makeDirectory( stringTools::directoryNameFromPath( outputFilePath ) );
-    TFile* outputFilePtr = TFile::Open( outputFilePath.c_str(), "RECREATE" );
-    for( const auto& year : { "2016", "2017", "2018" } ){
-        for( const auto& var : { "central", "down", "up" } ){
-            pileupWeights[ year ][ var ]->Write( ( std::string( "pileupWeights_" ) + year + "_" + var ).c_str() );
+
+    //convert the central, down and up pileup weight histograms of a sample to a dense table indexed by the integer number of true interactions
+    //every bin edge has to be an integer, so that all values between two consecutive integers fall in the same bin
+    ReweighterPileup::WeightTable makePileupWeightTable( TH1* central, TH1* down, TH1* up ){
+        for( int b = 1; b <= central->GetNbinsX() + 1; ++b ){
+            double edge = central->GetBinLowEdge( b );
+            if( edge != std::floor( edge ) ){
+                throw std::domain_error( "Pileup weight histogram '" + std::string( central->GetName() ) + "' has a bin edge at " + std::to_string( edge ) + ", while integer bin edges are needed to tabulate the weights." );
+            }
+        }
+        if( down->GetNbinsX() != central->GetNbinsX() || up->GetNbinsX() != central->GetNbinsX() ){
+            throw std::domain_error( "Central and varied pileup weight histograms have a different binning." );
+        }
+
+        int minimum = static_cast< int >( histogram::minXValue( central ) );
+        int maximum = static_cast< int >( histogram::maxXValue( central ) );
+        std::shared_ptr< std::vector< double > > weights = std::make_shared< std::vector< double > >();
+        weights->reserve( 3 * ( maximum - minimum ) );
+        for( int numberOfTrueInteractions = minimum; numberOfTrueInteractions < maximum; ++numberOfTrueInteractions ){
+            int bin = histogram::findBinAtValue( central, numberOfTrueInteractions + 0.5 );
+            weights->push_back( central->GetBinContent( bin ) );
+            weights->push_back( down->GetBinContent( bin ) );
+            weights->push_back( up->GetBinContent( bin ) );
         }
+
+        ReweighterPileup::WeightTable table;
+        table.minimumNumberOfTrueInteractions = minimum;
+        table.numberOfEntries = weights->size() / 3;
+        table.weights = weights->data();
+        table.owner = weights;
+        return table;
+    }
+}
+
+
+std::string ReweighterPileup::weightFilePath( const Sample& sample ){
+    return "weightFiles/pileupWeights/pileupWeights_" + sample.fileName();
+}
+
+
+std::string ReweighterPileup::weightHistogramName( const Sample& sample ){
+    std::string yearSuffix;
+    if( sample.is2016() ){
+        yearSuffix = "2016";
+    } else if( sample.is2017() ){
+        yearSuffix = "2017";
+    } else{
+        yearSuffix = "2018";
     }
-    outputFilePtr->Close();
+    return "pileupWeights_" + yearSuffix;
 }
 
 
+ReweighterPileup::WeightTable ReweighterPileup::readWeightTable( const Sample& sample, const std::string& weightDirectory, const SampleMetadataIndex* metadataIndexPtr ){
+    std::string pileupWeightPath = stringTools::formatDirectoryName( weightDirectory ) + weightFilePath( sample );
 
-ReweighterPileup::ReweighterPileup( const std::vector< Sample >& sampleList, const std::string& weightDirectory ){
+    //for each sample check if the necessary pileup weights are available, and produce them if not 
+    if( !systemTools::fileExists( pileupWeightPath ) ){
+        computeAndWritePileupWeights( sample, weightDirectory, metadataIndexPtr );
+    }
+
+    //extract the pileupweights from the file
+    std::string histogramName = weightHistogramName( sample );
+    TFile* puWeightFilePtr = TFile::Open( pileupWeightPath.c_str() );
+    std::shared_ptr< TH1 > puWeightsCentral( dynamic_cast< TH1* >( puWeightFilePtr->Get( ( histogramName + "_central" ).c_str() ) ) );
+    puWeightsCentral->SetDirectory( gROOT );
+    std::shared_ptr< TH1 > puWeightsDown( dynamic_cast< TH1* >( puWeightFilePtr->Get( ( histogramName + "_down" ).c_str() ) ) );
+    puWeightsDown->SetDirectory( gROOT );
+    std::shared_ptr< TH1 > puWeightsUp( dynamic_cast< TH1* >( puWeightFilePtr->Get( ( histogramName + "_up" ).c_str() ) ) );
+    puWeightsUp->SetDirectory( gROOT );
+    puWeightFilePtr->Close();
+
+    return makePileupWeightTable( puWeightsCentral.get(), puWeightsDown.get(), puWeightsUp.get() );
+}
+
+
+namespace{
+
+    //identifiers are never reused, so a reweighter created at the address of a deleted one does not pick up its cached table
+    std::atomic< std::uint64_t > nextReweighterId( 1 );
+
+    //table of the sample that was last reweighted in this thread, only changing when the sample does
+    //the sample is identified by Sample::identifier, so no names are compared in the event loop
+    struct CachedTable{
+        std::uint64_t reweighterId = 0;
+        std::uint64_t sampleIdentifier = 0;
+        const ReweighterPileup::WeightTable* tablePtr = nullptr;
+    };
+    thread_local CachedTable cachedTable;
+}
+
+
+ReweighterPileup::ReweighterPileup( const std::vector< Sample >& sampleList, const std::string& weightDirectory, const SampleMetadataIndex* metadataIndexPtr ) :
+    _reweighterId( nextReweighterId++ )
+{
     
-    //read each of the pileup weights into the maps
+    //read each of the pileup weights into the tables, skipping data samples
     for( const auto& sample : sampleList ){
-
-        //skip data samples!
         if( sample.isData() ) continue;
+        puWeightTables[ sample.uniqueName() ] = readWeightTable( sample, weightDirectory, metadataIndexPtr );
+    }
+}
 
-        std::string pileupWeightPath = ( stringTools::formatDirectoryName( weightDirectory ) + "weightFiles/pileupWeights/pileupWeights_" + sample.fileName() );
-
-        //for each sample check if the necessary pileup weights are available, and produce them if not 
-        if( !systemTools::fileExists( pileupWeightPath ) ){
-            computeAndWritePileupWeights( sample, weightDirectory );
-        }
 
-        //extract the pileupweights from the file
-        std::string yearSuffix;
-        if( sample.is2016() ){
-            yearSuffix = "2016";
-        } else if( sample.is2017() ){
-            yearSuffix = "2017";
-        } else{
-            yearSuffix = "2018";
-        }
-        TFile* puWeightFilePtr = TFile::Open( pileupWeightPath.c_str() );
-        puWeightsCentral[ sample.uniqueName() ] = std::shared_ptr< TH1 >( dynamic_cast< TH1* >( puWeightFilePtr->Get( ( "pileupWeights_" + yearSuffix + "_central" ).c_str() ) ) );
-        puWeightsCentral[ sample.uniqueName() ]->SetDirectory( gROOT );
-        puWeightsDown[ sample.uniqueName() ] = std::shared_ptr< TH1 >( dynamic_cast< TH1* >( puWeightFilePtr->Get( ( "pileupWeights_" + yearSuffix + "_down" ).c_str() ) ) );
-        puWeightsDown[ sample.uniqueName() ]->SetDirectory( gROOT );
-        puWeightsUp[ sample.uniqueName() ] = std::shared_ptr< TH1 >( dynamic_cast< TH1* >( puWeightFilePtr->Get( ( "pileupWeights_" + yearSuffix + "_up" ).c_str() ) ) );
-        puWeightsUp[ sample.uniqueName() ]->SetDirectory( gROOT );
-        puWeightFilePtr->Close();
+ReweighterPileup::ReweighterPileup( const std::vector< Sample >& sampleList, ScaleFactorSource& source ) :
+    _reweighterId( nextReweighterId++ )
+{
+    for( const auto& sample : sampleList ){
+        if( sample.isData() ) continue;
+        puWeightTables[ sample.uniqueName() ] = source.pileupWeightTable( sample );
     }
 }
 
 
-double ReweighterPileup::weight( const Event& event, const std::map< std::string, std::shared_ptr< TH1 > >& weightMap ) const{
-    auto it = weightMap.find( event.sample().uniqueName() );
-    if( it == weightMap.cend() ){
-        throw std::invalid_argument( "No pileup weights for sample " + event.sample().uniqueName() + " found, this sample was probably not present in the vector used to construct the Reweighter." );
+const double* ReweighterPileup::weightsAtNumberOfTrueInteractions( const Event& event ) const{
+
+    //the table is only looked up when the sample changes
+    const Sample& sample = event.sample();
+    if( cachedTable.reweighterId != _reweighterId || sample.identifier() != cachedTable.sampleIdentifier ){
+        auto it = puWeightTables.find( sample.uniqueName() );
+        if( it == puWeightTables.cend() ){
+            throw std::invalid_argument( "No pileup weights for sample " + sample.uniqueName() + " found, this sample was probably not present in the vector used to construct the Reweighter." );
+        }
+        cachedTable.reweighterId = _reweighterId;
+        cachedTable.sampleIdentifier = sample.identifier();
+        cachedTable.tablePtr = &( it->second );
     }
-    TH1* histPtr = it->second.get();
-    return histogram::contentAtValue( histPtr, event.generatorInfo().numberOfTrueInteractions() );
+
+    //values outside the histogram range get the weight of the first or last bin
+    const WeightTable& table = *cachedTable.tablePtr;
+    long index = static_cast< long >( std::floor( event.generatorInfo().numberOfTrueInteractions() ) ) - table.minimumNumberOfTrueInteractions;
+    long numberOfEntries = static_cast< long >( table.numberOfEntries );
+    index = std::max( 0L, std::min( index, numberOfEntries - 1 ) );
+    return table.weights + 3 * index;
 }
 
 
 double ReweighterPileup::weight( const Event& event ) const{
-    return weight( event, puWeightsCentral );
+    return weightsAtNumberOfTrueInteractions( event )[ 0 ];
 }
 
 
 double ReweighterPileup::weightDown( const Event& event ) const{
-    return weight( event, puWeightsDown );
+    return weightsAtNumberOfTrueInteractions( event )[ 1 ];
 }
 
 
 double ReweighterPileup::weightUp( const Event& event ) const{
-    return weight( event, puWeightsUp );
+    return weightsAtNumberOfTrueInteractions( event )[ 2 ];
+}
+
+
+WeightVariations ReweighterPileup::weightVariations( const Event& event ) const{
+    const double* weights = weightsAtNumberOfTrueInteractions( event );
+    return { weights[ 0 ], weights[ 1 ], weights[ 2 ] };
 }
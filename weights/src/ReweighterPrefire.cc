@@ -13,3 +13,9 @@ double ReweighterPrefire::weightDown( const Event& event ) const{
 double ReweighterPrefire::weightUp( const Event& event ) const{
     return event.generatorInfo().prefireWeightUp();
 }
+
+
+WeightVariations ReweighterPrefire::weightVariations( const Event& event ) const{
+    const GeneratorInfo& generatorInfo = event.generatorInfo();
+    return { generatorInfo.prefireWeight(), generatorInfo.prefireWeightDown(), generatorInfo.prefireWeightUp() };
+}
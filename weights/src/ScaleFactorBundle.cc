@@ -0,0 +1,235 @@
+#include "../interface/ScaleFactorBundle.h"
+
+//include c++ library classes
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+//include other parts of framework
+#include "../../Tools/interface/systemTools.h"
+
+//include POSIX classes for memory mapping
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+
+//the file starts with a magic string ending in the format version, a marker to check the byte order and the number of entries
+//this is followed by a directory with the type, offset, size, source file stamp and name of every entry, and by the payloads
+//every offset is a multiple of 8 bytes, so the payloads can be used in place as arrays of doubles
+namespace{
+    const char magic[ 8 ] = { 'S', 'F', 'B', 'U', 'N', 'D', 'L', '3' };
+    const std::uint64_t byteOrderMarker = 0x0102030405060708;
+
+    std::size_t paddedSize( const std::size_t size ){
+        return ( size + 7 ) / 8 * 8;
+    }
+
+    std::uint64_t readWord( const char* data, const std::size_t size, std::size_t& position ){
+        if( position + sizeof( std::uint64_t ) > size ){
+            throw std::runtime_error( "Scale factor bundle ends unexpectedly." );
+        }
+        std::uint64_t word;
+        std::memcpy( &word, data + position, sizeof( std::uint64_t ) );
+        position += sizeof( std::uint64_t );
+        return word;
+    }
+}
+
+
+scaleFactorBundle::SourceStamp scaleFactorBundle::sourceStamp( const std::string& filePath ){
+    SourceStamp stamp;
+    stamp.fileSize = systemTools::fileSize( filePath );
+    stamp.modificationTime = systemTools::fileModificationTime( filePath );
+    return stamp;
+}
+
+
+std::shared_ptr< const ScaleFactorBundle > ScaleFactorBundle::open( const std::string& path ){
+    return std::shared_ptr< const ScaleFactorBundle >( new ScaleFactorBundle( path ) );
+}
+
+
+ScaleFactorBundle::ScaleFactorBundle( const std::string& path ) :
+    _path( path )
+{
+    int fileDescriptor = ::open( path.c_str(), O_RDONLY );
+    if( fileDescriptor < 0 ){
+        throw std::runtime_error( "Scale factor bundle " + path + " can not be opened." );
+    }
+    struct stat fileStatus;
+    if( fstat( fileDescriptor, &fileStatus ) != 0 || fileStatus.st_size == 0 ){
+        ::close( fileDescriptor );
+        throw std::runtime_error( "Scale factor bundle " + path + " is empty or can not be read." );
+    }
+    _mappingSize = static_cast< size_type >( fileStatus.st_size );
+    void* mapping = mmap( nullptr, _mappingSize, PROT_READ, MAP_SHARED, fileDescriptor, 0 );
+
+    //the mapping stays valid after closing the file
+    ::close( fileDescriptor );
+    if( mapping == MAP_FAILED ){
+        throw std::runtime_error( "Scale factor bundle " + path + " can not be memory-mapped." );
+    }
+    _mapping = mapping;
+
+    //read the header and directory, and unmap again if they are malformed
+    try{
+        const char* data = static_cast< const char* >( _mapping );
+        if( _mappingSize < sizeof( magic ) || std::memcmp( data, magic, sizeof( magic ) - 1 ) != 0 ){
+            throw std::runtime_error( "File " + path + " is not a scale factor bundle." );
+        }
+        if( data[ sizeof( magic ) - 1 ] != magic[ sizeof( magic ) - 1 ] ){
+            throw std::runtime_error( "Scale factor bundle " + path + " was written with another format version, remake it with bundleScaleFactors." );
+        }
+        size_type position = sizeof( magic );
+        if( readWord( data, _mappingSize, position ) != byteOrderMarker ){
+            throw std::runtime_error( "Scale factor bundle " + path + " was written with a different byte order." );
+        }
+        std::uint64_t numberOfEntries = readWord( data, _mappingSize, position );
+        for( std::uint64_t e = 0; e < numberOfEntries; ++e ){
+            Entry newEntry;
+            newEntry.type = readWord( data, _mappingSize, position );
+            std::uint64_t offset = readWord( data, _mappingSize, position );
+            newEntry.size = readWord( data, _mappingSize, position );
+            newEntry.source.fileSize = static_cast< long long >( readWord( data, _mappingSize, position ) );
+            newEntry.source.modificationTime = static_cast< long long >( readWord( data, _mappingSize, position ) );
+            std::uint64_t nameSize = readWord( data, _mappingSize, position );
+            if( position + nameSize > _mappingSize || offset % 8 != 0 || offset > _mappingSize || newEntry.size > _mappingSize - offset ){
+                throw std::runtime_error( "Scale factor bundle " + path + " has a corrupted directory." );
+            }
+            std::string name( data + position, nameSize );
+            position += paddedSize( nameSize );
+            newEntry.data = data + offset;
+            _entries[ name ] = newEntry;
+        }
+    } catch( ... ){
+        munmap( _mapping, _mappingSize );
+        throw;
+    }
+}
+
+
+ScaleFactorBundle::~ScaleFactorBundle(){
+    munmap( _mapping, _mappingSize );
+}
+
+
+const ScaleFactorBundle::Entry& ScaleFactorBundle::entry( const std::string& name, const scaleFactorBundle::EntryType type ) const{
+    auto it = _entries.find( name );
+    if( it == _entries.cend() ){
+        throw std::invalid_argument( "Entry '" + name + "' is not present in scale factor bundle " + _path + "." );
+    }
+    if( it->second.type != type ){
+        throw std::invalid_argument( "Entry '" + name + "' in scale factor bundle " + _path + " is of type " + std::to_string( it->second.type ) + " instead of " + std::to_string( type ) + "." );
+    }
+    return it->second;
+}
+
+
+LookupTable2D ScaleFactorBundle::lookupTable( const std::string& name ) const{
+    const Entry& tableEntry = entry( name, scaleFactorBundle::lookupTable );
+    return LookupTable2D( reinterpret_cast< const double* >( tableEntry.data ), tableEntry.size / sizeof( double ), shared_from_this() );
+}
+
+
+const double* ScaleFactorBundle::pileupTable( const std::string& name, int& minimumNumberOfTrueInteractions, size_type& numberOfEntries ) const{
+    const Entry& tableEntry = entry( name, scaleFactorBundle::pileupTable );
+    const double* table = reinterpret_cast< const double* >( tableEntry.data );
+    size_type tableSize = tableEntry.size / sizeof( double );
+    if( tableSize < 4 || ( tableSize - 1 ) % 3 != 0 ){
+        throw std::runtime_error( "Pileup table '" + name + "' in scale factor bundle " + _path + " has an invalid size." );
+    }
+    minimumNumberOfTrueInteractions = static_cast< int >( table[ 0 ] );
+    numberOfEntries = ( tableSize - 1 ) / 3;
+    return table + 1;
+}
+
+
+std::string ScaleFactorBundle::text( const std::string& name ) const{
+    const Entry& textEntry = entry( name, scaleFactorBundle::text );
+    return std::string( textEntry.data, textEntry.size );
+}
+
+
+bool ScaleFactorBundle::isUpToDate( const std::string& name, const std::string& sourcePath ) const{
+    auto it = _entries.find( name );
+    if( it == _entries.cend() || !systemTools::fileExists( sourcePath ) ) return false;
+    scaleFactorBundle::SourceStamp stamp = scaleFactorBundle::sourceStamp( sourcePath );
+    return ( stamp.fileSize == it->second.source.fileSize && stamp.modificationTime == it->second.source.modificationTime );
+}
+
+
+void ScaleFactorBundleWriter::addEntry( const std::string& name, const scaleFactorBundle::EntryType type, const std::string& payload, const scaleFactorBundle::SourceStamp& source ){
+    if( !_entries.insert( { name, { type, payload, source } } ).second ){
+        throw std::invalid_argument( "Entry '" + name + "' is added twice to the scale factor bundle." );
+    }
+}
+
+
+void ScaleFactorBundleWriter::addLookupTable( const std::string& name, const LookupTable2D& table, const scaleFactorBundle::SourceStamp& source ){
+    addEntry( name, scaleFactorBundle::lookupTable, std::string( reinterpret_cast< const char* >( table.block() ), table.blockSize() * sizeof( double ) ), source );
+}
+
+
+void ScaleFactorBundleWriter::addPileupTable( const std::string& name, const int minimumNumberOfTrueInteractions, const std::vector< double >& weights, const scaleFactorBundle::SourceStamp& source ){
+    if( weights.empty() || weights.size() % 3 != 0 ){
+        throw std::invalid_argument( "Pileup table '" + name + "' needs central, down and up weights for every number of true interactions." );
+    }
+    std::vector< double > table( 1, minimumNumberOfTrueInteractions );
+    table.insert( table.end(), weights.cbegin(), weights.cend() );
+    addEntry( name, scaleFactorBundle::pileupTable, std::string( reinterpret_cast< const char* >( table.data() ), table.size() * sizeof( double ) ), source );
+}
+
+
+void ScaleFactorBundleWriter::addText( const std::string& name, const std::string& text, const scaleFactorBundle::SourceStamp& source ){
+    addEntry( name, scaleFactorBundle::text, text, source );
+}
+
+
+void ScaleFactorBundleWriter::write( const std::string& path ) const{
+
+    //determine the offsets of all payloads, which come after the header and directory
+    std::size_t directorySize = 0;
+    for( const auto& namedEntry : _entries ){
+        directorySize += 6 * sizeof( std::uint64_t ) + paddedSize( namedEntry.first.size() );
+    }
+    std::size_t offset = sizeof( magic ) + 2 * sizeof( std::uint64_t ) + directorySize;
+
+    //write to a temporary file first, so a partially written bundle is never picked up
+    std::string temporaryPath = path + ".tmp";
+    std::ofstream output( temporaryPath, std::ios::binary | std::ios::trunc );
+    if( !output ){
+        throw std::runtime_error( "Scale factor bundle " + temporaryPath + " can not be opened for writing." );
+    }
+    const char padding[ 8 ] = { 0 };
+    auto writeWord = [&output]( const std::uint64_t word ){ output.write( reinterpret_cast< const char* >( &word ), sizeof( word ) ); };
+
+    output.write( magic, sizeof( magic ) );
+    writeWord( byteOrderMarker );
+    writeWord( _entries.size() );
+    for( const auto& namedEntry : _entries ){
+        writeWord( namedEntry.second.type );
+        writeWord( offset );
+        writeWord( namedEntry.second.payload.size() );
+        writeWord( static_cast< std::uint64_t >( namedEntry.second.source.fileSize ) );
+        writeWord( static_cast< std::uint64_t >( namedEntry.second.source.modificationTime ) );
+        writeWord( namedEntry.first.size() );
+        output.write( namedEntry.first.data(), namedEntry.first.size() );
+        output.write( padding, paddedSize( namedEntry.first.size() ) - namedEntry.first.size() );
+        offset += paddedSize( namedEntry.second.payload.size() );
+    }
+    for( const auto& namedEntry : _entries ){
+        const std::string& payload = namedEntry.second.payload;
+        output.write( payload.data(), payload.size() );
+        output.write( padding, paddedSize( payload.size() ) - payload.size() );
+    }
+    output.close();
+    if( !output ){
+        throw std::runtime_error( "Writing scale factor bundle " + temporaryPath + " failed." );
+    }
+    if( std::rename( temporaryPath.c_str(), path.c_str() ) != 0 ){
+        throw std::runtime_error( "Scale factor bundle " + temporaryPath + " can not be moved to " + path + "." );
+    }
+}
@@ -0,0 +1,127 @@
+#include "../interface/ScaleFactorSource.h"
+
+//include c++ library classes
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+//include ROOT classes
+#include "TFile.h"
+#include "TROOT.h"
+
+//include other parts of framework
+#include "../../Tools/interface/stringTools.h"
+#include "../../Tools/interface/systemTools.h"
+
+
+ScaleFactorSource::ScaleFactorSource( const std::string& weightDirectory ) :
+    _weightDirectory( stringTools::formatDirectoryName( weightDirectory ) )
+{}
+
+
+ScaleFactorSource::ScaleFactorSource( const std::string& weightDirectory, const std::shared_ptr< const ScaleFactorBundle >& bundle ) :
+    _weightDirectory( stringTools::formatDirectoryName( weightDirectory ) ),
+    _bundle( bundle )
+{}
+
+
+std::string ScaleFactorSource::bundlePath( const std::string& weightDirectory, const std::string& year ){
+    return stringTools::formatDirectoryName( weightDirectory ) + "weightFiles/bundles/scaleFactors_" + year + ".bin";
+}
+
+
+ScaleFactorSource ScaleFactorSource::forYear( const std::string& weightDirectory, const std::string& year ){
+    std::string path = bundlePath( weightDirectory, year );
+    if( systemTools::fileExists( path ) ){
+        return ScaleFactorSource( weightDirectory, ScaleFactorBundle::open( path ) );
+    }
+    return ScaleFactorSource( weightDirectory );
+}
+
+
+bool ScaleFactorSource::useBundleEntry( const std::string& entryName, const std::string& filePath ) const{
+    if( !_bundle || !_bundle->contains( entryName ) ) return false;
+
+    //entries of files that changed since the bundle was made are read from the files again
+    if( !_bundle->isUpToDate( entryName, _weightDirectory + filePath ) ){
+        std::cerr << "Warning: scale factor bundle " << _bundle->path() << " is out of date for " << entryName << ", reading it from " << _weightDirectory + filePath << " instead. Remake the bundle with bundleScaleFactors." << std::endl;
+        return false;
+    }
+    return true;
+}
+
+
+LookupTable2D ScaleFactorSource::lookupTable( const std::string& filePath, const std::string& histogramName ){
+    std::string entryName = filePath + ":" + histogramName;
+    if( useBundleEntry( entryName, filePath ) ){
+        return _bundle->lookupTable( entryName );
+    }
+
+    std::string fullPath = _weightDirectory + filePath;
+    TFile* filePtr = TFile::Open( fullPath.c_str() );
+    if( filePtr == nullptr || filePtr->IsZombie() ){
+        throw std::runtime_error( "File " + fullPath + " with scale factors can not be opened." );
+    }
+    TH2* histPtr = dynamic_cast< TH2* >( filePtr->Get( histogramName.c_str() ) );
+    if( histPtr == nullptr ){
+        filePtr->Close();
+        throw std::runtime_error( "File " + fullPath + " does not contain a two-dimensional histogram '" + histogramName + "'." );
+    }
+    LookupTable2D table( histPtr );
+    filePtr->Close();
+
+    if( !_recordedInputs.contains( entryName ) ){
+        _recordedInputs.addLookupTable( entryName, table, scaleFactorBundle::sourceStamp( fullPath ) );
+    }
+    return table;
+}
+
+
+std::shared_ptr< BTagCalibration > ScaleFactorSource::bTagCalibration( const std::string& filePath ){
+    std::string csv;
+    if( useBundleEntry( filePath, filePath ) ){
+        csv = _bundle->text( filePath );
+    } else {
+        std::string fullPath = _weightDirectory + filePath;
+        std::ifstream csvFile( fullPath );
+        if( !csvFile ){
+            throw std::runtime_error( "File " + fullPath + " with b-tag scale factors can not be opened." );
+        }
+        std::stringstream buffer;
+        buffer << csvFile.rdbuf();
+        csv = buffer.str();
+        if( !_recordedInputs.contains( filePath ) ){
+            _recordedInputs.addText( filePath, csv, scaleFactorBundle::sourceStamp( fullPath ) );
+        }
+    }
+    std::shared_ptr< BTagCalibration > calibration = std::make_shared< BTagCalibration >( "" );
+    calibration->readCSV( csv );
+    return calibration;
+}
+
+
+ReweighterPileup::WeightTable ScaleFactorSource::pileupWeightTable( const Sample& sample ){
+    std::string filePath = ReweighterPileup::weightFilePath( sample );
+    std::string entryName = filePath + ":" + ReweighterPileup::weightHistogramName( sample );
+    if( useBundleEntry( entryName, filePath ) ){
+        ReweighterPileup::WeightTable table;
+        table.weights = _bundle->pileupTable( entryName, table.minimumNumberOfTrueInteractions, table.numberOfEntries );
+        table.owner = _bundle;
+        return table;
+    }
+
+    ReweighterPileup::WeightTable table = ReweighterPileup::readWeightTable( sample, _weightDirectory, _metadataIndexPtr.get() );
+    if( !_recordedInputs.contains( entryName ) ){
+        _recordedInputs.addPileupTable( entryName, table.minimumNumberOfTrueInteractions, std::vector< double >( table.weights, table.weights + 3 * table.numberOfEntries ),
+            scaleFactorBundle::sourceStamp( _weightDirectory + filePath ) );
+    }
+    return table;
+}
+
+
+void ScaleFactorSource::writeBundle( const std::string& path ) const{
+    systemTools::makeDirectory( stringTools::directoryNameFromPath( path ) );
+    _recordedInputs.write( path );
+}
@@ -0,0 +1,92 @@
+#include "../interface/transferFactors.h"
+
+//include c++ library classes
+#include <algorithm>
+#include <stdexcept>
+
+
+void transferFactors::fakeRateWeights( const Event& event, const LookupTable2D& muonMap, const LookupTable2D& electronMap, std::vector< double >& weights, const double maxPt ){
+    const LookupTable2D::size_type electronOffset = 1 + muonMap.numberOfVariations();
+    weights.assign( electronOffset + electronMap.numberOfVariations(), -1. );
+    for( const auto& leptonPtr : event.leptonCollection() ){
+        if( !leptonPtr->isFO() ) continue;
+        if( leptonPtr->isTight() ) continue;
+
+        const LookupTable2D* mapPtr;
+        LookupTable2D::size_type offset;
+        if( leptonPtr->isMuon() ){
+            mapPtr = &muonMap;
+            offset = 1;
+        } else if( leptonPtr->isElectron() ){
+            mapPtr = &electronMap;
+            offset = electronOffset;
+        } else {
+            throw std::invalid_argument( "Fake-rate weights are only available for muons and electrons." );
+        }
+        const double* rates = mapPtr->valuesAtValues( std::min( leptonPtr->pt(), maxPt ), leptonPtr->absEta() );
+
+        //the variations of the other flavor's map use the nominal rate of this lepton
+        const LookupTable2D::size_type end = offset + mapPtr->numberOfVariations();
+        const double nominalFactor = - rates[ 0 ] / ( 1. - rates[ 0 ] );
+        for( LookupTable2D::size_type w = 0; w < weights.size(); ++w ){
+            if( w < offset || w >= end ){
+                weights[ w ] *= nominalFactor;
+            } else {
+                const double rate = rates[ w - offset + 1 ];
+                weights[ w ] *= - rate / ( 1. - rate );
+            }
+        }
+    }
+}
+
+
+double transferFactors::fakeRateWeight( const Event& event, const LookupTable2D& muonMap, const LookupTable2D& electronMap, const double maxPt ){
+    double weight = -1.;
+    for( const auto& leptonPtr : event.leptonCollection() ){
+        if( !leptonPtr->isFO() ) continue;
+        if( leptonPtr->isTight() ) continue;
+        double fr;
+        double pt = std::min( leptonPtr->pt(), maxPt );
+        if( leptonPtr->isMuon() ){
+            fr = muonMap.contentAtValues( pt, leptonPtr->absEta() );
+        } else if( leptonPtr->isElectron() ){
+            fr = electronMap.contentAtValues( pt, leptonPtr->absEta() );
+        } else {
+            throw std::invalid_argument( "Fake-rate weights are only available for muons and electrons." );
+        }
+        weight *= - fr / ( 1. - fr );
+    }
+    return weight;
+}
+
+
+void transferFactors::chargeFlipWeights( const Event& event, const LookupTable2D& chargeFlipMap, std::vector< double >& weights ){
+
+    // P( A + B ) = P( A ) + P( B ) - P( A & B )
+    const LookupTable2D::size_type numberOfWeights = 1 + chargeFlipMap.numberOfVariations();
+    weights.assign( numberOfWeights, 0. );
+    std::vector< double > multipliedProbabilities( numberOfWeights, 1. );
+    for( const auto& electronPtr : event.electronCollection() ){
+        const double* rates = chargeFlipMap.valuesAtValues( electronPtr->pt(), electronPtr->absEta() );
+        for( LookupTable2D::size_type w = 0; w < numberOfWeights; ++w ){
+            const double odds = rates[ w ] / ( 1. - rates[ w ] );
+            weights[ w ] += odds;
+            multipliedProbabilities[ w ] *= odds;
+        }
+    }
+    for( LookupTable2D::size_type w = 0; w < numberOfWeights; ++w ){
+        weights[ w ] -= multipliedProbabilities[ w ];
+    }
+}
+
+
+double transferFactors::chargeFlipWeight( const Event& event, const LookupTable2D& chargeFlipMap ){
+    double summedProbabilities = 0.;
+    double multipliedProbabilities = 1.;
+    for( const auto& electronPtr : event.electronCollection() ){
+        const double flipRate = chargeFlipMap.contentAtValues( electronPtr->pt(), electronPtr->absEta() );
+        summedProbabilities += flipRate / ( 1. - flipRate );
+        multipliedProbabilities *= flipRate / ( 1. - flipRate );
+    }
+    return ( summedProbabilities - multipliedProbabilities );
+}